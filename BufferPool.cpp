@@ -0,0 +1,281 @@
+// ####################################################################################################
+// Include libraries:
+
+#include "BufferPool.h"
+#include <algorithm>                // std::max
+#include <bit>                      // std::bit_width for size classes
+#include <new>                      // Placement new of block header
+
+// ####################################################################################################
+// Private variables:
+
+/// @brief Alignment of blocks. Blocks are at least BUFFER_POOL_MIN_BLOCK bytes and slabs are aligned to it.
+static const size_t blockAlignment = BUFFER_POOL_MIN_BLOCK;
+
+// ######################################################################################################
+// PooledBuffer Class:
+
+PooledBuffer::PooledBuffer(void) noexcept
+{
+    _header = nullptr;
+}
+
+PooledBuffer::PooledBuffer(Header* header) noexcept
+{
+    _header = header;
+}
+
+PooledBuffer::PooledBuffer(const PooledBuffer &other) noexcept
+{
+    _header = other._header;
+
+    if(_header != nullptr)
+    {
+        _header->refCount++;
+    }
+}
+
+PooledBuffer::PooledBuffer(PooledBuffer &&other) noexcept
+{
+    _header = other._header;
+    other._header = nullptr;
+}
+
+PooledBuffer& PooledBuffer::operator=(const PooledBuffer &other) noexcept
+{
+    // Header is read before reset(), because other can be this handle.
+    Header* header = other._header;
+    if(header != nullptr)
+    {
+        header->refCount++;
+    }
+
+    reset();
+    _header = header;
+
+    return *this;
+}
+
+PooledBuffer& PooledBuffer::operator=(PooledBuffer &&other) noexcept
+{
+    if(this != &other)
+    {
+        reset();
+        _header = other._header;
+        other._header = nullptr;
+    }
+
+    return *this;
+}
+
+PooledBuffer::~PooledBuffer()
+{
+    reset();
+}
+
+bool PooledBuffer::resize(size_t size)
+{
+    if(size > capacity())
+    {
+        return false;
+    }
+
+    if(_header != nullptr)
+    {
+        _header->size = size;
+    }
+
+    return true;
+}
+
+uint32_t PooledBuffer::useCount(void) const
+{
+    return (_header != nullptr) ? _header->refCount : 0;
+}
+
+void PooledBuffer::reset(void)
+{
+    if((_header != nullptr) && (--_header->refCount == 0))
+    {
+        _header->pool->_release(_header);
+    }
+
+    _header = nullptr;
+}
+
+// ######################################################################################################
+// BufferPool Class:
+
+BufferPool::BufferPool(std::pmr::memory_resource* upstream)
+{
+    _upstream = upstream;
+    _slabBytes = 0;
+    _upstreamCount = 0;
+
+    for(auto &list : _freeLists)
+    {
+        list = nullptr;
+    }
+}
+
+BufferPool::~BufferPool()
+{
+    for(const Slab &slab : _slabs)
+    {
+        _upstream->deallocate(slab.data, slab.size, blockAlignment);
+    }
+}
+
+PooledBuffer BufferPool::acquire(size_t size)
+{
+    if(size == 0)
+    {
+        return PooledBuffer();
+    }
+
+    size_t bytes = sizeof(PooledBuffer::Header) + size;
+    size_t sizeClass = _sizeClass(bytes);
+    void* block;
+    uint32_t blockSize = 0;
+
+    if(sizeClass < BUFFER_POOL_CLASSES)
+    {
+        block = _take(sizeClass);
+        blockSize = (uint32_t)(BUFFER_POOL_MIN_BLOCK << sizeClass);
+    }
+    else
+    {
+        block = _upstream->allocate(bytes, alignof(PooledBuffer::Header));
+        _upstreamCount++;
+    }
+
+    PooledBuffer::Header* header = new (block) PooledBuffer::Header;
+    header->pool = this;
+    header->size = size;
+    header->capacity = (blockSize > 0) ? blockSize - sizeof(PooledBuffer::Header) : size;
+    header->refCount = 1;
+    header->blockSize = blockSize;
+
+    return PooledBuffer(header);
+}
+
+void BufferPool::reserve(size_t size, size_t count)
+{
+    size_t sizeClass = _sizeClass(sizeof(PooledBuffer::Header) + size);
+
+    if(sizeClass >= BUFFER_POOL_CLASSES)
+    {
+        return;
+    }
+
+    // Take count blocks and give them back. Free blocks are taken first and slabs are split only for the rest.
+    std::vector<void*> blocks;
+    blocks.reserve(count);
+    for(size_t i = 0; i < count; i++)
+    {
+        blocks.push_back(_take(sizeClass));
+    }
+
+    for(void* block : blocks)
+    {
+        _give(sizeClass, block);
+    }
+}
+
+uint64_t BufferPool::getUpstreamCount(void) const
+{
+    return _upstreamCount;
+}
+
+size_t BufferPool::getSlabBytes(void) const
+{
+    return _slabBytes;
+}
+
+void* BufferPool::do_allocate(size_t bytes, size_t alignment)
+{
+    size_t sizeClass = _sizeClass(bytes);
+
+    if((sizeClass >= BUFFER_POOL_CLASSES) || (alignment > blockAlignment))
+    {
+        _upstreamCount++;
+        return _upstream->allocate(bytes, alignment);
+    }
+
+    return _take(sizeClass);
+}
+
+void BufferPool::do_deallocate(void* p, size_t bytes, size_t alignment)
+{
+    size_t sizeClass = _sizeClass(bytes);
+
+    if((sizeClass >= BUFFER_POOL_CLASSES) || (alignment > blockAlignment))
+    {
+        _upstream->deallocate(p, bytes, alignment);
+        return;
+    }
+
+    _give(sizeClass, p);
+}
+
+bool BufferPool::do_is_equal(const std::pmr::memory_resource &other) const noexcept
+{
+    return this == &other;
+}
+
+size_t BufferPool::_sizeClass(size_t bytes)
+{
+    if(bytes <= BUFFER_POOL_MIN_BLOCK)
+    {
+        return 0;
+    }
+
+    // Smallest i with BUFFER_POOL_MIN_BLOCK << i >= bytes.
+    return std::bit_width((bytes - 1) / BUFFER_POOL_MIN_BLOCK);
+}
+
+void* BufferPool::_take(size_t sizeClass)
+{
+    if(_freeLists[sizeClass] == nullptr)
+    {
+        size_t blockSize = BUFFER_POOL_MIN_BLOCK << sizeClass;
+        size_t slabSize = std::max(blockSize, (size_t)BUFFER_POOL_SLAB_SIZE);
+        char* slab = static_cast<char*>(_upstream->allocate(slabSize, blockAlignment));
+        _upstreamCount++;
+        _slabs.push_back({slab, slabSize});
+        _slabBytes += slabSize;
+
+        // Split slab to free blocks. The first block is at the front of free list.
+        for(size_t offset = slabSize; offset >= blockSize; offset -= blockSize)
+        {
+            _give(sizeClass, slab + offset - blockSize);
+        }
+    }
+
+    FreeBlock* block = _freeLists[sizeClass];
+    _freeLists[sizeClass] = block->next;
+
+    return block;
+}
+
+void BufferPool::_give(size_t sizeClass, void* block)
+{
+    FreeBlock* node = static_cast<FreeBlock*>(block);
+    node->next = _freeLists[sizeClass];
+    _freeLists[sizeClass] = node;
+}
+
+void BufferPool::_release(PooledBuffer::Header* header)
+{
+    size_t blockSize = header->blockSize;
+    size_t capacity = header->capacity;
+    header->~Header();
+
+    if(blockSize == 0)
+    {
+        _upstream->deallocate(header, sizeof(PooledBuffer::Header) + capacity, alignof(PooledBuffer::Header));
+        return;
+    }
+
+    _give(_sizeClass(blockSize), header);
+}
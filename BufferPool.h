@@ -0,0 +1,208 @@
+#pragma once
+
+// ####################################################################################################
+// Include libraries:
+
+#include <cstddef>                  // Size types like size_t
+#include <cstdint>                  // Fixed width integer types
+#include <string_view>              // View of buffer data
+#include <vector>                   // Slab list
+#include <memory_resource>          // std::pmr::memory_resource
+
+// ####################################################################################################
+// Public macros:
+
+/// @brief Block size of the smallest size class of BufferPool in bytes. It must be a power of two.
+#define BUFFER_POOL_MIN_BLOCK               64
+
+/// @brief Number of size classes of BufferPool. Block sizes are BUFFER_POOL_MIN_BLOCK * 2^i. Default max is 128 KiB,
+/// so a 64 KiB payload and its header fit in a pooled block.
+#define BUFFER_POOL_CLASSES                 12
+
+/// @brief Size of memory that BufferPool takes from upstream at once and splits to blocks of one size class.
+#define BUFFER_POOL_SLAB_SIZE               (64 * 1024)
+
+class BufferPool;
+
+// ######################################################################################################
+// PooledBuffer Class:
+
+/**
+ * @class PooledBuffer
+ * @brief Reference counted handle of a BufferPool block. Copies share the same block. The block goes back to its
+ * pool when the last handle is destroyed or reset.
+ * @note A handle is not thread safe, like its pool. Handles must be released before their pool is destroyed.
+ */
+class PooledBuffer
+{
+public:
+
+    /// @brief Constructor. Empty handle.
+    PooledBuffer(void) noexcept;
+
+    PooledBuffer(const PooledBuffer &other) noexcept;
+    PooledBuffer(PooledBuffer &&other) noexcept;
+    PooledBuffer& operator=(const PooledBuffer &other) noexcept;
+    PooledBuffer& operator=(PooledBuffer &&other) noexcept;
+
+    /**
+     * Destructor. Release block.
+     */
+    ~PooledBuffer();
+
+    /// @brief Return pointer to data. nullptr for empty handle.
+    char* data(void) { return (_header != nullptr) ? reinterpret_cast<char*>(_header + 1) : nullptr; }
+    const char* data(void) const { return (_header != nullptr) ? reinterpret_cast<const char*>(_header + 1) : nullptr; }
+
+    /// @brief Return data size.
+    size_t size(void) const { return (_header != nullptr) ? _header->size : 0; }
+
+    /// @brief Return max data size of block.
+    size_t capacity(void) const { return (_header != nullptr) ? _header->capacity : 0; }
+
+    /// @brief Return true if data size is zero.
+    bool empty(void) const { return size() == 0; }
+
+    /// @brief Return data as string view.
+    std::string_view view(void) const { return std::string_view(data(), size()); }
+
+    /**
+     * @brief Change data size. Block is not changed.
+     * @return true if succeeded. false if size is larger than capacity.
+     */
+    bool resize(size_t size);
+
+    /// @brief Return number of handles that share the block. 0 for empty handle.
+    uint32_t useCount(void) const;
+
+    /// @brief Release block. Handle is empty after it.
+    void reset(void);
+
+private:
+
+    friend class BufferPool;
+
+    /**
+     * @struct Header
+     * @brief Block header before data.
+     */
+    struct alignas(16) Header
+    {
+        BufferPool* pool;               ///! @brief Owner pool.
+        size_t size;                    ///! @brief Data size.
+        size_t capacity;                ///! @brief Max data size.
+        uint32_t refCount;              ///! @brief Number of handles.
+        uint32_t blockSize;             ///! @brief Size of block including header. 0 for upstream block that is larger than size classes.
+    };
+
+    Header* _header;                    ///! @brief Block header. nullptr for empty handle.
+
+    /// @brief Constructor for BufferPool::acquire().
+    explicit PooledBuffer(Header* header) noexcept;
+
+};
+
+// ######################################################################################################
+// BufferPool Class:
+
+/**
+ * @class BufferPool
+ * @brief Slab allocator of power-of-two blocks for popped stream data, frames and tokens.
+ * Freed blocks are kept in free lists of their size class and reused, so steady state operation does not take memory
+ * from upstream (heap). Blocks larger than the largest size class are taken from upstream directly.
+ * @note It is a std::pmr::memory_resource too, so std::pmr containers can use it. For example
+ * std::pmr::vector<std::pmr::string> tokens(&pool) with splitString().
+ * @note It is not thread safe. Use one pool per stream consumer or per thread.
+ *
+ * Example:
+ * @code
+ * BufferPool pool;
+ * PooledBuffer data = stream.popAllRxBuffer(pool);
+ * process(data.view());                    // Block goes back to pool when data is destroyed.
+ * @endcode
+ */
+class BufferPool : public std::pmr::memory_resource
+{
+public:
+
+    /**
+     * @brief Constructor. Nothing is allocated until first use.
+     * @param upstream: Memory resource for slabs and large blocks.
+     */
+    BufferPool(std::pmr::memory_resource* upstream = std::pmr::new_delete_resource());
+
+    /**
+     * Destructor. Return all slabs to upstream. All blocks must be released before it.
+     */
+    ~BufferPool();
+
+    BufferPool(const BufferPool&) = delete;
+    BufferPool& operator=(const BufferPool&) = delete;
+
+    /**
+     * @brief Get a block for certain data size.
+     * @return Handle with data size equal to size. Empty handle for size 0.
+     */
+    PooledBuffer acquire(size_t size);
+
+    /**
+     * @brief Prepare free blocks, so the first uses do not take memory from upstream.
+     * @param size: Data size of blocks.
+     * @param count: Min number of free blocks of that size class.
+     */
+    void reserve(size_t size, size_t count);
+
+    /// @brief Return number of allocations from upstream. It does not change in steady state.
+    uint64_t getUpstreamCount(void) const;
+
+    /// @brief Return total size of slabs in bytes.
+    size_t getSlabBytes(void) const;
+
+protected:
+
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override;
+
+private:
+
+    friend class PooledBuffer;
+
+    /**
+     * @struct FreeBlock
+     * @brief Free list node inside a free block.
+     */
+    struct FreeBlock
+    {
+        FreeBlock* next;                ///! @brief Next free block.
+    };
+
+    /**
+     * @struct Slab
+     * @brief Memory taken from upstream.
+     */
+    struct Slab
+    {
+        void* data;                     ///! @brief Slab memory.
+        size_t size;                    ///! @brief Slab size.
+    };
+
+    std::pmr::memory_resource* _upstream;           ///! @brief Upstream memory resource.
+    FreeBlock* _freeLists[BUFFER_POOL_CLASSES];     ///! @brief Free blocks of each size class.
+    std::vector<Slab> _slabs;                       ///! @brief Slabs for destructor.
+    size_t _slabBytes;                              ///! @brief Total size of slabs.
+    uint64_t _upstreamCount;                        ///! @brief Number of allocations from upstream.
+
+    /// @brief Return size class of block size. BUFFER_POOL_CLASSES if it is larger than the largest class.
+    static size_t _sizeClass(size_t bytes);
+
+    /// @brief Take a block of size class. A new slab is split to free blocks if free list is empty.
+    void* _take(size_t sizeClass);
+
+    /// @brief Put block back to free list of size class.
+    void _give(size_t sizeClass, void* block);
+
+    /// @brief Release block of a handle.
+    void _release(PooledBuffer::Header* header);
+
+};
@@ -0,0 +1,339 @@
+// ####################################################################################################
+// Include libraries:
+
+#include "ColumnBatch.h"
+
+// ######################################################################################################
+// ColumnBatch Class:
+
+ColumnBatch::ColumnBatch(const std::vector<ValueType> &types, char delimiter)
+{
+    _delimiter = delimiter;
+    setColumnTypes(types);
+}
+
+bool ColumnBatch::setColumnTypes(const std::vector<ValueType> &types)
+{
+    _types.clear();
+    _columns.clear();
+
+    for(ValueType type : types)
+    {
+        // Variant alternatives are in ValueType order.
+        switch(type)
+        {
+            case ValueType::UINT8:  _columns.emplace_back(std::in_place_index<0>);  break;
+            case ValueType::UINT16: _columns.emplace_back(std::in_place_index<1>);  break;
+            case ValueType::UINT32: _columns.emplace_back(std::in_place_index<2>);  break;
+            case ValueType::UINT64: _columns.emplace_back(std::in_place_index<3>);  break;
+            case ValueType::INT8:   _columns.emplace_back(std::in_place_index<4>);  break;
+            case ValueType::INT16:  _columns.emplace_back(std::in_place_index<5>);  break;
+            case ValueType::INT32:  _columns.emplace_back(std::in_place_index<6>);  break;
+            case ValueType::INT64:  _columns.emplace_back(std::in_place_index<7>);  break;
+            case ValueType::FLOAT:  _columns.emplace_back(std::in_place_index<8>);  break;
+            case ValueType::DOUBLE: _columns.emplace_back(std::in_place_index<9>);  break;
+            case ValueType::STRING: _columns.emplace_back(std::in_place_index<10>); break;
+            case ValueType::BOOL:   _columns.emplace_back(std::in_place_index<11>); break;
+            default:
+                _types.clear();
+                _columns.clear();
+                clear();
+                return false;
+        }
+
+        _types.push_back(type);
+    }
+
+    clear();
+
+    return true;
+}
+
+bool ColumnBatch::setColumnTypes(const std::vector<std::string> &types)
+{
+    std::vector<ValueType> valueTypes;
+
+    for(const auto &type : types)
+    {
+        valueTypes.push_back(getValueType(type));
+    }
+
+    return setColumnTypes(valueTypes);
+}
+
+void ColumnBatch::setDelimiter(char delimiter)
+{
+    _delimiter = delimiter;
+}
+
+void ColumnBatch::clear(void)
+{
+    for(auto &column : _columns)
+    {
+        std::visit([](auto &values)
+        {
+            using C = std::decay_t<decltype(values)>;
+
+            if constexpr (std::is_same_v<C, StringColumn>)
+            {
+                values.chars.clear();
+                values.offsets.clear();
+            }
+            else
+            {
+                values.clear();
+            }
+        }, column);
+    }
+
+    _validity.clear();
+    _rowCount = 0;
+    _validRowCount = 0;
+}
+
+size_t ColumnBatch::parse(std::string_view text, std::vector<size_t>* invalidLines)
+{
+    size_t validRows = 0;
+    size_t start = 0;
+    size_t lineIndex = 0;
+
+    while(start < text.size())
+    {
+        size_t length = findCharacter(text.data() + start, text.size() - start, '\n');
+
+        // Last line may not have '\n'.
+        if(length == std::string::npos)
+        {
+            length = text.size() - start;
+        }
+
+        if(!_parseLine(text.substr(start, length), validRows) && (invalidLines != nullptr))
+        {
+            invalidLines->push_back(lineIndex);
+        }
+
+        start += length + 1;
+        lineIndex++;
+    }
+
+    return validRows;
+}
+
+size_t ColumnBatch::parse(Stream &stream)
+{
+    size_t validRows = 0;
+    size_t start = 0;
+    RingRegions<const char> regions = stream.peekRx();
+
+    while(true)
+    {
+        size_t pos = stream.findRx('\n', start);
+
+        if(pos == std::string::npos)
+        {
+            break;
+        }
+
+        size_t length = pos - start;
+        std::string_view line;
+
+        if(!regions.empty())
+        {
+            // Ring buffer backend. Copy only lines that wrap around the end of ring buffer.
+            RingRegions<const char> lineRegions = regions.subRegions(start, length);
+
+            if(lineRegions.second.empty())
+            {
+                line = std::string_view(lineRegions.first.data(), lineRegions.first.size());
+            }
+            else
+            {
+                _line.assign(lineRegions.first.data(), lineRegions.first.size());
+                _line.append(lineRegions.second.data(), lineRegions.second.size());
+                line = _line;
+            }
+        }
+        else
+        {
+            _line.resize(length);
+            stream.peekFrontRxBuffer(_line.data(), length, start);
+            line = _line;
+        }
+
+        _parseLine(line, validRows);
+        start = pos + 1;
+    }
+
+    stream.consumeRx(start);
+
+    return validRows;
+}
+
+bool ColumnBatch::parseRow(std::string_view line)
+{
+    size_t row = _rowCount;
+
+    // Append an empty row and then decode values directly into it.
+    for(auto &column : _columns)
+    {
+        std::visit([](auto &values)
+        {
+            using C = std::decay_t<decltype(values)>;
+
+            if constexpr (std::is_same_v<C, StringColumn>)
+            {
+                values.offsets.push_back(values.chars.size());
+            }
+            else
+            {
+                values.emplace_back();
+            }
+        }, column);
+    }
+
+    bool valid = true;
+    size_t position = 0;
+    std::string_view token;
+
+    for(auto &column : _columns)
+    {
+        if(!nextToken(line, _delimiter, position, token) || token.empty())
+        {
+            valid = false;
+            break;
+        }
+
+        valid = std::visit([&token](auto &values)
+        {
+            using C = std::decay_t<decltype(values)>;
+
+            if constexpr (std::is_same_v<C, StringColumn>)
+            {
+                values.chars.insert(values.chars.end(), token.begin(), token.end());
+                values.offsets.back() = values.chars.size();
+                return true;
+            }
+            else
+            {
+                typename C::value_type value;
+
+                if(!parseValue(token, value))
+                {
+                    return false;
+                }
+
+                values.back() = value;
+                return true;
+            }
+        }, column);
+
+        if(!valid)
+        {
+            break;
+        }
+    }
+
+    // Row must not have more tokens than columns.
+    if(valid && (position < line.size()))
+    {
+        valid = false;
+    }
+
+    if(!valid)
+    {
+        _resetLastRow();
+    }
+
+    if(row % 64 == 0)
+    {
+        _validity.push_back(0);
+    }
+
+    if(valid)
+    {
+        _validity.back() |= (uint64_t)1 << (row % 64);
+        _validRowCount++;
+    }
+
+    _rowCount++;
+
+    return valid;
+}
+
+size_t ColumnBatch::columnCount(void) const
+{
+    return _columns.size();
+}
+
+size_t ColumnBatch::rowCount(void) const
+{
+    return _rowCount;
+}
+
+size_t ColumnBatch::validRowCount(void) const
+{
+    return _validRowCount;
+}
+
+bool ColumnBatch::isValid(size_t row) const
+{
+    return (row < _rowCount) && ((_validity[row / 64] >> (row % 64)) & 1);
+}
+
+const std::vector<uint64_t>& ColumnBatch::validity(void) const
+{
+    return _validity;
+}
+
+ValueType ColumnBatch::columnType(size_t column) const
+{
+    return (column < _types.size()) ? _types[column] : ValueType::NONE;
+}
+
+const StringColumn* ColumnBatch::stringColumn(size_t column) const
+{
+    return std::get_if<StringColumn>(&_columns[column]);
+}
+
+bool ColumnBatch::_parseLine(std::string_view line, size_t &validRows)
+{
+    if(!line.empty() && (line.back() == '\r'))
+    {
+        line.remove_suffix(1);
+    }
+
+    if(std::all_of(line.begin(), line.end(), [](char c) { return std::isspace((unsigned char)c); }))
+    {
+        return true;
+    }
+
+    if(!parseRow(line))
+    {
+        return false;
+    }
+
+    validRows++;
+    return true;
+}
+
+void ColumnBatch::_resetLastRow(void)
+{
+    for(auto &column : _columns)
+    {
+        std::visit([](auto &values)
+        {
+            using C = std::decay_t<decltype(values)>;
+
+            if constexpr (std::is_same_v<C, StringColumn>)
+            {
+                size_t begin = (values.offsets.size() < 2) ? 0 : values.offsets[values.offsets.size() - 2];
+                values.chars.resize(begin);
+                values.offsets.back() = begin;
+            }
+            else
+            {
+                values.back() = typename C::value_type();
+            }
+        }, column);
+    }
+}
@@ -0,0 +1,156 @@
+#pragma once
+
+// ####################################################################################################
+// Include libraries:
+
+#include <string>                   // String class and related functions
+#include <string_view>              // Non-owning string views
+#include <vector>                   // Dynamic array container
+#include <variant>                  // Type safe union for column storage
+#include "Stream.h"                 // ValueType, parseValue, Stream class
+
+// ######################################################################################################
+// StringColumn Struct:
+
+/**
+ * @struct StringColumn
+ * @brief Storage of a string column. Characters of all rows are stored back to back in one array.
+ */
+struct StringColumn
+{
+    std::vector<char> chars;            ///! @brief Characters of all rows.
+    std::vector<size_t> offsets;        ///! @brief End position of each row in chars.
+
+    /// @brief Return number of rows.
+    size_t size(void) const { return offsets.size(); }
+
+    /// @brief Return string of certain row.
+    std::string_view at(size_t row) const
+    {
+        size_t begin = (row == 0) ? 0 : offsets[row - 1];
+        return std::string_view(chars.data() + begin, offsets[row] - begin);
+    }
+};
+
+// ######################################################################################################
+// ColumnBatch Class:
+
+/**
+ * @class ColumnBatch
+ * @brief Decode many delimited rows to typed columnar arrays (struct of arrays) with a per-row validity bitmap.
+ * @note Every line that is not empty or whitespace only is a row. Rows are valid with the same rules as
+ * splitString() + validateRow() + checkValuetype(). Values of invalid rows are zero/empty and their validity bit is 0.
+ * @note clear() keeps memory of columns, so a batch that is reused for next text blocks does not allocate in steady state.
+ */
+class ColumnBatch
+{
+public:
+
+    /// @brief Storage of one column. The alternative is selected by column ValueType.
+    using ColumnData = std::variant<std::vector<uint8_t>, std::vector<uint16_t>, std::vector<uint32_t>, std::vector<uint64_t>,
+                                    std::vector<int8_t>, std::vector<int16_t>, std::vector<int32_t>, std::vector<int64_t>,
+                                    std::vector<float>, std::vector<double>, StringColumn, std::vector<bool>>;
+
+    /**
+     * @brief Constructor.
+     * @param types: Column types.
+     * @param delimiter: Column delimiter character.
+     */
+    ColumnBatch(const std::vector<ValueType> &types = {}, char delimiter = ',');
+
+    /**
+     * @brief Set column types. All rows are removed.
+     * @return true if succeeded. false if a type is ValueType::NONE.
+     */
+    bool setColumnTypes(const std::vector<ValueType> &types);
+
+    /**
+     * @brief Set column types by name. All rows are removed.
+     * @param types: Type names that checkValuetype() understands. For example {"uint16", "float", "string"}.
+     * @return true if succeeded. false if a type name is not known.
+     */
+    bool setColumnTypes(const std::vector<std::string> &types);
+
+    /// @brief Set column delimiter character.
+    void setDelimiter(char delimiter);
+
+    /// @brief Remove all rows. Memory of columns is kept.
+    void clear(void);
+
+    /**
+     * @brief Decode all lines of a text block and append them as rows.
+     * @param text: Text block. Lines end with '\n'. A '\r' before '\n' is removed.
+     * Empty and whitespace only lines are skipped. The last line does not need '\n'.
+     * @param invalidLines: Optional output. Zero based line index in text of each invalid row is appended to it.
+     * @return Number of valid rows appended.
+     */
+    size_t parse(std::string_view text, std::vector<size_t>* invalidLines = nullptr);
+
+    /**
+     * @brief Decode complete lines from RX buffer of a stream, append them as rows and remove them from RX buffer.
+     * A last line without '\n' stays in RX buffer.
+     * @return Number of valid rows appended.
+     */
+    size_t parse(Stream &stream);
+
+    /**
+     * @brief Decode one row and append it.
+     * @return true if row is valid.
+     */
+    bool parseRow(std::string_view line);
+
+    /// @brief Return number of columns.
+    size_t columnCount(void) const;
+
+    /// @brief Return number of rows.
+    size_t rowCount(void) const;
+
+    /// @brief Return number of valid rows.
+    size_t validRowCount(void) const;
+
+    /// @brief Return true if certain row is valid.
+    bool isValid(size_t row) const;
+
+    /// @brief Return validity bitmap. Bit (row % 64) of word (row / 64) is 1 for a valid row.
+    const std::vector<uint64_t>& validity(void) const;
+
+    /// @brief Return type of certain column.
+    ValueType columnType(size_t column) const;
+
+    /**
+     * @brief Get values of a numeric or bool column.
+     * @tparam T Value type of column. For example int32_t for ValueType::INT32 and bool for ValueType::BOOL.
+     * @return Values pointer. nullptr if T is not type of column.
+     */
+    template<typename T>
+    const std::vector<T>* column(size_t column) const
+    {
+        return std::get_if<std::vector<T>>(&_columns[column]);
+    }
+
+    /**
+     * @brief Get values of a string column.
+     * @return Column pointer. nullptr if column is not ValueType::STRING.
+     */
+    const StringColumn* stringColumn(size_t column) const;
+
+private:
+
+    std::vector<ValueType> _types;      ///! @brief Column types.
+    std::vector<ColumnData> _columns;   ///! @brief Column values.
+    std::vector<uint64_t> _validity;    ///! @brief Validity bitmap.
+    size_t _rowCount;                   ///! @brief Number of rows.
+    size_t _validRowCount;              ///! @brief Number of valid rows.
+    char _delimiter;                    ///! @brief Column delimiter character.
+    std::string _line;                  ///! @brief Reused buffer for lines that are not contiguous in RX buffer.
+
+    /**
+     * @brief Decode one line if it is not empty.
+     * @return false if line is an invalid row.
+     */
+    bool _parseLine(std::string_view line, size_t &validRows);
+
+    /// @brief Set all values of last row to zero/empty.
+    void _resetLastRow(void);
+
+};
@@ -0,0 +1,226 @@
+// ####################################################################################################
+// Include libraries:
+
+#include "MappedRingBuffer.h"
+#include <new>                      // Placement new of header
+#include <cerrno>                   // errno
+#include <fcntl.h>                  // open, fcntl record locks
+#include <unistd.h>                 // close, ftruncate
+#include <sys/file.h>               // flock
+#include <sys/mman.h>               // mmap, munmap, msync
+#include <sys/stat.h>               // fstat
+
+// ####################################################################################################
+// Private variables:
+
+/// @brief Magic bytes at start of ring file.
+static const char mappedRingMagic[8] = {'S', 'T', 'R', 'M', 'R', 'I', 'N', 'G'};
+
+// ######################################################################################################
+// MappedRingBuffer Class:
+
+MappedRingBuffer::MappedRingBuffer(void)
+{
+    _fd = -1;
+    _map = nullptr;
+    _mapSize = 0;
+}
+
+MappedRingBuffer::~MappedRingBuffer()
+{
+    close();
+}
+
+bool MappedRingBuffer::open(const std::string &path, size_t capacity, bool replay)
+{
+    close();
+
+    int fd = ::open(path.c_str(), replay ? O_RDONLY : (O_RDWR | O_CREAT), 0644);
+    if(fd < 0)
+    {
+        return false;
+    }
+
+    return _mapFile(fd, capacity, replay);
+}
+
+void MappedRingBuffer::close(void)
+{
+    if(_map == nullptr)
+    {
+        return;
+    }
+
+    _detach();
+    munmap(_map, _mapSize);
+    ::close(_fd);
+    _fd = -1;
+    _map = nullptr;
+    _mapSize = 0;
+}
+
+bool MappedRingBuffer::isOpen(void) const
+{
+    return _map != nullptr;
+}
+
+bool MappedRingBuffer::sync(bool wait)
+{
+    if(_map == nullptr)
+    {
+        errno = EBADF;
+        return false;
+    }
+
+    return msync(_map, _mapSize, wait ? MS_SYNC : MS_ASYNC) == 0;
+}
+
+void* MappedRingBuffer::_headerExtra(void) const
+{
+    return static_cast<char*>(_map) + MAPPED_RING_EXTRA_OFFSET;
+}
+
+bool MappedRingBuffer::_mapFile(int fd, size_t capacity, bool replay)
+{
+    if(capacity > 0)
+    {
+        // Round up capacity to the next power of two.
+        size_t rounded = 1;
+        while(rounded < capacity)
+        {
+            rounded <<= 1;
+        }
+        capacity = rounded;
+    }
+
+    // Capture and replay exclude each other. Many processes can capture, for example producer and consumer.
+    if(flock(fd, (replay ? LOCK_EX : LOCK_SH) | LOCK_NB) != 0)
+    {
+        int error = errno;
+        ::close(fd);
+        errno = (error == EWOULDBLOCK) ? EBUSY : error;
+        return false;
+    }
+
+    // The record lock makes create and check atomic when processes open the same new file at the same time.
+    // Replay never creates a file.
+    struct flock lock = {};
+    lock.l_type = F_WRLCK;
+    lock.l_whence = SEEK_SET;
+
+    bool locked = replay || (fcntl(fd, F_OFD_SETLKW, &lock) == 0);
+    bool state = locked && _mapLocked(fd, capacity, replay);
+
+    int error = errno;
+    if(locked && !replay)
+    {
+        lock.l_type = F_UNLCK;
+        fcntl(fd, F_OFD_SETLK, &lock);
+    }
+
+    // Descriptor holds the capture or replay lock until close().
+    if(state)
+    {
+        _fd = fd;
+    }
+    else
+    {
+        ::close(fd);
+    }
+    errno = error;
+
+    return state;
+}
+
+bool MappedRingBuffer::_mapLocked(int fd, size_t capacity, bool replay)
+{
+    struct stat status;
+    if(fstat(fd, &status) != 0)
+    {
+        return false;
+    }
+
+    size_t fileSize = (size_t)status.st_size;
+    bool create = (fileSize == 0);
+
+    if(create)
+    {
+        if(replay || (capacity == 0))
+        {
+            errno = EINVAL;
+            return false;
+        }
+
+        fileSize = MAPPED_RING_HEADER_SIZE + capacity;
+        if(ftruncate(fd, (off_t)fileSize) != 0)
+        {
+            return false;
+        }
+    }
+
+    // Replay mapping is private: pops change a copy-on-write page of header, never the file. The capture is
+    // closed, so the file does not change under it.
+    void* map = mmap(nullptr, fileSize, PROT_READ | PROT_WRITE, replay ? MAP_PRIVATE : MAP_SHARED, fd, 0);
+    if(map == MAP_FAILED)
+    {
+        return false;
+    }
+
+    Header* header = static_cast<Header*>(map);
+
+    if(create)
+    {
+        new (header) Header{};
+        header->version = MAPPED_RING_VERSION;
+        header->headerSize = MAPPED_RING_HEADER_SIZE;
+        header->capacity = capacity;
+        // Magic is written last, so a crash during create leaves a file that is not accepted.
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memcpy(header->magic, mappedRingMagic, sizeof(mappedRingMagic));
+    }
+    else if(!_checkHeader(header, fileSize, capacity))
+    {
+        int error = errno;
+        munmap(map, fileSize);
+        errno = error;
+        return false;
+    }
+    else if(!replay)
+    {
+        // A shared push that reserved space but was not published before a crash is dropped.
+        header->indices.reserve.store(header->indices.tail.load(std::memory_order_acquire), std::memory_order_relaxed);
+    }
+
+    _map = map;
+    _mapSize = fileSize;
+    _attach(static_cast<char*>(map) + MAPPED_RING_HEADER_SIZE, header->capacity, &header->indices);
+
+    return true;
+}
+
+bool MappedRingBuffer::_checkHeader(const Header* header, size_t fileSize, size_t capacity) const
+{
+    uint64_t fileCapacity = header->capacity;
+
+    bool valid = (fileSize >= sizeof(Header)) &&
+                 (std::memcmp(header->magic, mappedRingMagic, sizeof(mappedRingMagic)) == 0) &&
+                 (header->version == MAPPED_RING_VERSION) &&
+                 (header->headerSize == MAPPED_RING_HEADER_SIZE) &&
+                 (fileCapacity > 0) && ((fileCapacity & (fileCapacity - 1)) == 0) &&
+                 (fileSize == MAPPED_RING_HEADER_SIZE + fileCapacity) &&
+                 ((capacity == 0) || (capacity == fileCapacity));
+
+    if(valid)
+    {
+        uint64_t head = header->indices.head.load(std::memory_order_acquire);
+        uint64_t tail = header->indices.tail.load(std::memory_order_acquire);
+        valid = (tail - head) <= fileCapacity;
+    }
+
+    if(!valid)
+    {
+        errno = EINVAL;
+    }
+
+    return valid;
+}
@@ -0,0 +1,127 @@
+#pragma once
+
+// ####################################################################################################
+// Include libraries:
+
+#include <string>                   // File path
+#include "RingBuffer.h"             // RingBuffer base class
+
+// ####################################################################################################
+// Public macros:
+
+/// @brief Size of mapped ring file header. Storage starts after it, so it must be a multiple of page size.
+#define MAPPED_RING_HEADER_SIZE             4096
+
+/// @brief Offset and size of the part of header that is free for derived classes.
+#define MAPPED_RING_EXTRA_OFFSET            1024
+#define MAPPED_RING_EXTRA_SIZE              (MAPPED_RING_HEADER_SIZE - MAPPED_RING_EXTRA_OFFSET)
+
+/// @brief Version of mapped ring file layout.
+#define MAPPED_RING_VERSION                 1
+
+// ######################################################################################################
+// MappedRingBuffer Class:
+
+/**
+ * @class MappedRingBuffer
+ * @brief Ring buffer in a memory-mapped file. It can be used as TX/RX buffer of Stream like RingBuffer.
+ * File: [header: magic, version, capacity, head/tail indices][storage].
+ * @note Stored data and indices are in the file, so data survives a crash or restart of process and the next open()
+ * continues from the same head and tail. Call sync() to write them to disk too, for example against power loss.
+ * @note Another process can open the same file at the same time as consumer, like SPSC threads of RingBuffer.
+ * Streams of both processes must be in SPSC mode, so producer never removes old data.
+ * @note Open the file in replay mode to read a closed capture without changing it. Pops only change a private copy
+ * of the indices and stored data is read from the file mapping without copy. Capture and replay of a file exclude
+ * each other, so a replay never misses data that a live capture pushes.
+ *
+ * Example:
+ * @code
+ * MappedRingBuffer capture;
+ * capture.open("/var/log/link.ring", 1 << 20);
+ * Stream stream(nullptr, &capture);        // RX data of stream is persisted.
+ * @endcode
+ */
+class MappedRingBuffer : public RingBuffer
+{
+public:
+
+    /**
+     * @brief Constructor. No file is opened and capacity is zero.
+     */
+    MappedRingBuffer(void);
+
+    /**
+     * Destructor. Close file.
+     */
+    ~MappedRingBuffer();
+
+    /**
+     * @brief Open or create a ring file and map it.
+     * @param path: File path.
+     * @param capacity: Minimum capacity in bytes of a new file. It is rounded up to the next power of two.
+     * For an existing file it must be 0 or the same rounded capacity.
+     * @param replay: If true the file must exist and it is not changed by this ring buffer. No other process or
+     * ring buffer may have it open, neither for capture nor for replay.
+     * @return true if succeeded. false if file can not be opened/mapped or it is not a valid ring file, errno is set.
+     * errno is EBUSY if the file is open for replay, or for capture when replay is requested.
+     * @note Attach ring buffer to a Stream after open(). Stream reads capacity when buffer is set.
+     * @note A shared push that was not published before a crash is dropped.
+     */
+    bool open(const std::string &path, size_t capacity = 0, bool replay = false);
+
+    /// @brief Unmap and close file. Capacity is zero after it.
+    void close(void);
+
+    /// @brief Return true if a file is open.
+    bool isOpen(void) const;
+
+    /**
+     * @brief Write mapped pages of file to disk.
+     * @param wait: If true wait until data is written. Otherwise only start writing.
+     * @return true if succeeded. false if msync fails, errno is set.
+     */
+    bool sync(bool wait = true);
+
+protected:
+
+    /**
+     * @brief Map an open file descriptor as ring file. A new file (size 0) is created with capacity.
+     * On success fd holds the capture or replay lock until close(). On failure it is closed.
+     * @return true if succeeded. false if file can not be mapped or it is not a valid ring file, errno is set.
+     */
+    bool _mapFile(int fd, size_t capacity, bool replay);
+
+    /**
+     * @brief Return free part of file header for derived classes. It is MAPPED_RING_EXTRA_SIZE bytes, cache-line
+     * aligned and zero in a new file.
+     */
+    void* _headerExtra(void) const;
+
+private:
+
+    /**
+     * @struct Header
+     * @brief Header of ring file.
+     */
+    struct Header
+    {
+        char magic[8];                  ///! @brief "STRMRING".
+        uint32_t version;               ///! @brief MAPPED_RING_VERSION.
+        uint32_t headerSize;            ///! @brief MAPPED_RING_HEADER_SIZE.
+        uint64_t capacity;              ///! @brief Storage size. It is a power of two.
+        RingIndices indices;            ///! @brief Ring indices.
+    };
+
+    static_assert(sizeof(Header) <= MAPPED_RING_EXTRA_OFFSET, "Mapped ring header does not fit.");
+
+    int _fd;                            ///! @brief Descriptor that holds capture or replay lock. -1 if no file is open.
+    void* _map;                         ///! @brief Mapped file memory. nullptr if no file is open.
+    size_t _mapSize;                    ///! @brief Size of mapped file memory.
+
+    /// @brief Map file while it is locked. fd is not closed.
+    bool _mapLocked(int fd, size_t capacity, bool replay);
+
+    /// @brief Check header of mapped file. Return false and set errno if it is not valid.
+    bool _checkHeader(const Header* header, size_t fileSize, size_t capacity) const;
+
+};
@@ -0,0 +1,161 @@
+// ####################################################################################################
+// Include libraries:
+
+#include "ParallelFileParser.h"
+#include <atomic>                   // Atomic chunk index
+#include <thread>                   // Worker threads
+#include <fcntl.h>                  // open
+#include <sys/mman.h>               // mmap, madvise
+#include <sys/stat.h>               // fstat
+
+// ######################################################################################################
+// ParallelFileParser Class:
+
+ParallelFileParser::ParallelFileParser(const std::vector<ValueType> &types, char delimiter, unsigned threadCount, size_t chunkSize)
+{
+    _types = types;
+    _delimiter = delimiter;
+    setThreadCount(threadCount);
+    setChunkSize(chunkSize);
+}
+
+void ParallelFileParser::setThreadCount(unsigned threadCount)
+{
+    _threadCount = threadCount;
+}
+
+void ParallelFileParser::setChunkSize(size_t chunkSize)
+{
+    _chunkSize = (chunkSize > 0) ? chunkSize : 1;
+}
+
+bool ParallelFileParser::parseFile(const std::string &path, std::vector<ChunkResult> &results) const
+{
+    results.clear();
+
+    int fd = open(path.c_str(), O_RDONLY);
+
+    if(fd < 0)
+    {
+        return false;
+    }
+
+    struct stat info;
+
+    if(fstat(fd, &info) != 0)
+    {
+        close(fd);
+        return false;
+    }
+
+    size_t size = (size_t)info.st_size;
+
+    if(size == 0)
+    {
+        close(fd);
+        return true;
+    }
+
+    void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if(data == MAP_FAILED)
+    {
+        return false;
+    }
+
+    madvise(data, size, MADV_SEQUENTIAL);
+
+    parseText(std::string_view((const char*)data, size), results);
+
+    munmap(data, size);
+
+    return true;
+}
+
+void ParallelFileParser::parseText(std::string_view text, std::vector<ChunkResult> &results) const
+{
+    std::vector<std::string_view> chunks = _splitChunks(text);
+
+    results.clear();
+    results.resize(chunks.size());
+
+    // Workers take next chunk index until all chunks are parsed.
+    std::atomic<size_t> nextChunk(0);
+
+    auto worker = [&]()
+    {
+        size_t index;
+
+        while((index = nextChunk.fetch_add(1, std::memory_order_relaxed)) < chunks.size())
+        {
+            ChunkResult &result = results[index];
+            std::string_view chunk = chunks[index];
+
+            result.batch.setDelimiter(_delimiter);
+            result.batch.setColumnTypes(_types);
+            result.batch.parse(chunk, &result.errorLines);
+
+            // Every chunk except maybe the last one ends with '\n'.
+            result.lineCount = std::count(chunk.begin(), chunk.end(), '\n');
+            if(!chunk.empty() && (chunk.back() != '\n'))
+            {
+                result.lineCount++;
+            }
+        }
+    };
+
+    unsigned threadCount = (_threadCount > 0) ? _threadCount : std::max(1u, std::thread::hardware_concurrency());
+    threadCount = (unsigned)std::min<size_t>(threadCount, chunks.size());
+
+    std::vector<std::thread> threads;
+    for(unsigned i = 1; i < threadCount; i++)
+    {
+        threads.emplace_back(worker);
+    }
+
+    // Calling thread is a worker too.
+    worker();
+
+    for(auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    // Convert chunk line indexes to file line numbers.
+    size_t line = 1;
+    for(auto &result : results)
+    {
+        result.firstLine = line;
+
+        for(auto &errorLine : result.errorLines)
+        {
+            errorLine += line;
+        }
+
+        line += result.lineCount;
+    }
+}
+
+std::vector<std::string_view> ParallelFileParser::_splitChunks(std::string_view text) const
+{
+    std::vector<std::string_view> chunks;
+    size_t start = 0;
+
+    while(start < text.size())
+    {
+        size_t end = std::min(start + _chunkSize, text.size());
+
+        // Move chunk end to after next '\n', so no line is split between chunks.
+        if(end < text.size())
+        {
+            size_t length = findCharacter(text.data() + end - 1, text.size() - end + 1, '\n');
+            end = (length == std::string::npos) ? text.size() : end + length;
+        }
+
+        chunks.push_back(text.substr(start, end - start));
+        start = end;
+    }
+
+    return chunks;
+}
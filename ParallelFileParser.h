@@ -0,0 +1,88 @@
+#pragma once
+
+// ####################################################################################################
+// Include libraries:
+
+#include <string>                   // String class and related functions
+#include <string_view>              // Non-owning string views
+#include <vector>                   // Dynamic array container
+#include "ColumnBatch.h"            // Columnar row decoder
+
+// ####################################################################################################
+// Public macros:
+
+/// @brief Default size of text chunks that are parsed by one worker in bytes.
+#define PARALLEL_PARSER_DEFAULT_CHUNK_SIZE      (4 * 1024 * 1024)
+
+// ######################################################################################################
+// ChunkResult Struct:
+
+/**
+ * @struct ChunkResult
+ * @brief Parse result of one newline aligned chunk of text.
+ */
+struct ChunkResult
+{
+    ColumnBatch batch;                  ///! @brief Decoded rows of chunk in original order.
+    size_t firstLine = 1;               ///! @brief Line number of first line of chunk. Line numbers start from 1.
+    size_t lineCount = 0;               ///! @brief Number of lines in chunk.
+    std::vector<size_t> errorLines;     ///! @brief Line numbers of invalid rows.
+
+    /// @brief Return number of invalid rows.
+    size_t errorCount(void) const { return errorLines.size(); }
+};
+
+// ######################################################################################################
+// ParallelFileParser Class:
+
+/**
+ * @class ParallelFileParser
+ * @brief Parse large delimited text files on multiple threads.
+ * File is memory mapped and split into newline aligned chunks. Worker threads decode chunks with ColumnBatch.
+ * @note Results are in original order and they are identical to parsing whole text with one ColumnBatch.
+ */
+class ParallelFileParser
+{
+public:
+
+    /**
+     * @brief Constructor.
+     * @param types: Column types.
+     * @param delimiter: Column delimiter character.
+     * @param threadCount: Number of worker threads. 0 means number of hardware threads.
+     * @param chunkSize: Approximate size of chunks in bytes.
+     */
+    ParallelFileParser(const std::vector<ValueType> &types, char delimiter = ',', unsigned threadCount = 0, size_t chunkSize = PARALLEL_PARSER_DEFAULT_CHUNK_SIZE);
+
+    /// @brief Set number of worker threads. 0 means number of hardware threads.
+    void setThreadCount(unsigned threadCount);
+
+    /// @brief Set approximate size of chunks in bytes.
+    void setChunkSize(size_t chunkSize);
+
+    /**
+     * @brief Memory map a file and parse it.
+     * @param path: File path.
+     * @param results: Output chunk results in original order. Its previous content is replaced.
+     * @return true if succeeded. false if file can not be opened or mapped.
+     */
+    bool parseFile(const std::string &path, std::vector<ChunkResult> &results) const;
+
+    /**
+     * @brief Parse a text block.
+     * @param text: Text block. Lines end with '\n'.
+     * @param results: Output chunk results in original order. Its previous content is replaced.
+     */
+    void parseText(std::string_view text, std::vector<ChunkResult> &results) const;
+
+private:
+
+    std::vector<ValueType> _types;      ///! @brief Column types.
+    char _delimiter;                    ///! @brief Column delimiter character.
+    unsigned _threadCount;              ///! @brief Number of worker threads.
+    size_t _chunkSize;                  ///! @brief Approximate size of chunks in bytes.
+
+    /// @brief Split text into chunks that end with '\n' or at the end of text.
+    std::vector<std::string_view> _splitChunks(std::string_view text) const;
+
+};
@@ -0,0 +1,259 @@
+// ####################################################################################################
+// Include libraries:
+
+#include "RecordCodec.h"
+#include <limits>                   // Range check of decoded integers
+
+// ####################################################################################################
+// Private functions:
+
+/// @brief Read little endian bytes of a float/double. Return false if payload is too short.
+template<typename T>
+static bool readFloat(const char* &data, const char* end, T &value)
+{
+    if((size_t)(end - data) < sizeof(T))
+    {
+        return false;
+    }
+
+    char bytes[sizeof(T)];
+    std::memcpy(bytes, data, sizeof(T));
+
+    if constexpr (std::endian::native == std::endian::big)
+    {
+        std::reverse(bytes, bytes + sizeof(T));
+    }
+
+    std::memcpy(&value, bytes, sizeof(T));
+    data += sizeof(T);
+
+    return true;
+}
+
+/// @brief Read unsigned varint and check range of T. Return false if it is not valid.
+template<typename T>
+static bool readUnsigned(const char* &data, const char* end, T &value)
+{
+    uint64_t raw;
+    size_t size = decodeVarint(data, end - data, raw);
+
+    if((size == 0) || (raw > std::numeric_limits<T>::max()))
+    {
+        return false;
+    }
+
+    value = (T)raw;
+    data += size;
+
+    return true;
+}
+
+/// @brief Read zigzag varint and check range of T. Return false if it is not valid.
+template<typename T>
+static bool readSigned(const char* &data, const char* end, T &value)
+{
+    uint64_t raw;
+    size_t size = decodeVarint(data, end - data, raw);
+
+    if(size == 0)
+    {
+        return false;
+    }
+
+    int64_t signedValue = (int64_t)(raw >> 1) ^ -(int64_t)(raw & 1);
+
+    if((signedValue < std::numeric_limits<T>::min()) || (signedValue > std::numeric_limits<T>::max()))
+    {
+        return false;
+    }
+
+    value = (T)signedValue;
+    data += size;
+
+    return true;
+}
+
+// ######################################################################################################
+// RecordCodec Class:
+
+RecordCodec::RecordCodec(const std::vector<ValueType> &types)
+{
+    _errorCount = 0;
+    setFieldTypes(types);
+}
+
+RecordCodec::RecordCodec(const std::vector<std::string> &types)
+{
+    _errorCount = 0;
+    setFieldTypes(types);
+}
+
+bool RecordCodec::setFieldTypes(const std::vector<ValueType> &types)
+{
+    _types = types;
+    _valid = std::find(types.begin(), types.end(), ValueType::NONE) == types.end();
+
+    return _valid;
+}
+
+bool RecordCodec::setFieldTypes(const std::vector<std::string> &types)
+{
+    std::vector<ValueType> valueTypes;
+    valueTypes.reserve(types.size());
+
+    for(const auto &type : types)
+    {
+        valueTypes.push_back(getValueType(type));
+    }
+
+    return setFieldTypes(valueTypes);
+}
+
+size_t RecordCodec::fieldCount(void) const
+{
+    return _types.size();
+}
+
+ValueType RecordCodec::fieldType(size_t field) const
+{
+    if(field >= _types.size())
+    {
+        return ValueType::NONE;
+    }
+
+    return _types[field];
+}
+
+bool RecordCodec::encodeText(const std::vector<std::string_view> &fields, std::string &payload) const
+{
+    payload.clear();
+
+    if((fields.size() != _types.size()) || !_valid)
+    {
+        return false;
+    }
+
+    for(size_t i = 0; i < fields.size(); i++)
+    {
+        std::string_view field = trimStringView(fields[i]);
+        bool state = false;
+
+        switch(_types[i])
+        {
+            case ValueType::UINT8:  state = _encodeText<uint8_t>(payload, i, field); break;
+            case ValueType::UINT16: state = _encodeText<uint16_t>(payload, i, field); break;
+            case ValueType::UINT32: state = _encodeText<uint32_t>(payload, i, field); break;
+            case ValueType::UINT64: state = _encodeText<uint64_t>(payload, i, field); break;
+            case ValueType::INT8:   state = _encodeText<int8_t>(payload, i, field); break;
+            case ValueType::INT16:  state = _encodeText<int16_t>(payload, i, field); break;
+            case ValueType::INT32:  state = _encodeText<int32_t>(payload, i, field); break;
+            case ValueType::INT64:  state = _encodeText<int64_t>(payload, i, field); break;
+            case ValueType::FLOAT:  state = _encodeText<float>(payload, i, field); break;
+            case ValueType::DOUBLE: state = _encodeText<double>(payload, i, field); break;
+            case ValueType::BOOL:   state = _encodeText<bool>(payload, i, field); break;
+            case ValueType::STRING: state = _encodeText<std::string_view>(payload, i, field); break;
+            default: break;
+        }
+
+        if(!state)
+        {
+            payload.clear();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool RecordCodec::decode(const char* payload, size_t size, std::vector<RecordValue> &values) const
+{
+    values.clear();
+
+    if(!_valid)
+    {
+        return false;
+    }
+
+    const char* data = payload;
+    const char* end = payload + size;
+
+    for(ValueType type : _types)
+    {
+        bool state = false;
+
+        switch(type)
+        {
+            case ValueType::UINT8:  { uint8_t value{};  state = readUnsigned(data, end, value); values.emplace_back(value); break; }
+            case ValueType::UINT16: { uint16_t value{}; state = readUnsigned(data, end, value); values.emplace_back(value); break; }
+            case ValueType::UINT32: { uint32_t value{}; state = readUnsigned(data, end, value); values.emplace_back(value); break; }
+            case ValueType::UINT64: { uint64_t value{}; state = readUnsigned(data, end, value); values.emplace_back(value); break; }
+            case ValueType::INT8:   { int8_t value{};   state = readSigned(data, end, value);   values.emplace_back(value); break; }
+            case ValueType::INT16:  { int16_t value{};  state = readSigned(data, end, value);   values.emplace_back(value); break; }
+            case ValueType::INT32:  { int32_t value{};  state = readSigned(data, end, value);   values.emplace_back(value); break; }
+            case ValueType::INT64:  { int64_t value{};  state = readSigned(data, end, value);   values.emplace_back(value); break; }
+            case ValueType::FLOAT:  { float value{};    state = readFloat(data, end, value);    values.emplace_back(value); break; }
+            case ValueType::DOUBLE: { double value{};   state = readFloat(data, end, value);    values.emplace_back(value); break; }
+            case ValueType::BOOL:
+            {
+                state = (data < end) && ((uint8_t)*data <= 1);
+                values.emplace_back(state && (*data == 1));
+                data++;
+                break;
+            }
+            case ValueType::STRING:
+            {
+                uint64_t length;
+                if(!readUnsigned(data, end, length) || (length > (uint64_t)(end - data)))
+                {
+                    break;
+                }
+                values.emplace_back(std::string_view(data, length));
+                data += length;
+                state = true;
+                break;
+            }
+            default: break;
+        }
+
+        if(!state)
+        {
+            values.clear();
+            return false;
+        }
+    }
+
+    // Extra bytes after last field are not accepted.
+    if(data != end)
+    {
+        values.clear();
+        return false;
+    }
+
+    return true;
+}
+
+bool RecordCodec::popRecord(RecordFramer &framer, std::vector<RecordValue> &values)
+{
+    while(framer.popFrame(_rxPayload))
+    {
+        if(decode(_rxPayload.data(), _rxPayload.size(), values))
+        {
+            return true;
+        }
+
+        _errorCount++;
+    }
+
+    return false;
+}
+
+uint32_t RecordCodec::getErrorCount(void) const
+{
+    return _errorCount;
+}
+
+void RecordCodec::_appendVarint(std::string &payload, uint64_t value)
+{
+    char bytes[VARINT_MAX_SIZE];
+    payload.append(bytes, encodeVarint(value, bytes));
+}
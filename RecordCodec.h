@@ -0,0 +1,237 @@
+#pragma once
+
+// ####################################################################################################
+// Include libraries:
+
+#include <string>                   // String class and related functions
+#include <string_view>              // Non-owning string views
+#include <variant>                  // Type safe union for decoded values
+#include <vector>                   // Dynamic array container
+#include <type_traits>              // Compile time type checks
+#include <algorithm>                // std::reverse
+#include <bit>                      // std::endian
+#include <cstring>                  // std::memcpy
+#include "Stream.h"                 // ValueType, varint, Stream class
+#include "StreamFramer.h"           // RecordFramer
+
+// ######################################################################################################
+// RecordValue Type:
+
+/// @brief Decoded value of a record field. The alternative is selected by field ValueType. Strings point to payload.
+using RecordValue = std::variant<uint8_t, uint16_t, uint32_t, uint64_t, int8_t, int16_t, int32_t, int64_t,
+                                 float, double, std::string_view, bool>;
+
+// ######################################################################################################
+// RecordCodec Class:
+
+/**
+ * @class RecordCodec
+ * @brief Compact binary encoding of typed records. Field types are the types that checkValuetype() understands.
+ * Field encoding:
+ * - uint8...uint64: LEB128 varint.
+ * - int8...int64: zigzag LEB128 varint, so small negative values are small too.
+ * - float/double: 4/8 bytes IEEE 754 little endian.
+ * - bool: 1 byte, 0 or 1.
+ * - string: varint length and characters.
+ * @note Records are framed on a stream with RecordFramer, which adds varint length and CRC-32C.
+ *
+ * Example:
+ * @code
+ * RecordCodec codec({"uint16", "float", "bool", "string"});
+ * RecordFramer framer(&stream);
+ * codec.pushRecord(framer, (uint16_t)12, 3.5f, true, std::string_view("GPS"));
+ * std::vector<RecordValue> values;
+ * while(codec.popRecord(framer, values)) { ... }
+ * @endcode
+ */
+class RecordCodec
+{
+public:
+
+    /**
+     * @brief Constructor.
+     * @param types: Field types.
+     */
+    RecordCodec(const std::vector<ValueType> &types = {});
+
+    /**
+     * @brief Constructor.
+     * @param types: Field type names that checkValuetype() understands. Unknown names are ValueType::NONE and
+     * such a codec encodes and decodes nothing.
+     */
+    RecordCodec(const std::vector<std::string> &types);
+
+    /**
+     * @brief Set field types.
+     * @return true if succeeded. false if a type is ValueType::NONE.
+     */
+    bool setFieldTypes(const std::vector<ValueType> &types);
+
+    /**
+     * @brief Set field types by name.
+     * @param types: Type names that checkValuetype() understands. For example {"uint16", "float", "string"}.
+     * @return true if succeeded. false if a type name is not known.
+     */
+    bool setFieldTypes(const std::vector<std::string> &types);
+
+    /// @brief Return number of fields.
+    size_t fieldCount(void) const;
+
+    /// @brief Return type of certain field.
+    ValueType fieldType(size_t field) const;
+
+    /**
+     * @brief Encode typed values of a record.
+     * @param payload: Encoded record. Its previous content is replaced. It is empty on failure.
+     * @return true if succeeded. false if number or types of values do not match field types.
+     */
+    template<typename... Args>
+    bool encode(std::string &payload, const Args&... values) const
+    {
+        payload.clear();
+
+        if((sizeof...(Args) != _types.size()) || !_valid)
+        {
+            return false;
+        }
+
+        size_t field = 0;
+        if(!(_encodeValue(payload, field++, values) && ...))
+        {
+            payload.clear();
+            return false;
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Encode text fields of a record, for example tokens of splitString(). Fields are validated like
+     * checkValuetype() and trimmed.
+     * @param payload: Encoded record. Its previous content is replaced. It is empty on failure.
+     * @return true if succeeded. false if number of fields does not match or a field is not valid for its type.
+     */
+    bool encodeText(const std::vector<std::string_view> &fields, std::string &payload) const;
+
+    /**
+     * @brief Decode a record.
+     * @param values: Decoded values. Its memory is reused. Strings point to memory of payload.
+     * @return true if succeeded. false if payload is not a valid record.
+     */
+    bool decode(const char* payload, size_t size, std::vector<RecordValue> &values) const;
+
+    /**
+     * @brief Encode typed values of a record and push it as a frame to TX buffer of framer stream.
+     * @return true if succeeded. false if values do not match or frame does not fit in TX buffer.
+     */
+    template<typename... Args>
+    bool pushRecord(RecordFramer &framer, const Args&... values)
+    {
+        return encode(_txPayload, values...) && framer.pushFrame(_txPayload.data(), _txPayload.size());
+    }
+
+    /**
+     * @brief Pop next valid record from RX buffer of framer stream and decode it.
+     * Frames that are not valid records are dropped.
+     * @param values: Decoded values. Strings point to memory of codec and are valid until next popRecord().
+     * @return true if a record is popped.
+     */
+    bool popRecord(RecordFramer &framer, std::vector<RecordValue> &values);
+
+    /// @brief Return number of frames that have valid CRC but are not valid records.
+    uint32_t getErrorCount(void) const;
+
+private:
+
+    std::vector<ValueType> _types;      ///! @brief Field types.
+    bool _valid;                        ///! @brief False if a field type is ValueType::NONE.
+    std::string _txPayload;             ///! @brief Reused buffer of pushRecord().
+    std::string _rxPayload;             ///! @brief Reused buffer of popRecord().
+    uint32_t _errorCount;               ///! @brief Number of invalid records.
+
+    /// @brief Append unsigned varint.
+    static void _appendVarint(std::string &payload, uint64_t value);
+
+    /// @brief Append little endian bytes of a float/double.
+    template<typename T>
+    static void _appendFloat(std::string &payload, T value)
+    {
+        char bytes[sizeof(T)];
+        std::memcpy(bytes, &value, sizeof(T));
+
+        if constexpr (std::endian::native == std::endian::big)
+        {
+            std::reverse(bytes, bytes + sizeof(T));
+        }
+
+        payload.append(bytes, sizeof(T));
+    }
+
+    /// @brief Encode one value if its C++ type is the field type.
+    template<typename T>
+    bool _encodeValue(std::string &payload, size_t field, const T &value) const
+    {
+        ValueType type = _types[field];
+
+        if constexpr (std::is_same_v<T, bool>)
+        {
+            if(type != ValueType::BOOL) return false;
+            payload.push_back(value ? 1 : 0);
+        }
+        else if constexpr (std::is_same_v<T, float>)
+        {
+            if(type != ValueType::FLOAT) return false;
+            _appendFloat(payload, value);
+        }
+        else if constexpr (std::is_same_v<T, double>)
+        {
+            if(type != ValueType::DOUBLE) return false;
+            _appendFloat(payload, value);
+        }
+        else if constexpr (std::is_integral_v<T> && std::is_unsigned_v<T>)
+        {
+            if(type != _integerType<T>()) return false;
+            _appendVarint(payload, value);
+        }
+        else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>)
+        {
+            if(type != _integerType<T>()) return false;
+            // Zigzag: 0, -1, 1, -2, ... to 0, 1, 2, 3, ...
+            int64_t signedValue = value;
+            _appendVarint(payload, ((uint64_t)signedValue << 1) ^ (uint64_t)(signedValue >> 63));
+        }
+        else
+        {
+            static_assert(std::is_convertible_v<const T&, std::string_view>, "Record field type is not supported.");
+            if(type != ValueType::STRING) return false;
+            std::string_view text(value);
+            _appendVarint(payload, text.size());
+            payload.append(text.data(), text.size());
+        }
+
+        return true;
+    }
+
+    /// @brief Parse a text field with parseValue() and encode it.
+    template<typename T>
+    bool _encodeText(std::string &payload, size_t field, std::string_view text) const
+    {
+        T value;
+        return parseValue(text, value) && _encodeValue(payload, field, value);
+    }
+
+    /// @brief Return ValueType of an integer type.
+    template<typename T>
+    static constexpr ValueType _integerType(void)
+    {
+        if constexpr (std::is_unsigned_v<T>)
+        {
+            return (sizeof(T) == 1) ? ValueType::UINT8 : (sizeof(T) == 2) ? ValueType::UINT16 : (sizeof(T) == 4) ? ValueType::UINT32 : ValueType::UINT64;
+        }
+        else
+        {
+            return (sizeof(T) == 1) ? ValueType::INT8 : (sizeof(T) == 2) ? ValueType::INT16 : (sizeof(T) == 4) ? ValueType::INT32 : ValueType::INT64;
+        }
+    }
+
+};
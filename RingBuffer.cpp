@@ -0,0 +1,295 @@
+// ####################################################################################################
+// Include libraries:
+
+#include "RingBuffer.h"
+#include <new>                      // Aligned operator new
+#include <algorithm>                // Algorithms like std::min
+#include <thread>                   // std::this_thread::yield
+
+// ####################################################################################################
+// RingBuffer Class:
+
+RingBuffer::RingBuffer(size_t capacity)
+{
+    // Round up capacity to the next power of two.
+    _capacity = 1;
+    while(_capacity < capacity)
+    {
+        _capacity <<= 1;
+    }
+
+    _mask = _capacity - 1;
+    _indices = &_localIndices;
+    _owned = true;
+    _data = static_cast<char*>(::operator new[](_capacity, std::align_val_t(RING_BUFFER_CACHE_LINE_SIZE)));
+}
+
+RingBuffer::RingBuffer(void)
+{
+    _data = nullptr;
+    _capacity = 0;
+    _mask = 0;
+    _indices = &_localIndices;
+    _owned = false;
+}
+
+RingBuffer::~RingBuffer()
+{
+    if(_owned)
+    {
+        ::operator delete[](_data, std::align_val_t(RING_BUFFER_CACHE_LINE_SIZE));
+    }
+}
+
+size_t RingBuffer::capacity(void) const
+{
+    return _capacity;
+}
+
+size_t RingBuffer::size(void) const
+{
+    // Head first. Tail is never behind a head that is loaded earlier, so the difference can not wrap around.
+    // Consumer can pop and producer can push between the loads, so it is limited to capacity.
+    uint64_t head = _indices->head.load(std::memory_order_acquire);
+    uint64_t tail = _indices->tail.load(std::memory_order_acquire);
+
+    return std::min((size_t)(tail - head), _capacity);
+}
+
+size_t RingBuffer::freeSpace(void) const
+{
+    return _capacity - size();
+}
+
+bool RingBuffer::empty(void) const
+{
+    return size() == 0;
+}
+
+bool RingBuffer::full(void) const
+{
+    return size() == _capacity;
+}
+
+size_t RingBuffer::push(const char* data, size_t size)
+{
+    // Producer side: own tail, acquire head to see space released by consumer.
+    uint64_t tail = _indices->tail.load(std::memory_order_relaxed);
+    uint64_t head = _indices->head.load(std::memory_order_acquire);
+
+    size = std::min(size, _capacity - (size_t)(tail - head));
+    _write(tail, data, size);
+    _indices->reserve.store(tail + size, std::memory_order_relaxed);
+    _indices->tail.store(tail + size, std::memory_order_release);
+
+    return size;
+}
+
+bool RingBuffer::tryPush(const char* data, size_t size)
+{
+    uint64_t tail = _indices->tail.load(std::memory_order_relaxed);
+    uint64_t head = _indices->head.load(std::memory_order_acquire);
+
+    if(size > _capacity - (size_t)(tail - head))
+    {
+        return false;
+    }
+
+    _write(tail, data, size);
+    _indices->reserve.store(tail + size, std::memory_order_relaxed);
+    _indices->tail.store(tail + size, std::memory_order_release);
+
+    return true;
+}
+
+bool RingBuffer::tryPushShared(const char* data, size_t size)
+{
+    std::string_view record(data, size);
+
+    return tryPushShared(&record, 1);
+}
+
+bool RingBuffer::tryPushShared(const std::string_view* records, size_t count)
+{
+    size_t size = 0;
+    for(size_t i = 0; i < count; i++)
+    {
+        size += records[i].size();
+    }
+
+    if(size == 0)
+    {
+        return true;
+    }
+
+    // Reserve a contiguous range after other producers. The exchange only fails when another producer reserved first.
+    uint64_t start = _indices->reserve.load(std::memory_order_relaxed);
+    do
+    {
+        uint64_t head = _indices->head.load(std::memory_order_acquire);
+
+        if(size > _capacity - (size_t)(start - head))
+        {
+            return false;
+        }
+    } while(!_indices->reserve.compare_exchange_weak(start, start + size, std::memory_order_relaxed));
+
+    // Copy records in parallel with other producers.
+    uint64_t position = start;
+    for(size_t i = 0; i < count; i++)
+    {
+        _write(position, records[i].data(), records[i].size());
+        position += records[i].size();
+    }
+
+    // Publish in reservation order, so consumer never sees a range that another producer is still writing.
+    while(_indices->tail.load(std::memory_order_acquire) != start)
+    {
+        std::this_thread::yield();
+    }
+    _indices->tail.store(start + size, std::memory_order_release);
+
+    return true;
+}
+
+size_t RingBuffer::pop(char* data, size_t size)
+{
+    // Consumer side: own head, acquire tail to see data published by producer.
+    uint64_t head = _indices->head.load(std::memory_order_relaxed);
+    uint64_t tail = _indices->tail.load(std::memory_order_acquire);
+
+    size = std::min(size, (size_t)(tail - head));
+    _read(head, data, size);
+    _indices->head.store(head + size, std::memory_order_release);
+
+    return size;
+}
+
+bool RingBuffer::tryPop(char* data, size_t size)
+{
+    uint64_t head = _indices->head.load(std::memory_order_relaxed);
+    uint64_t tail = _indices->tail.load(std::memory_order_acquire);
+
+    if(size > (size_t)(tail - head))
+    {
+        return false;
+    }
+
+    _read(head, data, size);
+    _indices->head.store(head + size, std::memory_order_release);
+
+    return true;
+}
+
+size_t RingBuffer::peek(char* data, size_t size, size_t offset) const
+{
+    uint64_t head = _indices->head.load(std::memory_order_relaxed);
+    uint64_t tail = _indices->tail.load(std::memory_order_acquire);
+    size_t stored = (size_t)(tail - head);
+
+    if(offset >= stored)
+    {
+        return 0;
+    }
+
+    size = std::min(size, stored - offset);
+    _read(head + offset, data, size);
+
+    return size;
+}
+
+size_t RingBuffer::discard(size_t size)
+{
+    uint64_t head = _indices->head.load(std::memory_order_relaxed);
+    uint64_t tail = _indices->tail.load(std::memory_order_acquire);
+
+    size = std::min(size, (size_t)(tail - head));
+    _indices->head.store(head + size, std::memory_order_release);
+
+    return size;
+}
+
+void RingBuffer::clear(void)
+{
+    _indices->head.store(_indices->tail.load(std::memory_order_acquire), std::memory_order_release);
+}
+
+RingRegions<const char> RingBuffer::readRegions(size_t size) const
+{
+    uint64_t head = _indices->head.load(std::memory_order_relaxed);
+    uint64_t tail = _indices->tail.load(std::memory_order_acquire);
+
+    size = std::min(size, (size_t)(tail - head));
+
+    size_t index = head & _mask;
+    size_t firstPart = std::min(size, _capacity - index);
+
+    return {{_data + index, firstPart}, {_data, size - firstPart}};
+}
+
+RingRegions<char> RingBuffer::writeRegions(size_t size)
+{
+    uint64_t tail = _indices->tail.load(std::memory_order_relaxed);
+    uint64_t head = _indices->head.load(std::memory_order_acquire);
+
+    size = std::min(size, _capacity - (size_t)(tail - head));
+
+    size_t index = tail & _mask;
+    size_t firstPart = std::min(size, _capacity - index);
+
+    return {{_data + index, firstPart}, {_data, size - firstPart}};
+}
+
+size_t RingBuffer::commit(size_t size)
+{
+    uint64_t tail = _indices->tail.load(std::memory_order_relaxed);
+    uint64_t head = _indices->head.load(std::memory_order_acquire);
+
+    size = std::min(size, _capacity - (size_t)(tail - head));
+    _indices->reserve.store(tail + size, std::memory_order_relaxed);
+    _indices->tail.store(tail + size, std::memory_order_release);
+
+    return size;
+}
+
+char RingBuffer::at(size_t index) const
+{
+    return _data[(_indices->head.load(std::memory_order_relaxed) + index) & _mask];
+}
+
+void RingBuffer::_attach(char* data, size_t capacity, RingIndices* indices)
+{
+    _data = data;
+    _capacity = capacity;
+    _mask = capacity - 1;
+    _indices = indices;
+}
+
+void RingBuffer::_detach(void)
+{
+    _data = nullptr;
+    _capacity = 0;
+    _mask = 0;
+    _indices = &_localIndices;
+    _localIndices.head.store(0, std::memory_order_relaxed);
+    _localIndices.tail.store(0, std::memory_order_relaxed);
+    _localIndices.reserve.store(0, std::memory_order_relaxed);
+}
+
+void RingBuffer::_write(uint64_t tail, const char* data, size_t size)
+{
+    // Copy in two parts if data wraps around the end of storage.
+    size_t index = tail & _mask;
+    size_t firstPart = std::min(size, _capacity - index);
+    std::memcpy(_data + index, data, firstPart);
+    std::memcpy(_data, data + firstPart, size - firstPart);
+}
+
+void RingBuffer::_read(uint64_t head, char* data, size_t size) const
+{
+    // Copy in two parts if data wraps around the end of storage.
+    size_t index = head & _mask;
+    size_t firstPart = std::min(size, _capacity - index);
+    std::memcpy(data, _data + index, firstPart);
+    std::memcpy(data + firstPart, _data, size - firstPart);
+}
@@ -0,0 +1,261 @@
+#pragma once
+
+// ####################################################################################################
+// Include libraries:
+
+#include <cstddef>                  // Size types like size_t
+#include <cstdint>                  // Fixed width integer types
+#include <cstring>                  // Memory functions like std::memcpy
+#include <atomic>                   // Atomic head/tail indices
+#include <span>                     // Contiguous memory views
+#include <algorithm>                // Algorithms like std::min
+#include <string_view>              // Records of shared push
+
+// ####################################################################################################
+// Public macros:
+
+/// @brief Alignment in bytes of the ring buffer storage.
+#define RING_BUFFER_CACHE_LINE_SIZE         64
+
+// ######################################################################################################
+// RingRegions Struct:
+
+/**
+ * @struct RingRegions
+ * @brief Up to two contiguous memory regions of a ring buffer in order. second is empty if the range does not
+ * wrap around the end of storage.
+ */
+template<typename T>
+struct RingRegions
+{
+    std::span<T> first;                 ///! @brief First contiguous region.
+    std::span<T> second;                ///! @brief Second contiguous region that starts at the begin of storage.
+
+    /// @brief Return total size of regions.
+    size_t size(void) const { return first.size() + second.size(); }
+
+    /// @brief Return true if regions are empty.
+    bool empty(void) const { return size() == 0; }
+
+    /**
+     * @brief Return regions of a sub range.
+     * @param offset: Start position of sub range from begin of first region.
+     * @param count: Max size of sub range.
+     */
+    RingRegions subRegions(size_t offset, size_t count = SIZE_MAX) const
+    {
+        RingRegions regions;
+
+        if(offset < first.size())
+        {
+            regions.first = first.subspan(offset, std::min(count, first.size() - offset));
+            count -= regions.first.size();
+            offset = 0;
+        }
+        else
+        {
+            offset -= first.size();
+        }
+
+        if(offset < second.size())
+        {
+            regions.second = second.subspan(offset, std::min(count, second.size() - offset));
+        }
+
+        // Keep data in first region if it starts in second region.
+        if(regions.first.empty())
+        {
+            std::swap(regions.first, regions.second);
+        }
+
+        return regions;
+    }
+};
+
+// ######################################################################################################
+// RingIndices Struct:
+
+/**
+ * @struct RingIndices
+ * @brief Free running indices of a ring buffer. Each index is on its own cache line.
+ * @note Indices are lock-free atomics, so they also work in memory that is shared between processes.
+ */
+struct RingIndices
+{
+    /// @brief Read index. It is only written by consumer.
+    alignas(RING_BUFFER_CACHE_LINE_SIZE) std::atomic<uint64_t> head{0};
+
+    /// @brief Write index. It is only written by producer.
+    alignas(RING_BUFFER_CACHE_LINE_SIZE) std::atomic<uint64_t> tail{0};
+
+    /// @brief Reservation index of shared push. It is equal to tail when no shared push is in progress.
+    alignas(RING_BUFFER_CACHE_LINE_SIZE) std::atomic<uint64_t> reserve{0};
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "Ring indices must be lock-free.");
+
+// ######################################################################################################
+// RingBuffer Class:
+
+/**
+ * @class RingBuffer
+ * @brief Fixed capacity byte ring buffer. It can be used as TX/RX buffer of Stream instead of std::deque<char>.
+ * @note Capacity is rounded up to a power of two and storage is cache-line aligned.
+ * All memory is allocated in the constructor. Push/pop operations never allocate and copy data with memcpy.
+ * @note It is lock-free for single producer and single consumer (SPSC): One thread may call push/tryPush while another
+ * thread calls pop/tryPop/peek/discard/clear/at. Head and tail indices are atomics with acquire/release ordering and
+ * they are placed on separate cache lines.
+ * @note Many producers may call tryPushShared() at the same time while one consumer pops (MPSC). Each call reserves a
+ * contiguous range, copies its records and publishes them in reservation order, so records never interleave.
+ * Shared and single producer push functions must not be called at the same time.
+ */
+class RingBuffer
+{
+public:
+
+    /**
+     * @brief Constructor. Allocate ring buffer storage.
+     * @param capacity: Minimum capacity in bytes. It is rounded up to the next power of two.
+     */
+    RingBuffer(size_t capacity);
+
+    /**
+     * Destructor. Free ring buffer storage.
+     */
+    virtual ~RingBuffer();
+
+    RingBuffer(const RingBuffer&) = delete;
+    RingBuffer& operator=(const RingBuffer&) = delete;
+
+    /// @brief Return capacity of ring buffer in bytes.
+    size_t capacity(void) const;
+
+    /// @brief Return number of stored bytes.
+    size_t size(void) const;
+
+    /// @brief Return number of bytes that can be pushed before ring buffer is full.
+    size_t freeSpace(void) const;
+
+    /// @brief Return true if there is no stored byte.
+    bool empty(void) const;
+
+    /// @brief Return true if there is no free space.
+    bool full(void) const;
+
+    /**
+     * @brief Push back certain number of bytes from char array.
+     * @return Number of bytes pushed. It is less than size if there is not enough free space.
+     */
+    size_t push(const char* data, size_t size);
+
+    /**
+     * @brief Push back certain number of bytes from char array only if all of them fit in free space.
+     * @return true if succeeded. false if there is not enough free space and nothing is pushed.
+     */
+    bool tryPush(const char* data, size_t size);
+
+    /**
+     * @brief Push back all bytes of char array only if they fit in free space. Many producers may call it at the same time.
+     * @return true if succeeded. false if there is not enough free space and nothing is pushed.
+     */
+    bool tryPushShared(const char* data, size_t size);
+
+    /**
+     * @brief Push back records as one contiguous range only if all of them fit in free space.
+     * Many producers may call it at the same time. Records of one call are never interleaved with other producers.
+     * @param records: Record array.
+     * @param count: Number of records.
+     * @return true if succeeded. false if there is not enough free space and nothing is pushed.
+     * @note After copy it waits until earlier reservations of other producers are published.
+     */
+    bool tryPushShared(const std::string_view* records, size_t count);
+
+    /**
+     * @brief Pop front certain number of bytes to char array and remove them.
+     * @return Number of bytes popped.
+     */
+    size_t pop(char* data, size_t size);
+
+    /**
+     * @brief Pop front certain number of bytes to char array only if that many bytes are stored.
+     * @return true if succeeded. false if there is not enough stored bytes and nothing is popped.
+     */
+    bool tryPop(char* data, size_t size);
+
+    /**
+     * @brief Copy certain number of bytes to char array without removing them.
+     * @param offset: Number of bytes from front of ring buffer to skip.
+     * @return Number of bytes copied.
+     */
+    size_t peek(char* data, size_t size, size_t offset = 0) const;
+
+    /**
+     * @brief Remove certain number of bytes from front of ring buffer.
+     * @return Number of bytes removed.
+     */
+    size_t discard(size_t size);
+
+    /// @brief Remove all stored bytes.
+    void clear(void);
+
+    /**
+     * @brief Get stored bytes as memory regions without copy. Consumer side function.
+     * @param size: Max number of bytes from front of ring buffer.
+     * @note Regions are valid until the bytes are removed by pop/discard/clear.
+     */
+    RingRegions<const char> readRegions(size_t size = SIZE_MAX) const;
+
+    /**
+     * @brief Get free space as memory regions to write directly into. Producer side function.
+     * @param size: Max number of bytes.
+     * @note Written bytes are not stored until commit() is called.
+     */
+    RingRegions<char> writeRegions(size_t size = SIZE_MAX);
+
+    /**
+     * @brief Store certain number of bytes that are written into writeRegions(). Producer side function.
+     * @return Number of bytes stored. It is limited to free space.
+     */
+    size_t commit(size_t size);
+
+    /**
+     * @brief Get stored byte by index from front of ring buffer.
+     * @note index must be less than size().
+     */
+    char at(size_t index) const;
+
+protected:
+
+    /**
+     * @brief Constructor for derived classes that keep storage and indices in external memory, for example a mapped file.
+     * Nothing is allocated and capacity is zero until _attach() is called.
+     */
+    RingBuffer(void);
+
+    /**
+     * @brief Use external storage and indices. Indices are not changed, so stored data of external memory is kept.
+     * @param capacity: Storage size. It must be a power of two.
+     */
+    void _attach(char* data, size_t capacity, RingIndices* indices);
+
+    /// @brief Stop using external storage. Capacity is zero after it.
+    void _detach(void);
+
+private:
+
+    char* _data;                        ///! @brief Cache-line aligned storage.
+    size_t _capacity;                   ///! @brief Storage size. It is a power of two.
+    size_t _mask;                       ///! @brief Index mask equal to _capacity - 1.
+    RingIndices* _indices;              ///! @brief Indices in use. It points to _localIndices or to external memory.
+    bool _owned;                        ///! @brief True if _data is allocated by constructor.
+
+    /// @brief Indices of ring buffer that allocates its own storage.
+    RingIndices _localIndices;
+
+    /// @brief Copy data to storage from certain write index.
+    void _write(uint64_t tail, const char* data, size_t size);
+
+    /// @brief Copy data from storage from certain read index.
+    void _read(uint64_t head, char* data, size_t size) const;
+
+};
@@ -0,0 +1,150 @@
+// ####################################################################################################
+// Include libraries:
+
+#include "SharedRingBuffer.h"
+#include <cerrno>                   // errno
+#include <chrono>                   // Wait deadline
+#include <climits>                  // INT_MAX
+#include <ctime>                    // timespec
+#include <fcntl.h>                  // O_* flags
+#include <unistd.h>                 // syscall
+#include <sys/mman.h>               // shm_open, shm_unlink
+#include <sys/syscall.h>            // SYS_futex
+#include <linux/futex.h>            // FUTEX_WAIT, FUTEX_WAKE
+
+// ####################################################################################################
+// Private functions:
+
+/// @brief Wait while futex word is value. Not private futex, so it works between processes.
+static void futexWait(std::atomic<uint32_t> &word, uint32_t value, const timespec* timeout)
+{
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT, value, timeout, nullptr, 0);
+}
+
+/// @brief Wake all waiters of futex word.
+static void futexWake(std::atomic<uint32_t> &word)
+{
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+}
+
+// ######################################################################################################
+// SharedRingBuffer Class:
+
+bool SharedRingBuffer::open(const std::string &name, size_t capacity)
+{
+    close();
+
+    int fd = shm_open(name.c_str(), O_RDWR | O_CREAT, 0600);
+    if(fd < 0)
+    {
+        return false;
+    }
+
+    return _mapFile(fd, capacity, false);
+}
+
+bool SharedRingBuffer::unlink(const std::string &name)
+{
+    return shm_unlink(name.c_str()) == 0;
+}
+
+void SharedRingBuffer::notifyData(void)
+{
+    if(isOpen())
+    {
+        _notify(_wake()->data);
+    }
+}
+
+void SharedRingBuffer::notifySpace(void)
+{
+    if(isOpen())
+    {
+        _notify(_wake()->space);
+    }
+}
+
+bool SharedRingBuffer::waitData(int timeout)
+{
+    if(!isOpen())
+    {
+        return false;
+    }
+
+    return _wait(_wake()->data, timeout, [this]() { return !empty(); });
+}
+
+bool SharedRingBuffer::waitSpace(size_t size, int timeout)
+{
+    if(!isOpen() || (size > capacity()))
+    {
+        return false;
+    }
+
+    return _wait(_wake()->space, timeout, [this, size]() { return freeSpace() >= size; });
+}
+
+SharedRingBuffer::WakeWords* SharedRingBuffer::_wake(void) const
+{
+    return static_cast<WakeWords*>(_headerExtra());
+}
+
+void SharedRingBuffer::_notify(Wake &wake)
+{
+    // Pairs with the fence of _wait(): either waiter sees new indices or notifier sees waiter.
+    wake.sequence.fetch_add(1, std::memory_order_release);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if(wake.waiters.load(std::memory_order_relaxed) > 0)
+    {
+        futexWake(wake.sequence);
+    }
+}
+
+template<typename Ready>
+bool SharedRingBuffer::_wait(Wake &wake, int timeout, Ready ready)
+{
+    if(ready())
+    {
+        return true;
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout);
+
+    while(true)
+    {
+        uint32_t sequence = wake.sequence.load(std::memory_order_acquire);
+        wake.waiters.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if(ready())
+        {
+            wake.waiters.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+
+        if(timeout < 0)
+        {
+            futexWait(wake.sequence, sequence, nullptr);
+        }
+        else
+        {
+            auto left = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - std::chrono::steady_clock::now()).count();
+            if(left <= 0)
+            {
+                wake.waiters.fetch_sub(1, std::memory_order_relaxed);
+                return ready();
+            }
+
+            timespec wait = {(time_t)(left / 1000000000), (long)(left % 1000000000)};
+            futexWait(wake.sequence, sequence, &wait);
+        }
+
+        wake.waiters.fetch_sub(1, std::memory_order_relaxed);
+
+        if(ready())
+        {
+            return true;
+        }
+    }
+}
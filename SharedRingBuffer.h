@@ -0,0 +1,113 @@
+#pragma once
+
+// ####################################################################################################
+// Include libraries:
+
+#include "MappedRingBuffer.h"       // Ring buffer in mapped memory
+
+// ######################################################################################################
+// SharedRingBuffer Class:
+
+/**
+ * @class SharedRingBuffer
+ * @brief Ring buffer in POSIX shared memory for a Stream channel between two processes.
+ * Producer process uses it as TX buffer of its stream and consumer process as RX buffer of its stream, so data that is
+ * pushed by pushBackTxBuffer() in one process is popped by popFrontRxBuffer() in the other one without extra copy.
+ * @note It is SPSC: one producer process and one consumer process. Streams of both processes must be in SPSC mode.
+ * @note Waiting uses futex on shared memory. notifyData()/notifySpace() make a system call only if other process waits.
+ *
+ * Example:
+ * @code
+ * // Producer process:
+ * SharedRingBuffer channel;
+ * channel.open("/sensor", 1 << 20);
+ * Stream stream(&channel, nullptr);
+ * stream.setSpscMode(true);
+ * stream.pushBackTxBuffer(data, size);
+ * channel.notifyData();
+ *
+ * // Consumer process:
+ * SharedRingBuffer channel;
+ * channel.open("/sensor");
+ * Stream stream(nullptr, &channel);
+ * stream.setSpscMode(true);
+ * while(channel.waitData(-1)) { stream.popFrontRxBuffer(...); channel.notifySpace(); }
+ * @endcode
+ */
+class SharedRingBuffer : public MappedRingBuffer
+{
+public:
+
+    /**
+     * @brief Open or create shared memory object and map it.
+     * @param name: POSIX shared memory name, for example "/sensor".
+     * @param capacity: Minimum capacity in bytes of a new object. It is rounded up to the next power of two.
+     * For an existing object it must be 0 or the same rounded capacity.
+     * @return true if succeeded. false if object can not be opened/mapped or it is not a valid ring, errno is set.
+     */
+    bool open(const std::string &name, size_t capacity = 0);
+
+    /**
+     * @brief Remove shared memory object name. Processes that have it open can still use it.
+     * @return true if succeeded. false if shm_unlink fails, errno is set.
+     */
+    static bool unlink(const std::string &name);
+
+    /// @brief Wake consumer process if it waits for data. Call it after push.
+    void notifyData(void);
+
+    /// @brief Wake producer process if it waits for space. Call it after pop.
+    void notifySpace(void);
+
+    /**
+     * @brief Wait until ring buffer is not empty.
+     * @param timeout: Max wait time in milliseconds. -1 waits without limit.
+     * @return true if ring buffer is not empty.
+     */
+    bool waitData(int timeout);
+
+    /**
+     * @brief Wait until certain number of bytes fit in free space.
+     * @param timeout: Max wait time in milliseconds. -1 waits without limit.
+     * @return true if size bytes fit.
+     */
+    bool waitSpace(size_t size, int timeout);
+
+private:
+
+    /**
+     * @struct Wake
+     * @brief Futex words of one wait condition in shared memory.
+     */
+    struct Wake
+    {
+        alignas(RING_BUFFER_CACHE_LINE_SIZE) std::atomic<uint32_t> sequence;    ///! @brief Futex word. It changes on every notify.
+        std::atomic<uint32_t> waiters;                                          ///! @brief Number of waiting processes.
+    };
+
+    /**
+     * @struct WakeWords
+     * @brief Wait conditions of ring. It is placed in free part of mapped header.
+     */
+    struct WakeWords
+    {
+        Wake data;                      ///! @brief Consumer waits for data.
+        Wake space;                     ///! @brief Producer waits for space.
+    };
+
+    static_assert(sizeof(WakeWords) <= MAPPED_RING_EXTRA_SIZE, "Wake words do not fit in mapped ring header.");
+
+    /// @brief Return wake words in shared memory.
+    WakeWords* _wake(void) const;
+
+    /// @brief Wake other process if it waits on wake.
+    static void _notify(Wake &wake);
+
+    /**
+     * @brief Wait on wake until ready() returns true or timeout.
+     * @return Last value of ready().
+     */
+    template<typename Ready>
+    static bool _wait(Wake &wake, int timeout, Ready ready);
+
+};
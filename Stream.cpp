@@ -2,6 +2,16 @@
 // Include libraries:
 
 #include "Stream.h"
+#include <array>                    // CRC-32C table
+#include <chrono>                   // Blocking overflow policy timeout
+#include <cstring>                  // std::memchr, std::memcpy
+#include <thread>                   // std::this_thread::yield
+#include <sys/socket.h>             // sendmsg, MSG_NOSIGNAL
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>              // SSE2/AVX2/SSE4.2 intrinsics
+#define STREAM_X86_SIMD
+#endif
 
 // ####################################################################################################
 
@@ -27,6 +37,255 @@ std::vector<std::string> splitString(const std::string &line, char delimiter)
     return tokens;
 }
 
+std::string_view trimStringView(std::string_view str)
+{
+    size_t start = str.find_first_not_of(' ');  // Find first non-space character
+    size_t end = str.find_last_not_of(' ');     // Find last non-space character
+    return (start == std::string_view::npos) ? std::string_view() : str.substr(start, end - start + 1);
+}
+
+size_t splitString(std::string_view line, char delimiter, std::vector<std::string_view> &tokens)
+{
+    tokens.clear();
+
+    size_t position = 0;
+    std::string_view token;
+    while(nextToken(line, delimiter, position, token))
+    {
+        tokens.push_back(token);
+    }
+
+    return tokens.size();
+}
+
+size_t splitString(std::string_view line, char delimiter, std::pmr::vector<std::pmr::string> &tokens)
+{
+    tokens.clear();
+
+    size_t position = 0;
+    std::string_view token;
+    while(nextToken(line, delimiter, position, token))
+    {
+        // Strings use the vector allocator.
+        tokens.emplace_back(token);
+    }
+
+    return tokens.size();
+}
+
+bool nextToken(std::string_view line, char delimiter, size_t &position, std::string_view &token)
+{
+    // No token after the last delimiter at the end of line. Same as getline().
+    if(position >= line.size())
+    {
+        return false;
+    }
+
+    size_t length = findCharacter(line.data() + position, line.size() - position, delimiter);
+
+    if(length == std::string::npos)
+    {
+        // Last token without delimiter at the end.
+        token = trimStringView(line.substr(position));
+        position = line.size();
+    }
+    else
+    {
+        token = trimStringView(line.substr(position, length));
+        position += length + 1;
+    }
+
+    return true;
+}
+
+#ifdef STREAM_X86_SIMD
+
+/// @brief SSE2 implementation of findCharacter(). SSE2 is always available on x86-64.
+__attribute__((target("sse2")))
+static size_t _findCharacterSse2(const char* data, size_t size, char value)
+{
+    const __m128i needle = _mm_set1_epi8(value);
+    size_t i = 0;
+
+    for(; i + 16 <= size; i += 16)
+    {
+        __m128i chunk = _mm_loadu_si128((const __m128i*)(data + i));
+        int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, needle));
+        if(mask != 0)
+        {
+            return i + __builtin_ctz(mask);
+        }
+    }
+
+    for(; i < size; i++)
+    {
+        if(data[i] == value)
+        {
+            return i;
+        }
+    }
+
+    return std::string::npos;
+}
+
+/// @brief AVX2 implementation of findCharacter().
+__attribute__((target("avx2")))
+static size_t _findCharacterAvx2(const char* data, size_t size, char value)
+{
+    const __m256i needle = _mm256_set1_epi8(value);
+    size_t i = 0;
+
+    for(; i + 32 <= size; i += 32)
+    {
+        __m256i chunk = _mm256_loadu_si256((const __m256i*)(data + i));
+        uint32_t mask = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, needle));
+        if(mask != 0)
+        {
+            return i + __builtin_ctz(mask);
+        }
+    }
+
+    // Search the remaining part with SSE2.
+    size_t pos = _findCharacterSse2(data + i, size - i, value);
+
+    return (pos == std::string::npos) ? pos : i + pos;
+}
+
+#endif
+
+/// @brief Scalar implementation of findCharacter().
+static size_t _findCharacterScalar(const char* data, size_t size, char value)
+{
+    const char* found = (const char*)std::memchr(data, value, size);
+
+    return (found != nullptr) ? (size_t)(found - data) : std::string::npos;
+}
+
+size_t findCharacter(const char* data, size_t size, char value)
+{
+#ifdef STREAM_X86_SIMD
+    // CPU features are checked once.
+    static size_t (*const implementation)(const char*, size_t, char) =
+        __builtin_cpu_supports("avx2") ? _findCharacterAvx2 :
+        __builtin_cpu_supports("sse2") ? _findCharacterSse2 : _findCharacterScalar;
+#else
+    static size_t (*const implementation)(const char*, size_t, char) = _findCharacterScalar;
+#endif
+
+    return implementation(data, size, value);
+}
+
+/// @brief Table of reflected CRC-32C polynomial 0x82F63B78 for one byte.
+static const std::array<uint32_t, 256> _crc32cTable = []()
+{
+    std::array<uint32_t, 256> table;
+
+    for(uint32_t i = 0; i < 256; i++)
+    {
+        uint32_t crc = i;
+        for(int bit = 0; bit < 8; bit++)
+        {
+            crc = (crc & 1) ? (crc >> 1) ^ 0x82F63B78 : (crc >> 1);
+        }
+        table[i] = crc;
+    }
+
+    return table;
+}();
+
+/// @brief Scalar implementation of crc32c(). crc is not inverted.
+static uint32_t _crc32cScalar(const char* data, size_t size, uint32_t crc)
+{
+    for(size_t i = 0; i < size; i++)
+    {
+        crc = _crc32cTable[(crc ^ (uint8_t)data[i]) & 0xFF] ^ (crc >> 8);
+    }
+
+    return crc;
+}
+
+#ifdef STREAM_X86_SIMD
+
+/// @brief SSE4.2 implementation of crc32c(). crc is not inverted.
+__attribute__((target("sse4.2")))
+static uint32_t _crc32cSse42(const char* data, size_t size, uint32_t crc)
+{
+    size_t i = 0;
+
+#if defined(__x86_64__)
+    uint64_t crc64 = crc;
+    for(; i + 8 <= size; i += 8)
+    {
+        uint64_t value;
+        std::memcpy(&value, data + i, sizeof(value));
+        crc64 = _mm_crc32_u64(crc64, value);
+    }
+    crc = (uint32_t)crc64;
+#endif
+
+    for(; i < size; i++)
+    {
+        crc = _mm_crc32_u8(crc, (uint8_t)data[i]);
+    }
+
+    return crc;
+}
+
+#endif
+
+uint32_t crc32c(const char* data, size_t size, uint32_t crc)
+{
+#ifdef STREAM_X86_SIMD
+    // CPU features are checked once.
+    static uint32_t (*const implementation)(const char*, size_t, uint32_t) =
+        __builtin_cpu_supports("sse4.2") ? _crc32cSse42 : _crc32cScalar;
+#else
+    static uint32_t (*const implementation)(const char*, size_t, uint32_t) = _crc32cScalar;
+#endif
+
+    return ~implementation(data, size, ~crc);
+}
+
+size_t encodeVarint(uint64_t value, char* out)
+{
+    size_t size = 0;
+
+    while(value >= 0x80)
+    {
+        out[size++] = (char)((value & 0x7F) | 0x80);
+        value >>= 7;
+    }
+    out[size++] = (char)value;
+
+    return size;
+}
+
+size_t decodeVarint(const char* data, size_t size, uint64_t &value)
+{
+    value = 0;
+    size = std::min(size, (size_t)VARINT_MAX_SIZE);
+
+    for(size_t i = 0; i < size; i++)
+    {
+        uint8_t byte = (uint8_t)data[i];
+
+        // 10th byte can only have the last bit of a 64 bit value.
+        if((i == VARINT_MAX_SIZE - 1) && (byte > 1))
+        {
+            return 0;
+        }
+
+        value |= (uint64_t)(byte & 0x7F) << (7 * i);
+
+        if((byte & 0x80) == 0)
+        {
+            return i + 1;
+        }
+    }
+
+    return 0;
+}
+
 bool isWhitespaceOnly(const std::string& line) 
 {
     return all_of(line.begin(), line.end(), ::isspace);  // Check if all characters are spaces
@@ -54,84 +313,196 @@ bool validateRow(const std::vector<std::string> &data, size_t expectedColumnCoun
     return true;
 }
 
-bool isUInt8(const std::string& str) {
-    unsigned int value;
-    std::istringstream iss(str);
-    iss >> value;
-    return !iss.fail() && iss.eof() && value <= std::numeric_limits<uint8_t>::max();
+/// @brief Skip leading whitespaces and one leading '+' sign before number.
+static std::string_view _numberBegin(std::string_view str)
+{
+    size_t start = 0;
+    while((start < str.size()) && std::isspace((unsigned char)str[start]))
+    {
+        start++;
+    }
+
+    if((start + 1 < str.size()) && (str[start] == '+') && (str[start + 1] != '-'))
+    {
+        start++;
+    }
+
+    return str.substr(start);
+}
+
+/// @brief Parse integer string with std::from_chars. Out of range values are not accepted.
+template<typename T>
+static bool _parseInteger(std::string_view str, T &value)
+{
+    str = _numberBegin(str);
+
+    T result;
+    auto [end, error] = std::from_chars(str.data(), str.data() + str.size(), result);
+
+    if((error != std::errc()) || (end != str.data() + str.size()))
+    {
+        return false;
+    }
+
+    value = result;
+    return true;
+}
+
+/// @brief Parse float/double string with std::from_chars. Infinite, NaN and out of range values are not accepted.
+template<typename T>
+static bool _parseFloating(std::string_view str, T &value)
+{
+    str = _numberBegin(str);
+
+    T result;
+    auto [end, error] = std::from_chars(str.data(), str.data() + str.size(), result);
+
+    if((error != std::errc()) || (end != str.data() + str.size()) || !std::isfinite(result))
+    {
+        return false;
+    }
+
+    value = result;
+    return true;
+}
+
+bool parseValue(std::string_view str, uint8_t &value)
+{
+    return _parseInteger(str, value);
+}
+
+bool parseValue(std::string_view str, uint16_t &value)
+{
+    return _parseInteger(str, value);
+}
+
+bool parseValue(std::string_view str, uint32_t &value)
+{
+    return _parseInteger(str, value);
+}
+
+bool parseValue(std::string_view str, uint64_t &value)
+{
+    return _parseInteger(str, value);
+}
+
+bool parseValue(std::string_view str, int8_t &value)
+{
+    return _parseInteger(str, value);
+}
+
+bool parseValue(std::string_view str, int16_t &value)
+{
+    return _parseInteger(str, value);
+}
+
+bool parseValue(std::string_view str, int32_t &value)
+{
+    return _parseInteger(str, value);
+}
+
+bool parseValue(std::string_view str, int64_t &value)
+{
+    return _parseInteger(str, value);
+}
+
+bool parseValue(std::string_view str, float &value)
+{
+    return _parseFloating(str, value);
+}
+
+bool parseValue(std::string_view str, double &value)
+{
+    return _parseFloating(str, value);
+}
+
+bool parseValue(std::string_view str, bool &value)
+{
+    // Case insensitive compare without making a lower case copy.
+    auto equals = [&str](std::string_view word)
+    {
+        return (str.size() == word.size()) && std::equal(str.begin(), str.end(), word.begin(),
+            [](char a, char b) { return std::tolower((unsigned char)a) == b; });
+    };
+
+    if(equals("true"))
+    {
+        value = true;
+        return true;
+    }
+
+    if(equals("false"))
+    {
+        value = false;
+        return true;
+    }
+
+    return false;
+}
+
+bool parseValue(std::string_view str, std::string_view &value)
+{
+    value = str;
+    return true;
+}
+
+bool isUInt8(std::string_view str) {
+    uint8_t value;
+    return parseValue(str, value);
 }
 
-bool isUInt16(const std::string& str) {
-    unsigned int value;
-    std::istringstream iss(str);
-    iss >> value;
-    return !iss.fail() && iss.eof() && value <= std::numeric_limits<uint16_t>::max();
+bool isUInt16(std::string_view str) {
+    uint16_t value;
+    return parseValue(str, value);
 }
 
-bool isUInt32(const std::string& str) {
-    unsigned long value;
-    std::istringstream iss(str);
-    iss >> value;
-    return !iss.fail() && iss.eof() && value <= std::numeric_limits<uint32_t>::max();
+bool isUInt32(std::string_view str) {
+    uint32_t value;
+    return parseValue(str, value);
 }
 
-bool isUInt64(const std::string& str) {
-    unsigned long long value;
-    std::istringstream iss(str);
-    iss >> value;
-    return !iss.fail() && iss.eof() && value <= std::numeric_limits<uint64_t>::max();
+bool isUInt64(std::string_view str) {
+    uint64_t value;
+    return parseValue(str, value);
 }
 
-bool isInt8(const std::string& str) {
-    int value;
-    std::istringstream iss(str);
-    iss >> value;
-    return !iss.fail() && iss.eof() && value >= std::numeric_limits<int8_t>::min() && value <= std::numeric_limits<int8_t>::max();
+bool isInt8(std::string_view str) {
+    int8_t value;
+    return parseValue(str, value);
 }
 
-bool isInt16(const std::string& str) {
-    int value;
-    std::istringstream iss(str);
-    iss >> value;
-    return !iss.fail() && iss.eof() && value >= std::numeric_limits<int16_t>::min() && value <= std::numeric_limits<int16_t>::max();
+bool isInt16(std::string_view str) {
+    int16_t value;
+    return parseValue(str, value);
 }
 
-bool isInt32(const std::string& str) {
-    long value;
-    std::istringstream iss(str);
-    iss >> value;
-    return !iss.fail() && iss.eof() && value >= std::numeric_limits<int32_t>::min() && value <= std::numeric_limits<int32_t>::max();
+bool isInt32(std::string_view str) {
+    int32_t value;
+    return parseValue(str, value);
 }
 
-bool isInt64(const std::string& str) {
-    long long value;
-    std::istringstream iss(str);
-    iss >> value;
-    return !iss.fail() && iss.eof() && value >= std::numeric_limits<int64_t>::min() && value <= std::numeric_limits<int64_t>::max();
+bool isInt64(std::string_view str) {
+    int64_t value;
+    return parseValue(str, value);
 }
 
-bool  isFloat(const std::string& str) {
+bool  isFloat(std::string_view str) {
     float value;
-    std::istringstream iss(str);
-    iss >> value;
-    return !iss.fail() && iss.eof() && std::isfinite(value);
+    return parseValue(str, value);
 }
 
-bool isDouble(const std::string& str) {
+bool isDouble(std::string_view str) {
     double value;
-    std::istringstream iss(str);
-    iss >> value;
-    return !iss.fail() && iss.eof() && std::isfinite(value);
+    return parseValue(str, value);
 }
 
-bool isBoolean(const std::string& str) 
+bool isBoolean(std::string_view str) 
 {
-    std::string lowerStr = str;
-    for (auto& c : lowerStr) c = std::tolower(c);
-    return (lowerStr == "true" || lowerStr == "false");
+    bool value;
+    return parseValue(str, value);
 }
 
-bool checkValuetype(const std::string data, const std::string type)
+bool checkValuetype(std::string_view data, std::string_view type)
 {
     if(type == "uint8")
     {
@@ -189,18 +560,64 @@ bool checkValuetype(const std::string data, const std::string type)
     return true;
 }
 
+ValueType getValueType(std::string_view type)
+{
+    for(uint8_t i = 0; i < (uint8_t)ValueType::NONE; i++)
+    {
+        if(type == getValueTypeName((ValueType)i))
+        {
+            return (ValueType)i;
+        }
+    }
+
+    return ValueType::NONE;
+}
+
+const char* getValueTypeName(ValueType type)
+{
+    switch(type)
+    {
+        case ValueType::UINT8:  return "uint8";
+        case ValueType::UINT16: return "uint16";
+        case ValueType::UINT32: return "uint32";
+        case ValueType::UINT64: return "uint64";
+        case ValueType::INT8:   return "int8";
+        case ValueType::INT16:  return "int16";
+        case ValueType::INT32:  return "int32";
+        case ValueType::INT64:  return "int64";
+        case ValueType::FLOAT:  return "float";
+        case ValueType::DOUBLE: return "double";
+        case ValueType::STRING: return "string";
+        case ValueType::BOOL:   return "bool";
+        default:                return "none";
+    }
+}
+
 std::string decimalToString(double value, uint8_t precision) 
 {
-    std::ostringstream oss;
-    oss << std::fixed << std::setprecision(precision) << value;
-    return oss.str();
+    char buffer[DECIMAL_STRING_MAX_SIZE];
+    return std::string(buffer, decimalToChars(value, precision, buffer, sizeof(buffer)));
 }
 
 std::string decimalToString(float value, uint8_t precision) 
 {
-    std::ostringstream oss;
-    oss << std::fixed << std::setprecision(precision) << value;
-    return oss.str();
+    char buffer[DECIMAL_STRING_MAX_SIZE];
+    return std::string(buffer, decimalToChars(value, precision, buffer, sizeof(buffer)));
+}
+
+size_t decimalToChars(double value, uint8_t precision, char* buffer, size_t size)
+{
+    // std::to_chars with fixed format is exactly rounded like std::fixed/std::setprecision of ostream.
+    auto [end, error] = std::to_chars(buffer, buffer + size, value, std::chars_format::fixed, precision);
+
+    return (error == std::errc()) ? (size_t)(end - buffer) : 0;
+}
+
+size_t decimalToChars(float value, uint8_t precision, char* buffer, size_t size)
+{
+    auto [end, error] = std::to_chars(buffer, buffer + size, value, std::chars_format::fixed, precision);
+
+    return (error == std::errc()) ? (size_t)(end - buffer) : 0;
 }
 
 bool isNumber(const std::string &str) 
@@ -278,10 +695,21 @@ bool endsWith(const std::string& str, const std::string suffix)
 
 Stream::Stream(std::deque<char>* txBuffer, uint32_t txBufferSize, std::deque<char>* rxBuffer, uint32_t rxBufferSize)
 {
+    _mpscMode = false;
+    _rxReadCount = 0;
     setTxBuffer(txBuffer, txBufferSize);
     setRxBuffer(rxBuffer, rxBufferSize);
 }
 
+Stream::Stream(RingBuffer* txBuffer, RingBuffer* rxBuffer)
+{
+    _spscMode = false;
+    _mpscMode = false;
+    _rxReadCount = 0;
+    setTxBuffer(txBuffer);
+    setRxBuffer(rxBuffer);
+}
+
 Stream::~Stream()
 {
 
@@ -291,181 +719,1107 @@ void Stream::setTxBuffer(std::deque<char>* txBuffer, uint32_t txBufferSize)
 {
     _txBufferSize = txBufferSize;
     _txBuffer = txBuffer;
+    _txRing = nullptr;
+
+    // std::deque can not be shared between threads without lock.
+    _spscMode = false;
+    setMpscMode(false);
 }
 
 void Stream::setRxBuffer(std::deque<char>* rxBuffer, uint32_t rxBufferSize)
 {
     _rxBufferSize = rxBufferSize;
     _rxBuffer = rxBuffer;
+    _rxRing = nullptr;
+
+    // std::deque can not be shared between threads without lock.
+    _spscMode = false;
 }
 
-void Stream::setTxBufferSize(const uint32_t &size)
+void Stream::setTxBuffer(RingBuffer* txBuffer)
 {
-    _txBufferSize = size;
+    _txBufferSize = (txBuffer != nullptr) ? txBuffer->capacity() : 0;
+    _txBuffer = nullptr;
+    _txRing = txBuffer;
+
+    if(txBuffer == nullptr)
+    {
+        setMpscMode(false);
+    }
 }
 
-void Stream::setRxBufferSize(const uint32_t &size)
+void Stream::setRxBuffer(RingBuffer* rxBuffer)
 {
-    _rxBufferSize = size;
+    _rxBufferSize = (rxBuffer != nullptr) ? rxBuffer->capacity() : 0;
+    _rxBuffer = nullptr;
+    _rxRing = rxBuffer;
 }
 
-void Stream::removeFrontRxBuffer(size_t num)
+bool Stream::setSpscMode(bool enable)
 {
-    for(size_t i = 0; i < num ; i++)
+    // std::deque can not be shared between threads without lock.
+    if(enable && ((_txBuffer != nullptr) || (_rxBuffer != nullptr)))
     {
-        if(_rxBuffer->empty())
-            return;
-
-        _rxBuffer->pop_front();
+        return false;
     }
+
+    _spscMode = enable;
+
+    return true;
 }
 
-void Stream::removeFrontTxBuffer(size_t size)
+bool Stream::getSpscMode(void) const
 {
-    for(size_t i = 0; i < size ; i++)
-    {
-        if(_txBuffer->empty())
-            return;
+    return _spscMode;
+}
 
-        _txBuffer->pop_front();
+bool Stream::setMpscMode(bool enable)
+{
+    // Shared reservation needs ring buffer backend.
+    if(enable && (_txRing == nullptr))
+    {
+        return false;
     }
+
+    _mpscMode = enable;
+
+#if STREAM_STATS
+    _txStats.setShared(enable);
+#endif
+
+    return true;
 }
 
-void Stream::removeAllRxBuffer(void)
+bool Stream::getMpscMode(void) const
 {
-    _rxBuffer->clear();
+    return _mpscMode;
 }
 
-void Stream::removeAllTxBuffer(void)
+void Stream::setRxOverflowPolicy(OverflowPolicy policy)
 {
-    _txBuffer->clear();
+    _rxControl.policy = policy;
 }
 
-std::string Stream::popFrontRxBuffer(size_t size)
+void Stream::setTxOverflowPolicy(OverflowPolicy policy)
 {
-    std::string data;
-
-    for(size_t i = 0; i < size ; i++)
-    {
-        if(_rxBuffer->empty())
-            return data;
-
-        data.push_back(_rxBuffer->front());
-        _rxBuffer->pop_front();
-    }
+    _txControl.policy = policy;
+}
 
-    return data;
+OverflowPolicy Stream::getRxOverflowPolicy(void) const
+{
+    return _rxControl.policy;
 }
 
-std::string Stream::popAllRxBuffer(void)
+OverflowPolicy Stream::getTxOverflowPolicy(void) const
 {
+    return _txControl.policy;
+}
+
+void Stream::setRxFrameDelimiter(char delimiter)
+{
+    _rxControl.frameDelimiter = delimiter;
+}
+
+void Stream::setTxFrameDelimiter(char delimiter)
+{
+    _txControl.frameDelimiter = delimiter;
+}
+
+void Stream::setRxBlockingTimeout(uint32_t timeout)
+{
+    _rxControl.timeout = timeout;
+}
+
+void Stream::setTxBlockingTimeout(uint32_t timeout)
+{
+    _txControl.timeout = timeout;
+}
+
+void Stream::setRxWatermarks(size_t high, size_t low, WatermarkCallback callback)
+{
+    _rxControl.highWatermark = high;
+    _rxControl.lowWatermark = low;
+    _rxControl.callback = std::move(callback);
+    _rxControl.high = false;
+}
+
+void Stream::setTxWatermarks(size_t high, size_t low, WatermarkCallback callback)
+{
+    _txControl.highWatermark = high;
+    _txControl.lowWatermark = low;
+    _txControl.callback = std::move(callback);
+    _txControl.high = false;
+}
+
+StreamStatsSnapshot Stream::getStats(void) const
+{
+    StreamStatsSnapshot stats;
+
+#if STREAM_STATS
+    stats.enabled = true;
+    _txStats.snapshot(stats.tx);
+    _rxStats.snapshot(stats.rx);
+    stats.tx.currentFill = getTxBufferLength();
+    stats.rx.currentFill = getRxBufferLength();
+#endif
+
+    return stats;
+}
+
+void Stream::resetStats(void)
+{
+#if STREAM_STATS
+    _txStats.reset();
+    _rxStats.reset();
+#endif
+}
+
+void Stream::countTxDropped(size_t size)
+{
+#if STREAM_STATS
+    _txStats.push(0, size, getTxBufferLength());
+#else
+    (void)size;
+#endif
+}
+
+void Stream::setLatencyStats(bool enable)
+{
+#if STREAM_STATS
+    _txStats.setLatency(enable);
+    _rxStats.setLatency(enable);
+#else
+    (void)enable;
+#endif
+}
+
+void Stream::setRxNotify(NotifyCallback callback)
+{
+    _rxControl.notify = std::move(callback);
+}
+
+void Stream::setTxNotify(NotifyCallback callback)
+{
+    _txControl.notify = std::move(callback);
+}
+
+size_t Stream::getRxBufferLength(void) const
+{
+    return (_rxRing != nullptr) ? _rxRing->size() : _rxBuffer->size();
+}
+
+size_t Stream::getTxBufferLength(void) const
+{
+    return (_txRing != nullptr) ? _txRing->size() : _txBuffer->size();
+}
+
+size_t Stream::getRxFreeSpace(void) const
+{
+    size_t limit = _bufferLimit(true);
+    size_t stored = getRxBufferLength();
+
+    return (stored < limit) ? limit - stored : 0;
+}
+
+size_t Stream::getTxFreeSpace(void) const
+{
+    size_t limit = _bufferLimit(false);
+    size_t stored = getTxBufferLength();
+
+    return (stored < limit) ? limit - stored : 0;
+}
+
+uint64_t Stream::getRxReadCount(void) const
+{
+    return _rxReadCount.load(std::memory_order_acquire);
+}
+
+size_t Stream::findRx(char value, size_t offset) const
+{
+    return _find(true, value, offset);
+}
+
+size_t Stream::peekFrontRxBuffer(char* data, size_t size, size_t offset) const
+{
+    if(_rxRing != nullptr)
+    {
+        return _rxRing->peek(data, size, offset);
+    }
+
+    if(offset >= _rxBuffer->size())
+    {
+        return 0;
+    }
+
+    size = std::min(size, _rxBuffer->size() - offset);
+    std::copy(_rxBuffer->begin() + offset, _rxBuffer->begin() + offset + size, data);
+
+    return size;
+}
+
+void Stream::setTxBufferSize(const uint32_t &size)
+{
+    _txBufferSize = size;
+}
+
+void Stream::setRxBufferSize(const uint32_t &size)
+{
+    _rxBufferSize = size;
+}
+
+void Stream::removeFrontRxBuffer(size_t num)
+{
+    _afterPop(true, _removeFront(true, num));
+}
+
+void Stream::removeFrontTxBuffer(size_t size)
+{
+    _afterPop(false, _removeFront(false, size));
+}
+
+void Stream::removeAllRxBuffer(void)
+{
+    _afterPop(true, _removeFront(true, SIZE_MAX));
+}
+
+void Stream::removeAllTxBuffer(void)
+{
+    _afterPop(false, _removeFront(false, SIZE_MAX));
+}
+
+std::string Stream::popFrontRxBuffer(size_t size)
+{
+    if(_rxRing != nullptr)
+    {
+        std::string data(std::min(size, _rxRing->size()), '\0');
+        _rxReadCount.fetch_add(_rxRing->pop(data.data(), data.size()), std::memory_order_release);
+        _afterPop(true, data.size());
+        return data;
+    }
+
+    // Construct string from the whole range with one allocation and then erase the range.
+    size = std::min(size, _rxBuffer->size());
+    std::string data(_rxBuffer->begin(), _rxBuffer->begin() + size);
+    _rxBuffer->erase(_rxBuffer->begin(), _rxBuffer->begin() + size);
+    _rxReadCount.fetch_add(size, std::memory_order_release);
+    _afterPop(true, size);
+
+    return data;
+}
+
+std::string Stream::popAllRxBuffer(void)
+{
+    if(_rxRing != nullptr)
+    {
+        std::string data(_rxRing->size(), '\0');
+        _rxReadCount.fetch_add(_rxRing->pop(data.data(), data.size()), std::memory_order_release);
+        _afterPop(true, data.size());
+        return data;
+    }
+
     std::string data(_rxBuffer->begin(), _rxBuffer->end());
     _rxBuffer->clear();
+    _rxReadCount.fetch_add(data.size(), std::memory_order_release);
+    _afterPop(true, data.size());
 
     return data;
 }
 
-void Stream::pushBackRxBuffer(const char* data, size_t size)
+PooledBuffer Stream::popFrontRxBuffer(size_t size, BufferPool &pool)
+{
+    // Length only grows while consumer pops, so all of it can be popped.
+    PooledBuffer data = pool.acquire(std::min(size, getRxBufferLength()));
+
+    if(!data.empty())
+    {
+        tryPopFrontRxBuffer(data.data(), data.size());
+    }
+
+    return data;
+}
+
+PooledBuffer Stream::popAllRxBuffer(BufferPool &pool)
+{
+    return popFrontRxBuffer(SIZE_MAX, pool);
+}
+
+size_t Stream::pushBackRxBuffer(const char* data, size_t size)
+{
+    size_t requested = size;
+    size_t skip = _makeSpace(true, size);
+
+    if(_rxRing != nullptr)
+    {
+        _rxRing->push(data + skip, size);
+    }
+    else
+    {
+        // Append the char array to the deque
+        _rxBuffer->insert(_rxBuffer->end(), data + skip, data + skip + size);
+    }
+
+    _afterPush(true, requested, size);
+
+    return size;
+}
+
+size_t Stream::pushBackRxBuffer(const std::string* data)
+{
+    return pushBackRxBuffer(data->c_str(), data->size());
+}
+
+size_t Stream::pushBackTxBuffer(const char* data, size_t size)
+{
+    if(_mpscMode)
+    {
+        std::string_view record(data, size);
+        return _pushShared(&record, 1);
+    }
+
+    size_t requested = size;
+    size_t skip = _makeSpace(false, size);
+
+    if(_txRing != nullptr)
+    {
+        _txRing->push(data + skip, size);
+    }
+    else
+    {
+        // Append the char array to the deque
+        _txBuffer->insert(_txBuffer->end(), data + skip, data + skip + size);
+    }
+
+    _afterPush(false, requested, size);
+
+    return size;
+}
+
+size_t Stream::pushBackTxBuffer(const std::string* data)
+{
+    return pushBackTxBuffer(data->c_str(), data->size());
+}
+
+size_t Stream::pushBackTxBuffer(const std::string& data)
+{
+    return pushBackTxBuffer(data.c_str(), data.size());
+}
+
+size_t Stream::pushBackTxDecimal(double value, uint8_t precision)
+{
+    char buffer[DECIMAL_STRING_MAX_SIZE];
+    return pushBackTxBuffer(buffer, decimalToChars(value, precision, buffer, sizeof(buffer)));
+}
+
+size_t Stream::pushBackTxDecimal(float value, uint8_t precision)
+{
+    char buffer[DECIMAL_STRING_MAX_SIZE];
+    return pushBackTxBuffer(buffer, decimalToChars(value, precision, buffer, sizeof(buffer)));
+}
+
+bool Stream::tryPushBackRxBuffer(const char* data, size_t size)
+{
+    if(_rxRing != nullptr)
+    {
+        if(!_tryPushRing(_rxRing, _rxBufferSize, data, size))
+        {
+            return false;
+        }
+    }
+    else
+    {
+        if(_rxBuffer->size() + size > _rxBufferSize)
+        {
+            return false;
+        }
+
+        _rxBuffer->insert(_rxBuffer->end(), data, data + size);
+    }
+
+    _afterPush(true, size, size);
+
+    return true;
+}
+
+bool Stream::tryPushBackTxBuffer(const char* data, size_t size)
+{
+    if(_mpscMode)
+    {
+        if(!_txRing->tryPushShared(data, size))
+        {
+            return false;
+        }
+    }
+    else if(_txRing != nullptr)
+    {
+        if(!_tryPushRing(_txRing, _txBufferSize, data, size))
+        {
+            return false;
+        }
+    }
+    else
+    {
+        if(_txBuffer->size() + size > _txBufferSize)
+        {
+            return false;
+        }
+
+        _txBuffer->insert(_txBuffer->end(), data, data + size);
+    }
+
+    _afterPush(false, size, size);
+
+    return true;
+}
+
+bool Stream::tryPushBackTxBatch(std::span<const std::string_view> records)
+{
+    size_t size = 0;
+    for(const auto &record : records)
+    {
+        size += record.size();
+    }
+
+    if(_mpscMode)
+    {
+        if(!_txRing->tryPushShared(records.data(), records.size()))
+        {
+            return false;
+        }
+    }
+    else
+    {
+        if(getTxBufferLength() + size > _bufferLimit(false))
+        {
+            return false;
+        }
+
+        if(_txRing != nullptr)
+        {
+            // Copy all records into free space first and publish them with one commit, so a consumer thread in
+            // SPSC mode never sees part of the batch.
+            RingRegions<char> regions = _txRing->writeRegions(size);
+            size_t offset = 0;
+
+            for(const auto &record : records)
+            {
+                RingRegions<char> target = regions.subRegions(offset, record.size());
+                std::copy(record.begin(), record.begin() + target.first.size(), target.first.begin());
+                std::copy(record.begin() + target.first.size(), record.end(), target.second.begin());
+                offset += record.size();
+            }
+
+            _txRing->commit(size);
+        }
+        else
+        {
+            for(const auto &record : records)
+            {
+                _txBuffer->insert(_txBuffer->end(), record.begin(), record.end());
+            }
+        }
+    }
+
+    _afterPush(false, size, size);
+
+    return true;
+}
+
+bool Stream::tryPopFrontRxBuffer(char* data, size_t size)
 {
-    // empty space size of rx buffer that needed for new data. Hint:It can be negative value.
-    int64_t emptySize;
+    if(_rxRing != nullptr)
+    {
+        if(!_rxRing->tryPop(data, size))
+        {
+            return false;
+        }
+    }
+    else
+    {
+        if(_rxBuffer->size() < size)
+        {
+            return false;
+        }
 
-    emptySize = (int64_t)(_rxBuffer->size() + size) - (int64_t)_rxBufferSize;
+        std::copy(_rxBuffer->begin(), _rxBuffer->begin() + size, data);
+        _rxBuffer->erase(_rxBuffer->begin(), _rxBuffer->begin() + size);
+    }
+
+    _rxReadCount.fetch_add(size, std::memory_order_release);
+    _afterPop(true, size);
 
-    if(emptySize > 0)
+    return true;
+}
+
+bool Stream::tryPopFrontTxBuffer(char* data, size_t size)
+{
+    if(_txRing != nullptr)
+    {
+        if(!_txRing->tryPop(data, size))
+        {
+            return false;
+        }
+    }
+    else
     {
-        removeFrontRxBuffer(emptySize);
+        if(_txBuffer->size() < size)
+        {
+            return false;
+        }
+
+        std::copy(_txBuffer->begin(), _txBuffer->begin() + size, data);
+        _txBuffer->erase(_txBuffer->begin(), _txBuffer->begin() + size);
     }
 
-    // Append the char array to the deque
-    _rxBuffer->insert(_rxBuffer->end(), data, data + size);
+    _afterPop(false, size);
+
+    return true;
 }
 
-void Stream::pushBackRxBuffer(const std::string* data)
+size_t Stream::receiveData(const char &data, size_t size)
 {
-    pushBackRxBuffer(data->c_str(), data->size());
+    // data is the first character of a char array with length of size.
+    return pushBackRxBuffer(&data, size);
 }
 
-void Stream::pushBackTxBuffer(const char* data, size_t size)
+size_t Stream::receiveData(const std::string &data)
 {
-    // empty space size of tx buffer that needed for new data. Hint:It can be negative value.
-    int64_t emptySize;
+    return pushBackRxBuffer(data.c_str(), data.size());
+}
 
-    emptySize = (int64_t)(_txBuffer->size() + size) - (int64_t)_txBufferSize;
+size_t Stream::receiveData(const std::deque<char> &data)
+{
+    size_t size = data.size();
+    size_t skip = _makeSpace(true, size);
+    auto it = data.begin() + skip;
+    auto end = it + size;
 
-    if(emptySize > 0)
+    if(_rxRing != nullptr)
+    {
+        // Copy deque segments to ring buffer through a small stack buffer.
+        char chunk[256];
+        while(it != end)
+        {
+            size_t count = std::min(sizeof(chunk), (size_t)(end - it));
+            std::copy(it, it + count, chunk);
+            _rxRing->push(chunk, count);
+            it += count;
+        }
+    }
+    else
     {
-        removeFrontTxBuffer(emptySize);
+        // Append the deque to the deque
+        _rxBuffer->insert(_rxBuffer->end(), it, end);
     }
 
-    // Append the char array to the deque
-    _txBuffer->insert(_txBuffer->end(), data, data + size);
+    _afterPush(true, data.size(), size);
+
+    return size;
+}
+
+RingRegions<const char> Stream::peekRx(void) const
+{
+    if(_rxRing == nullptr)
+    {
+        return {};
+    }
 
+    return _rxRing->readRegions();
 }
 
-void Stream::pushBackTxBuffer(const std::string* data)
+void Stream::consumeRx(size_t size)
 {
-    pushBackTxBuffer(data->c_str(), data->size());
+    removeFrontRxBuffer(size);
 }
 
-void Stream::pushBackTxBuffer(const std::string& data)
+std::span<char> Stream::prepareRx(size_t size)
 {
-    pushBackTxBuffer(data.c_str(), data.size());
+    if(_rxRing == nullptr)
+    {
+        return {};
+    }
+
+    return _prepareRing(_rxRing, _rxBufferSize, size).first;
 }
 
-void Stream::receiveData(const char &data, size_t size)
+RingRegions<char> Stream::prepareRxRegions(size_t size)
 {
-    // empty space size of rx buffer.
-    int64_t emptySize;
+    if(_rxRing == nullptr)
+    {
+        return {};
+    }
 
-    emptySize = (int64_t)(_rxBuffer->size() + size) - (int64_t)_rxBufferSize;
+    return _prepareRing(_rxRing, _rxBufferSize, size);
+}
 
-    if(emptySize > 0)
+void Stream::commitRx(size_t size)
+{
+    if(_rxRing != nullptr)
     {
-        removeFrontRxBuffer(emptySize);
+        _rxRing->commit(size);
+        _afterPush(true, size, size);
     }
+}
 
-    for(size_t i=0; i < size; i++)
+RingRegions<const char> Stream::peekTx(void) const
+{
+    if(_txRing == nullptr)
     {
-        _rxBuffer->push_back(data+i); 
+        return {};
     }
+
+    return _txRing->readRegions();
+}
+
+void Stream::consumeTx(size_t size)
+{
+    removeFrontTxBuffer(size);
 }
 
-void Stream::receiveData(const std::string &data)
+std::span<char> Stream::prepareTx(size_t size)
 {
-    // empty space size of rx buffer.
-    int64_t emptySize;
+    // Direct write can not be shared between producers.
+    if((_txRing == nullptr) || _mpscMode)
+    {
+        return {};
+    }
 
-    emptySize = (int64_t)(_rxBuffer->size() + data.size()) - (int64_t)_rxBufferSize;
+    return _prepareRing(_txRing, _txBufferSize, size).first;
+}
 
-    if(emptySize > 0)
+void Stream::commitTx(size_t size)
+{
+    if((_txRing != nullptr) && !_mpscMode)
     {
-        removeFrontRxBuffer(emptySize);
+        _txRing->commit(size);
+        _afterPush(false, size, size);
     }
+}
+
+ssize_t Stream::flushTx(int fd)
+{
+    return _flushTx(fd, false);
+}
+
+ssize_t Stream::sendTx(int socket)
+{
+    return _flushTx(socket, true);
+}
+
+ssize_t Stream::_flushTx(int fd, bool socket)
+{
+    size_t total = 0;
 
-    for(size_t i=0; i < data.size(); i++)
+    while(true)
     {
-        _rxBuffer->push_back(data[i]); 
+        ssize_t written;
+
+        if(_txRing != nullptr)
+        {
+            RingRegions<const char> regions = _txRing->readRegions();
+
+            if(regions.empty())
+            {
+                break;
+            }
+
+            iovec iov[2];
+            iov[0].iov_base = (void*)regions.first.data();
+            iov[0].iov_len = regions.first.size();
+            iov[1].iov_base = (void*)regions.second.data();
+            iov[1].iov_len = regions.second.size();
+
+            if(socket)
+            {
+                // MSG_NOSIGNAL reports closed peer as EPIPE instead of raising SIGPIPE.
+                msghdr message = {};
+                message.msg_iov = iov;
+                message.msg_iovlen = regions.second.empty() ? 1 : 2;
+                written = sendmsg(fd, &message, MSG_NOSIGNAL);
+            }
+            else
+            {
+                written = writev(fd, iov, regions.second.empty() ? 1 : 2);
+            }
+        }
+        else
+        {
+            if(_txBuffer->empty())
+            {
+                break;
+            }
+
+            // Deque is not contiguous. Copy a chunk of it to stack buffer.
+            char chunk[4096];
+            size_t size = std::min(sizeof(chunk), _txBuffer->size());
+            std::copy(_txBuffer->begin(), _txBuffer->begin() + size, chunk);
+
+            written = socket ? send(fd, chunk, size, MSG_NOSIGNAL) : write(fd, chunk, size);
+        }
+
+        if(written < 0)
+        {
+            if(errno == EINTR)
+            {
+                continue;
+            }
+
+            if((errno == EAGAIN) || (errno == EWOULDBLOCK))
+            {
+                break;
+            }
+
+            return (total > 0) ? (ssize_t)total : -1;
+        }
+
+        // Remove exactly the written characters. It handles partial write.
+        removeFrontTxBuffer(written);
+        total += written;
     }
+
+    return total;
 }
 
-void Stream::receiveData(const std::deque<char> &data)
+ssize_t Stream::fillRx(int fd)
 {
-    // empty space size of rx buffer.
-    int64_t emptySize;
+    ssize_t received;
+
+    if(_rxRing != nullptr)
+    {
+        RingRegions<char> regions = _prepareRing(_rxRing, _rxBufferSize, SIZE_MAX);
+
+        if(regions.empty())
+        {
+            errno = ENOBUFS;
+            return -1;
+        }
+
+        iovec iov[2];
+        iov[0].iov_base = regions.first.data();
+        iov[0].iov_len = regions.first.size();
+        iov[1].iov_base = regions.second.data();
+        iov[1].iov_len = regions.second.size();
 
-    emptySize = (int64_t)(_rxBuffer->size() + data.size()) - (int64_t)_rxBufferSize;
+        do
+        {
+            received = readv(fd, iov, regions.second.empty() ? 1 : 2);
+        } while((received < 0) && (errno == EINTR));
+
+        if(received > 0)
+        {
+            _rxRing->commit(received);
+            _afterPush(true, received, received);
+        }
 
-    if(emptySize > 0)
+        return received;
+    }
+
+    if(_rxBuffer->size() >= _rxBufferSize)
     {
-        removeFrontRxBuffer(emptySize);
+        errno = ENOBUFS;
+        return -1;
     }
 
-    for(size_t i=0; i < data.size(); i++)
+    // Deque is not contiguous. Read to stack buffer and append it.
+    char chunk[4096];
+    size_t size = std::min(sizeof(chunk), _rxBufferSize - _rxBuffer->size());
+
+    do
     {
-        _rxBuffer->push_back(data[i]); 
+        received = read(fd, chunk, size);
+    } while((received < 0) && (errno == EINTR));
+
+    if(received > 0)
+    {
+        _rxBuffer->insert(_rxBuffer->end(), chunk, chunk + received);
+        _afterPush(true, received, received);
     }
+
+    return received;
+}
+
+size_t Stream::_bufferLimit(bool rx) const
+{
+    const RingBuffer* ring = rx ? _rxRing : _txRing;
+    size_t bufferSize = rx ? _rxBufferSize : _txBufferSize;
+
+    return (ring != nullptr) ? std::min(bufferSize, ring->capacity()) : bufferSize;
 }
 
+size_t Stream::_removeFront(bool rx, size_t size)
+{
+    RingBuffer* ring = rx ? _rxRing : _txRing;
+    size_t removed;
+
+    if(ring != nullptr)
+    {
+        removed = ring->discard(size);
+    }
+    else
+    {
+        // Erase the whole range at once. Deque releases its front blocks without per byte work.
+        std::deque<char>* buffer = rx ? _rxBuffer : _txBuffer;
+        removed = std::min(size, buffer->size());
+        buffer->erase(buffer->begin(), buffer->begin() + removed);
+    }
+
+    if(rx)
+    {
+        _rxReadCount.fetch_add(removed, std::memory_order_release);
+    }
+
+    return removed;
+}
+
+size_t Stream::_find(bool rx, char value, size_t offset) const
+{
+    const RingBuffer* ring = rx ? _rxRing : _txRing;
+
+    if(ring != nullptr)
+    {
+        RingRegions<const char> regions = ring->readRegions();
+
+        // Search first region and then second region.
+        if(offset < regions.first.size())
+        {
+            size_t pos = findCharacter(regions.first.data() + offset, regions.first.size() - offset, value);
+            if(pos != std::string::npos)
+            {
+                return offset + pos;
+            }
+            offset = regions.first.size();
+        }
+
+        if(offset < regions.size())
+        {
+            size_t index = offset - regions.first.size();
+            size_t pos = findCharacter(regions.second.data() + index, regions.second.size() - index, value);
+            if(pos != std::string::npos)
+            {
+                return regions.first.size() + index + pos;
+            }
+        }
+
+        return std::string::npos;
+    }
+
+    const std::deque<char>* buffer = rx ? _rxBuffer : _txBuffer;
+
+    if(offset >= buffer->size())
+    {
+        return std::string::npos;
+    }
+
+    auto found = std::find(buffer->begin() + offset, buffer->end(), value);
+
+    return (found != buffer->end()) ? (size_t)(found - buffer->begin()) : std::string::npos;
+}
+
+size_t Stream::_makeSpace(bool rx, size_t &size)
+{
+    BufferControl &control = rx ? _rxControl : _txControl;
+    size_t limit = _bufferLimit(rx);
+    size_t stored = rx ? getRxBufferLength() : getTxBufferLength();
+    size_t freeSpace = (stored < limit) ? limit - stored : 0;
+
+    if(size <= freeSpace)
+    {
+        return 0;
+    }
+
+    OverflowPolicy policy = control.policy;
+
+    // In SPSC mode only the consumer may remove data.
+    if(_spscMode && ((policy == OverflowPolicy::DROP_OLDEST) || (policy == OverflowPolicy::DROP_OLDEST_FRAME)))
+    {
+        policy = OverflowPolicy::REJECT_PARTIAL;
+    }
+
+    switch(policy)
+    {
+        case OverflowPolicy::DROP_OLDEST:
+        {
+            if(size >= limit)
+            {
+                // New data is larger than buffer. Only the last part of it can be stored.
+                _statsEvict(rx, _removeFront(rx, SIZE_MAX));
+                size_t skip = size - limit;
+                size = limit;
+                return skip;
+            }
+
+            // Remove oldest data if there is not enough space.
+            _statsEvict(rx, _removeFront(rx, stored + size - limit));
+            return 0;
+        }
+
+        case OverflowPolicy::DROP_NEWEST:
+        {
+            size = 0;
+            return 0;
+        }
+
+        case OverflowPolicy::REJECT_PARTIAL:
+        {
+            size = freeSpace;
+            return 0;
+        }
+
+        case OverflowPolicy::DROP_OLDEST_FRAME:
+        {
+            // Remove up to the first frame end that makes enough space, so no frame is cut.
+            size_t position = (size <= limit) ? _find(rx, control.frameDelimiter, stored + size - limit - 1) : std::string::npos;
+
+            if(position == std::string::npos)
+            {
+                size = 0;
+                return 0;
+            }
+
+            _statsEvict(rx, _removeFront(rx, position + 1));
+            return 0;
+        }
+
+        case OverflowPolicy::BLOCK:
+        {
+            if(_spscMode)
+            {
+                // Wait for consumer thread until all of data (or a full buffer for larger data) fits.
+                size_t needed = std::min(size, limit);
+                auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(control.timeout);
+
+                while((freeSpace < needed) && (std::chrono::steady_clock::now() < deadline))
+                {
+                    std::this_thread::yield();
+                    stored = rx ? getRxBufferLength() : getTxBufferLength();
+                    freeSpace = (stored < limit) ? limit - stored : 0;
+                }
+            }
+
+            size = std::min(size, freeSpace);
+            return 0;
+        }
+    }
+
+    return 0;
+}
+
+void Stream::_checkWatermark(bool rx)
+{
+    BufferControl &control = rx ? _rxControl : _txControl;
+
+    if(!control.callback)
+    {
+        return;
+    }
+
+    size_t length = rx ? getRxBufferLength() : getTxBufferLength();
+
+    // exchange() calls callback once for each crossing, also when producer and consumer threads both check it.
+    if(length >= control.highWatermark)
+    {
+        if(!control.high.exchange(true))
+        {
+            control.callback(true);
+        }
+    }
+    else if(length <= control.lowWatermark)
+    {
+        if(control.high.exchange(false))
+        {
+            control.callback(false);
+        }
+    }
+}
+
+void Stream::_afterPush(bool rx, size_t requested, size_t stored)
+{
+#if STREAM_STATS
+    (rx ? _rxStats : _txStats).push(stored, requested - stored, rx ? getRxBufferLength() : getTxBufferLength());
+#else
+    (void)requested;
+    (void)stored;
+#endif
+
+    _checkWatermark(rx);
+
+    if(rx && (stored > 0) && _rxControl.notify)
+    {
+        _rxControl.notify();
+    }
+}
+
+void Stream::_afterPop(bool rx, size_t size)
+{
+#if STREAM_STATS
+    (rx ? _rxStats : _txStats).pop(size);
+#else
+    (void)size;
+#endif
+
+    _checkWatermark(rx);
+
+    if(!rx && (size > 0) && _txControl.notify)
+    {
+        _txControl.notify();
+    }
+}
+
+void Stream::_statsEvict(bool rx, size_t size)
+{
+#if STREAM_STATS
+    (rx ? _rxStats : _txStats).evict(size);
+#else
+    (void)rx;
+    (void)size;
+#endif
+}
+
+size_t Stream::_pushShared(const std::string_view* records, size_t count)
+{
+    size_t size = 0;
+    for(size_t i = 0; i < count; i++)
+    {
+        size += records[i].size();
+    }
+
+    bool stored = _txRing->tryPushShared(records, count);
+
+    if(!stored && (_txControl.policy == OverflowPolicy::BLOCK) && (size <= _txRing->capacity()))
+    {
+        // Wait for consumer thread to make space for the whole record.
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(_txControl.timeout);
+
+        while(!stored && (std::chrono::steady_clock::now() < deadline))
+        {
+            std::this_thread::yield();
+            stored = _txRing->tryPushShared(records, count);
+        }
+    }
+
+    size_t result = stored ? size : 0;
+    _afterPush(false, size, result);
+
+    return result;
+}
+
+bool Stream::_tryPushRing(RingBuffer* ring, size_t bufferSize, const char* data, size_t size)
+{
+    size_t limit = std::min(bufferSize, ring->capacity());
+
+    if(ring->size() + size > limit)
+    {
+        return false;
+    }
+
+    return ring->tryPush(data, size);
+}
+
+RingRegions<char> Stream::_prepareRing(RingBuffer* ring, size_t bufferSize, size_t size)
+{
+    size_t limit = std::min(bufferSize, ring->capacity());
+    size_t stored = ring->size();
 
+    size = (stored < limit) ? std::min(size, limit - stored) : 0;
 
+    return ring->writeRegions(size);
+}
\ No newline at end of file
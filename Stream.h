@@ -5,6 +5,7 @@
 
 #include <iostream>                 // Input and output stream library
 #include <string>                   // String class and related functions
+#include <string_view>              // Non-owning string views
 #include <vector>                   // Dynamic array container
 #include <sstream>                  // String stream for input/output operations on strings
 #include <cctype>                   // Character classification and conversion functions
@@ -13,6 +14,59 @@
 #include <iomanip>                  // Manipulators for formatted I/O, like std::setprecision
 #include <algorithm>                // Algorithms for operations like std::remove_if, std::all_of
 #include <deque>                    // Double-ended queue container
+#include <charconv>                 // Locale independent number conversion: std::from_chars, std::to_chars
+#include <cerrno>                   // errno values like EAGAIN
+#include <sys/uio.h>                // Scatter/gather I/O: readv, writev
+#include <unistd.h>                 // POSIX read, write
+#include <atomic>                   // Atomic watermark state and RX read count
+#include <functional>               // Watermark callbacks
+#include <memory_resource>          // std::pmr containers
+#include "RingBuffer.h"             // Fixed capacity byte ring buffer
+#include "StreamStats.h"            // Statistics counters
+#include "BufferPool.h"             // Pooled buffers of pop functions
+
+// ####################################################################################################
+// Public macros:
+
+/// @brief Buffer size that is enough for any double/float value formatted by decimalToChars() with any precision.
+#define DECIMAL_STRING_MAX_SIZE             640
+
+// ####################################################################################################
+// Public enums:
+
+/**
+ * @enum ValueType
+ * @brief Value types that checkValuetype() understands.
+ */
+enum class ValueType : uint8_t
+{
+    UINT8,
+    UINT16,
+    UINT32,
+    UINT64,
+    INT8,
+    INT16,
+    INT32,
+    INT64,
+    FLOAT,
+    DOUBLE,
+    STRING,
+    BOOL,
+    NONE                            ///< Unknown type.
+};
+
+/**
+ * @enum OverflowPolicy
+ * @brief What pushBack... and receiveData functions do when new data does not fit in a buffer.
+ */
+enum class OverflowPolicy : uint8_t
+{
+    DROP_OLDEST,                    ///< Remove oldest characters to make space. If new data is larger than buffer only its last part is stored.
+    DROP_NEWEST,                    ///< Keep old data and drop all of new data.
+    REJECT_PARTIAL,                 ///< Keep old data and store the first part of new data that fits. Push returns stored count.
+    DROP_OLDEST_FRAME,              ///< Remove whole oldest frames that end with frame delimiter. If that is not possible, drop all of new data.
+    BLOCK                           ///< Wait up to blocking timeout for consumer thread to make space, then store the first part that fits.
+};
 
 // ####################################################################################################
 
@@ -30,6 +84,75 @@ std::string trimString(const std::string &str);
  *  */ 
 std::vector<std::string> splitString(const std::string &line, char delimiter);
 
+/**
+ * @ingroup public_general_functions
+ * @brief Function to trim leading and trailing spaces from a string view without allocation.
+ * @return Trimed string view. It points to memory of str.
+ *  */ 
+std::string_view trimStringView(std::string_view str);
+
+/**
+ * @ingroup public_general_functions
+ * @brief Function to split a string by a delimiter to trimmed string views without allocation.
+ * Tokens are the same as splitString(const std::string&, char) tokens.
+ * @param tokens: Output vector. It is cleared and its memory is reused. Views point to memory of line.
+ * @return Number of tokens.
+ *  */ 
+size_t splitString(std::string_view line, char delimiter, std::vector<std::string_view> &tokens);
+
+/**
+ * @ingroup public_general_functions
+ * @brief Function to split a string by a delimiter to trimmed strings that use memory resource of tokens vector.
+ * Tokens are the same as splitString(const std::string&, char) tokens.
+ * @param tokens: Output vector. It is cleared. With a BufferPool resource steady state use does not allocate from heap.
+ * @return Number of tokens.
+ *  */ 
+size_t splitString(std::string_view line, char delimiter, std::pmr::vector<std::pmr::string> &tokens);
+
+/**
+ * @ingroup public_general_functions
+ * @brief Get next trimmed token of a line from certain position. Tokens are the same as splitString() tokens.
+ * @param position: Start position of token. It is moved to start position of next token.
+ * @param token: Trimmed token. It points to memory of line.
+ * @return true if a token exists. false if position is at the end of line.
+ *  */ 
+bool nextToken(std::string_view line, char delimiter, size_t &position, std::string_view &token);
+
+/**
+ * @ingroup public_general_functions
+ * @brief Find first position of a character in char array.
+ * It uses AVX2 or SSE2 instructions if CPU supports them (selected at runtime) and scalar search otherwise.
+ * @return Position of character. std::string::npos if it is not found.
+ *  */ 
+size_t findCharacter(const char* data, size_t size, char value);
+
+/**
+ * @ingroup public_general_functions
+ * @brief Calculate CRC-32C (Castagnoli) of char array.
+ * It uses SSE4.2 crc32 instruction if CPU supports it (selected at runtime) and table lookup otherwise.
+ * @param crc: CRC of previous data to continue calculation. 0 for new data.
+ * @return CRC-32C value. It is 0xE3069283 for "123456789".
+ *  */ 
+uint32_t crc32c(const char* data, size_t size, uint32_t crc = 0);
+
+/// @brief Max size of a varint encoded uint64_t value in bytes.
+#define VARINT_MAX_SIZE                     10
+
+/**
+ * @ingroup public_general_functions
+ * @brief Encode unsigned value as LEB128 varint. 7 bits per byte, low bits first.
+ * @param out: Output buffer with at least VARINT_MAX_SIZE bytes.
+ * @return Number of bytes written.
+ *  */ 
+size_t encodeVarint(uint64_t value, char* out);
+
+/**
+ * @ingroup public_general_functions
+ * @brief Decode LEB128 varint from front of char array.
+ * @return Number of bytes used. 0 if data is incomplete or it is not a valid varint.
+ *  */ 
+size_t decodeVarint(const char* data, size_t size, uint64_t &value);
+
 /**
  * @ingroup public_general_functions
  * @brief Function to check if a string is empty or contains only spaces
@@ -50,85 +173,133 @@ bool validateRow(const std::vector<std::string> &data, size_t expectedColumnCoun
  * @param type can be: {uint8, uint16, uint32, uint64, int8, int16, int32, int64, float, double, string, bool}
  * @return true if succeeded.
  *  */ 
-bool checkValuetype(const std::string data, const std::string type);
+bool checkValuetype(std::string_view data, std::string_view type);
+
+/**
+ * @ingroup public_general_functions
+ * @brief Get value type from its name.
+ * @param type can be: {uint8, uint16, uint32, uint64, int8, int16, int32, int64, float, double, string, bool}
+ * @return Value type. ValueType::NONE if name is not known.
+ *  */ 
+ValueType getValueType(std::string_view type);
+
+/**
+ * @ingroup public_general_functions
+ * @brief Get name of value type. It is one of the names that checkValuetype() understands or "none".
+ *  */ 
+const char* getValueTypeName(ValueType type);
 
 /**
  * @ingroup public_general_functions
  * @brief Check string format for bool.
- * @param str can be: {true, false, TRUE, FALSE}
+ * @param str can be: {true, false, TRUE, FALSE} in any letter case.
  * @return true if succeeded. 
  *  */ 
-bool isBoolean(const std::string& str);
+bool isBoolean(std::string_view str);
 
 /**
  * @ingroup public_general_functions
  * @brief Check string format for double.
  * @return true if succeeded. 
  *  */ 
-bool isDouble(const std::string& str);
+bool isDouble(std::string_view str);
 
 /**
  * @ingroup public_general_functions
  * @brief Check string format for float.
  * @return true if succeeded. 
  *  */ 
-bool isFloat(const std::string& str);
+bool isFloat(std::string_view str);
 
 /**
  * @ingroup public_general_functions
  * @brief Check string format for int64.
  * @return true if succeeded. 
  *  */ 
-bool isInt64(const std::string& str);
+bool isInt64(std::string_view str);
 
 /**
  * @ingroup public_general_functions
  * @brief Check string format for int32.
  * @return true if succeeded. 
  *  */ 
-bool isInt32(const std::string& str);
+bool isInt32(std::string_view str);
 
 /**
  * @ingroup public_general_functions
  * @brief Check string format for int16.
  * @return true if succeeded. 
  *  */ 
-bool isInt16(const std::string& str);
+bool isInt16(std::string_view str);
 
 /**
  * @ingroup public_general_functions
  * @brief Check string format for int8.
  * @return true if succeeded. 
  *  */ 
-bool isInt8(const std::string& str);
+bool isInt8(std::string_view str);
 
 /**
  * @ingroup public_general_functions
  * @brief Check string format for uint64.
  * @return true if succeeded. 
  *  */ 
-bool isUInt64(const std::string& str);
+bool isUInt64(std::string_view str);
 
 /**
  * @ingroup public_general_functions
  * @brief Check string format for uint32.
  * @return true if succeeded. 
  *  */ 
-bool isUInt32(const std::string& str);
+bool isUInt32(std::string_view str);
 
 /**
  * @ingroup public_general_functions
  * @brief Check string format for uint16.
  * @return true if succeeded. 
  *  */ 
-bool isUInt16(const std::string& str);
+bool isUInt16(std::string_view str);
 
 /**
  * @ingroup public_general_functions
  * @brief Check string format for uint8.
  * @return true if succeeded. 
  *  */
-bool isUInt8(const std::string& str);
+bool isUInt8(std::string_view str);
+
+/**
+ * @ingroup public_general_functions
+ * @brief Parse string to value with exact range check and without allocation.
+ * Leading whitespaces and a leading '+' sign are accepted. Any other character after the number is not accepted.
+ * Negative numbers are not accepted for unsigned types. Float and double values must be finite.
+ * @param str: String to parse.
+ * @param value: Parsed value. It is changed only if parse succeeded.
+ * @return true if succeeded.
+ *  */
+bool parseValue(std::string_view str, uint8_t &value);
+bool parseValue(std::string_view str, uint16_t &value);
+bool parseValue(std::string_view str, uint32_t &value);
+bool parseValue(std::string_view str, uint64_t &value);
+bool parseValue(std::string_view str, int8_t &value);
+bool parseValue(std::string_view str, int16_t &value);
+bool parseValue(std::string_view str, int32_t &value);
+bool parseValue(std::string_view str, int64_t &value);
+bool parseValue(std::string_view str, float &value);
+bool parseValue(std::string_view str, double &value);
+
+/**
+ * @ingroup public_general_functions
+ * @brief Parse string to bool value.
+ * @param str can be: {true, false, TRUE, FALSE} in any letter case.
+ * @return true if succeeded.
+ *  */
+bool parseValue(std::string_view str, bool &value);
+
+/**
+ * @ingroup public_general_functions
+ * @brief Parse string to string value. It always succeeds.
+ *  */
+bool parseValue(std::string_view str, std::string_view &value);
 
 /** 
  * @ingroup public_general_functions
@@ -148,6 +319,30 @@ std::string decimalToString(double value, uint8_t precision);
  */ 
 std::string decimalToString(float value, uint8_t precision);
 
+/**
+ * @ingroup public_general_functions
+ * @brief Convert double value to characters with certain precision without allocation.
+ * Output is the same as decimalToString(). It is not null terminated.
+ * @param value: double value.
+ * @param precision: number of character after dot character.
+ * @param buffer: Output char array.
+ * @param size: Size of output char array. DECIMAL_STRING_MAX_SIZE is enough for any value and precision.
+ * @return Number of characters written. 0 if buffer is too small.
+ */
+size_t decimalToChars(double value, uint8_t precision, char* buffer, size_t size);
+
+/**
+ * @ingroup public_general_functions
+ * @brief Convert float value to characters with certain precision without allocation.
+ * Output is the same as decimalToString(). It is not null terminated.
+ * @param value: float value.
+ * @param precision: number of character after dot character.
+ * @param buffer: Output char array.
+ * @param size: Size of output char array. DECIMAL_STRING_MAX_SIZE is enough for any value and precision.
+ * @return Number of characters written. 0 if buffer is too small.
+ */
+size_t decimalToChars(float value, uint8_t precision, char* buffer, size_t size);
+
 /**
  * @ingroup public_general_functions
  * @brief Function to check if all cherecters on a string is a valid number. 
@@ -191,11 +386,25 @@ public:
      */
     Stream(std::deque<char>* txBuffer = nullptr, uint32_t txBufferSize = 0, std::deque<char>* rxBuffer = nullptr, uint32_t rxBufferSize = 0);
 
+    /**
+     * @brief Constructor. Init TX/RX buffers with ring buffer backend.
+     * @param txBuffer: Transmit ring buffer pointer. Max size of transmit buffer is set to its capacity.
+     * @param rxBuffer: Recieve ring buffer pointer. Max size of recieve buffer is set to its capacity.
+     */
+    Stream(RingBuffer* txBuffer, RingBuffer* rxBuffer);
+
     /**
      * Destructor.
      */
     ~Stream();
 
+    // Watermark state and statistics counters are atomic, and watermark callbacks of other objects keep the stream
+    // address. Streams are not copied or moved. Share a stream by pointer or reference.
+    Stream(const Stream&) = delete;
+    Stream& operator=(const Stream&) = delete;
+    Stream(Stream&&) = delete;
+    Stream& operator=(Stream&&) = delete;
+
     /**
      * @brief Set transmit buffer pointer and size.
      * @param txBuffer: Transmit buffer pointer.
@@ -209,37 +418,215 @@ public:
      * @param rxBufferSize: Recieve buffer size.
      */
     void setRxBuffer(std::deque<char>* rxBuffer, uint32_t rxBufferSize);
+
+    /**
+     * @brief Set transmit ring buffer pointer. Max size of transmit buffer is set to ring buffer capacity.
+     * @param txBuffer: Transmit ring buffer pointer.
+     * @note Ring buffer and deque buffer are alternatives. Setting one of them unsets the other.
+     */
+    void setTxBuffer(RingBuffer* txBuffer);
+
+    /**
+     * @brief Set receive ring buffer pointer. Max size of receive buffer is set to ring buffer capacity.
+     * @param rxBuffer: Recieve ring buffer pointer.
+     * @note Ring buffer and deque buffer are alternatives. Setting one of them unsets the other.
+     */
+    void setRxBuffer(RingBuffer* rxBuffer);
     
     /**
      * @brief Set transmit buffer size.
      * @param txBufferSize: Transmit buffer size.
+     * @note For ring buffer backend the effective size is limited to ring buffer capacity.
      */
     void setTxBufferSize(const uint32_t &size);
 
     /**
      * @brief Set receive buffer size.
      * @param rxBufferSize: Recieve buffer size.
+     * @note For ring buffer backend the effective size is limited to ring buffer capacity.
      */
     void setRxBufferSize(const uint32_t &size);
 
+    /**
+     * @brief Enable/Disable single producer/single consumer (SPSC) mode.
+     * In SPSC mode one thread may push to a buffer (receiveData, pushBack..., tryPushBack...) while another thread
+     * pops from it (popFront..., tryPopFront..., removeFront..., removeAll...) without any lock.
+     * @note Overflow policy in SPSC mode: old data is never removed by producer. OverflowPolicy::DROP_OLDEST and
+     * OverflowPolicy::DROP_OLDEST_FRAME act as OverflowPolicy::REJECT_PARTIAL. tryPushBack... functions reject new data completely.
+     * @note SPSC mode needs ring buffer backend for TX and RX. Setting a deque buffer disables it.
+     * @return true if succeeded. false if a deque buffer is set.
+     */
+    bool setSpscMode(bool enable);
+
+    /// @brief Return true if SPSC mode is enabled.
+    bool getSpscMode(void) const;
+
+    /**
+     * @brief Enable/Disable multi producer/single consumer (MPSC) mode for TX buffer.
+     * In MPSC mode many threads may call pushBackTxBuffer, pushBackTxDecimal, tryPushBackTxBuffer and
+     * tryPushBackTxBatch at the same time without any lock, while one thread pops from TX buffer.
+     * Each push reserves a contiguous range of TX ring buffer, so records of different threads never interleave.
+     * @note Records are stored whole or dropped whole. OverflowPolicy::BLOCK waits up to blocking timeout for space
+     * and all other policies drop a record that does not fit. Max size of TX buffer is ring buffer capacity.
+     * @note prepareTx() returns empty memory in MPSC mode, so StreamWriter pushes its records with pushBackTxBuffer().
+     * @note MPSC mode needs ring buffer backend for TX. Setting a TX deque buffer disables it.
+     * @return true if succeeded. false if TX buffer is not a ring buffer.
+     */
+    bool setMpscMode(bool enable);
+
+    /// @brief Return true if MPSC mode is enabled.
+    bool getMpscMode(void) const;
+
+    /**
+     * @brief Watermark callback. high is true when buffer length rises to high watermark and
+     * false when it falls to low watermark after that.
+     */
+    using WatermarkCallback = std::function<void(bool high)>;
+
+    /// @brief Set overflow policy of RX buffer. Default is OverflowPolicy::DROP_OLDEST.
+    void setRxOverflowPolicy(OverflowPolicy policy);
+
+    /// @brief Set overflow policy of TX buffer. Default is OverflowPolicy::DROP_OLDEST.
+    void setTxOverflowPolicy(OverflowPolicy policy);
+
+    /// @brief Return overflow policy of RX buffer.
+    OverflowPolicy getRxOverflowPolicy(void) const;
+
+    /// @brief Return overflow policy of TX buffer.
+    OverflowPolicy getTxOverflowPolicy(void) const;
+
+    /// @brief Set last character of frames in RX buffer for OverflowPolicy::DROP_OLDEST_FRAME. Default is '\n'.
+    void setRxFrameDelimiter(char delimiter);
+
+    /// @brief Set last character of frames in TX buffer for OverflowPolicy::DROP_OLDEST_FRAME. Default is '\n'.
+    void setTxFrameDelimiter(char delimiter);
+
+    /**
+     * @brief Set max wait time of OverflowPolicy::BLOCK for RX buffer.
+     * @param timeout: Timeout in milliseconds.
+     * @note Waiting needs SPSC mode, because only another thread can make space. Without SPSC mode it does not wait.
+     */
+    void setRxBlockingTimeout(uint32_t timeout);
+
+    /**
+     * @brief Set max wait time of OverflowPolicy::BLOCK for TX buffer.
+     * @param timeout: Timeout in milliseconds.
+     * @note Waiting needs SPSC mode, because only another thread can make space. Without SPSC mode it does not wait.
+     */
+    void setTxBlockingTimeout(uint32_t timeout);
+
+    /**
+     * @brief Set watermarks of RX buffer. Producers can use them to throttle.
+     * @param high: Callback is called with true when RX buffer length rises to high or more.
+     * @param low: Callback is called with false when RX buffer length falls to low or less after a high call.
+     * @param callback: Watermark callback. Empty callback disables watermarks.
+     * @note In SPSC mode callback can be called from producer or consumer thread.
+     */
+    void setRxWatermarks(size_t high, size_t low, WatermarkCallback callback);
+
+    /**
+     * @brief Set watermarks of TX buffer. Producers can use them to throttle.
+     * @param high: Callback is called with true when TX buffer length rises to high or more.
+     * @param low: Callback is called with false when TX buffer length falls to low or less after a high call.
+     * @param callback: Watermark callback. Empty callback disables watermarks.
+     * @note In SPSC mode callback can be called from producer or consumer thread.
+     */
+    void setTxWatermarks(size_t high, size_t low, WatermarkCallback callback);
+
+    /// @brief Notify callback. It is called after data is stored in RX buffer or removed from TX buffer.
+    using NotifyCallback = std::function<void(void)>;
+
+    /**
+     * @brief Set callback that is called after data is stored in RX buffer. It is called in producer thread.
+     * @note It is used by AsyncStream to resume coroutines that wait for RX data. Empty callback disables it.
+     */
+    void setRxNotify(NotifyCallback callback);
+
+    /**
+     * @brief Set callback that is called after data is removed from TX buffer. It is called in consumer thread.
+     * @note It is used by AsyncStream to resume coroutines that wait for TX drain. Empty callback disables it.
+     */
+    void setTxNotify(NotifyCallback callback);
+
+    /**
+     * @brief Return statistics of TX and RX buffers: characters in/out/dropped, push/pop calls, current and peak
+     * length and push to pop latency histogram.
+     * @note It can be called from any thread. Counters are read with relaxed order, so they can be a little behind.
+     * @note If STREAM_STATS is 0, counters do not exist and an empty snapshot with enabled false is returned.
+     */
+    StreamStatsSnapshot getStats(void) const;
+
+    /// @brief Set all statistics counters to zero. It is not thread safe.
+    void resetStats(void);
+
+    /**
+     * @brief Count characters that a producer dropped before pushing them to TX buffer, for example a record that
+     * did not fit in a serialization buffer. They are added to dropped characters of TX statistics.
+     * @note Call it from TX producer thread. In MPSC mode any producer thread may call it.
+     */
+    void countTxDropped(size_t size);
+
+    /**
+     * @brief Enable/Disable push to pop latency histogram of TX and RX buffers. Default is disabled.
+     * @note When enabled, every push and pop reads steady clock.
+     */
+    void setLatencyStats(bool enable);
+
+    /// @brief Return number of characters stored in RX buffer.
+    size_t getRxBufferLength(void) const;
+
+    /// @brief Return number of characters stored in TX buffer.
+    size_t getTxBufferLength(void) const;
+
+    /// @brief Return number of characters that can be stored in RX buffer before it is full.
+    size_t getRxFreeSpace(void) const;
+
+    /// @brief Return number of characters that can be stored in TX buffer before it is full.
+    size_t getTxFreeSpace(void) const;
+
+    /**
+     * @brief Return total number of characters removed from front of RX buffer by pop, remove, consume or overflow.
+     * @note It can be used to keep positions in RX buffer valid while data is removed from its front.
+     * @note It can be read by another thread, for example by the producer in SPSC mode.
+     */
+    uint64_t getRxReadCount(void) const;
+
+    /**
+     * @brief Find first position of a character in RX buffer.
+     * @param value: Character to find.
+     * @param offset: Position from front of RX buffer to start search.
+     * @return Position from front of RX buffer. std::string::npos if it is not found.
+     */
+    size_t findRx(char value, size_t offset = 0) const;
+
+    /**
+     * @brief Copy certain number of characters from RX buffer to char array without removing them.
+     * @param offset: Number of characters from front of RX buffer to skip.
+     * @return Number of characters copied.
+     */
+    size_t peekFrontRxBuffer(char* data, size_t size, size_t offset = 0) const;
+
     /**
      * @brief Receive data and store it on rx buffer.
      * @param data: character array data.
      * @param size: number of character from data to store on rx buffer.
+     * @return Number of characters stored. It depends on RX overflow policy.
      */
-    void receiveData(const char &data, size_t size = 0);
+    size_t receiveData(const char &data, size_t size = 0);
 
     /**
      * @brief Receive data string and store all of it on rx buffer.
      * @param data: string data.
+     * @return Number of characters stored. It depends on RX overflow policy.
      */
-    void receiveData(const std::string &data);
+    size_t receiveData(const std::string &data);
 
     /**
      * @brief Receive deque<char> data and store all of it on rx buffer.
      * @param data: deque<char> data.
+     * @return Number of characters stored. It depends on RX overflow policy.
      */
-    void receiveData(const std::deque<char> &data);
+    size_t receiveData(const std::deque<char> &data);
 
     /// @brief Remove certain number character from front of RX deque buffer.
     void removeFrontRxBuffer(size_t num);
@@ -265,37 +652,266 @@ public:
      *  */
     std::string popAllRxBuffer(void);
 
+    /**
+     * @brief Pop front certain number elements from RX buffer to a pooled buffer and remove them.
+     * @param pool: Pool of returned buffer. Steady state use does not allocate from heap.
+     * @return Buffer that pop front. Empty buffer if RX buffer is empty.
+     *  */
+    PooledBuffer popFrontRxBuffer(size_t size, BufferPool &pool);
+
+    /**
+     * @brief Pop front all elements from RX buffer to a pooled buffer and remove them.
+     * @param pool: Pool of returned buffer. Steady state use does not allocate from heap.
+     * @return Buffer that pop front. Empty buffer if RX buffer is empty.
+     *  */
+    PooledBuffer popAllRxBuffer(BufferPool &pool);
+
     /**
      * @brief Push back certain number character from char array to RX buffer.
+     * @return Number of characters stored. It depends on RX overflow policy.
      */
-    void pushBackRxBuffer(const char* data, size_t size);
+    size_t pushBackRxBuffer(const char* data, size_t size);
 
     /**
      * @brief Push back certain string to RX buffer.
+     * @return Number of characters stored. It depends on RX overflow policy.
      */
-    void pushBackRxBuffer(const std::string* data);
+    size_t pushBackRxBuffer(const std::string* data);
 
     /**
      * @brief Push back certain number character from char array to TX buffer.
+     * @return Number of characters stored. It depends on TX overflow policy.
      */
-    void pushBackTxBuffer(const char* data, size_t size);
+    size_t pushBackTxBuffer(const char* data, size_t size);
 
     /**
      * @brief Push back certain string to TX buffer.
+     * @return Number of characters stored. It depends on TX overflow policy.
      */
-    void pushBackTxBuffer(const std::string* data);
+    size_t pushBackTxBuffer(const std::string* data);
 
     /**
      * @brief Push back certain string to TX buffer.
+     * @return Number of characters stored. It depends on TX overflow policy.
+     */
+    size_t pushBackTxBuffer(const std::string& data);
+
+    /**
+     * @brief Push back double value with certain precision to TX buffer without allocation.
+     * Characters are the same as decimalToString().
+     * @return Number of characters stored.
      */
-    void pushBackTxBuffer(const std::string& data);
+    size_t pushBackTxDecimal(double value, uint8_t precision);
+
+    /**
+     * @brief Push back float value with certain precision to TX buffer without allocation.
+     * Characters are the same as decimalToString().
+     * @return Number of characters stored.
+     */
+    size_t pushBackTxDecimal(float value, uint8_t precision);
+
+    /**
+     * @brief Push back all characters of char array to RX buffer only if they fit in it. It never removes old data
+     * and it does not use overflow policy.
+     * @return true if succeeded. false if there is not enough space and nothing is pushed.
+     */
+    bool tryPushBackRxBuffer(const char* data, size_t size);
+
+    /**
+     * @brief Push back all characters of char array to TX buffer only if they fit in it. It never removes old data
+     * and it does not use overflow policy.
+     * @return true if succeeded. false if there is not enough space and nothing is pushed.
+     */
+    bool tryPushBackTxBuffer(const char* data, size_t size);
+
+    /**
+     * @brief Push back records to TX buffer as one contiguous unit only if all of them fit in it.
+     * It never removes old data and it does not use overflow policy.
+     * @note In MPSC mode it needs one reservation for the whole batch, so it is cheaper than one push per record.
+     * @note The whole batch is published at once, so a consumer thread never sees part of it.
+     * @return true if succeeded. false if there is not enough space and nothing is pushed.
+     */
+    bool tryPushBackTxBatch(std::span<const std::string_view> records);
+
+    /**
+     * @brief Pop front certain number of elements from RX buffer to char array only if that many elements exist.
+     * @return true if succeeded. false if there is not enough data and nothing is popped.
+     */
+    bool tryPopFrontRxBuffer(char* data, size_t size);
+
+    /**
+     * @brief Pop front certain number of elements from TX buffer to char array only if that many elements exist.
+     * @return true if succeeded. false if there is not enough data and nothing is popped.
+     */
+    bool tryPopFrontTxBuffer(char* data, size_t size);
+
+    /**
+     * @brief Get RX buffer data as up to two contiguous memory regions without copy.
+     * @note It needs ring buffer backend. For deque backend empty regions are returned.
+     * @note Regions are valid until data is removed from RX buffer.
+     */
+    RingRegions<const char> peekRx(void) const;
+
+    /// @brief Remove certain number of characters from front of RX buffer after they are used from peekRx().
+    void consumeRx(size_t size);
+
+    /**
+     * @brief Get contiguous free space of RX buffer to write directly into it. For example by read().
+     * @param size: Max number of characters.
+     * @return Writable memory. It can be smaller than size if free space is smaller or it wraps around the end of
+     * ring buffer. Empty if buffer is full or backend is deque. It never removes old data to make space.
+     * @note Written data is not stored until commitRx() is called.
+     */
+    std::span<char> prepareRx(size_t size);
+
+    /**
+     * @brief Get free space of RX buffer as up to two contiguous memory regions. For example for one readv().
+     * @param size: Max number of characters of both regions.
+     * @return Writable regions. Empty if buffer is full or backend is deque. It never removes old data to make space.
+     * @note Written data is not stored until commitRx() is called. Data of first region is stored first.
+     */
+    RingRegions<char> prepareRxRegions(size_t size);
+
+    /// @brief Store certain number of characters that are written into prepareRx()/prepareRxRegions() memory to RX buffer.
+    void commitRx(size_t size);
+
+    /**
+     * @brief Get TX buffer data as up to two contiguous memory regions without copy.
+     * @note It needs ring buffer backend. For deque backend empty regions are returned.
+     * @note Regions are valid until data is removed from TX buffer.
+     */
+    RingRegions<const char> peekTx(void) const;
+
+    /// @brief Remove certain number of characters from front of TX buffer after they are used from peekTx().
+    void consumeTx(size_t size);
+
+    /**
+     * @brief Get contiguous free space of TX buffer to write directly into it.
+     * @param size: Max number of characters.
+     * @return Writable memory. It can be smaller than size if free space is smaller or it wraps around the end of
+     * ring buffer. Empty if buffer is full or backend is deque. It never removes old data to make space.
+     * @note Written data is not stored until commitTx() is called.
+     */
+    std::span<char> prepareTx(size_t size);
+
+    /// @brief Store certain number of characters that are written into prepareTx() memory to TX buffer.
+    void commitTx(size_t size);
+
+    /**
+     * @brief Write TX buffer data to file descriptor and remove exactly the written characters from TX buffer.
+     * For ring buffer backend its contiguous regions are submitted directly with writev().
+     * It writes until TX buffer is empty, the descriptor would block (EAGAIN) or an error happens.
+     * @note Writing to a socket or pipe whose reader is closed raises SIGPIPE. Use sendTx() for sockets or ignore
+     * SIGPIPE in the process.
+     * @param fd: File descriptor. For example serial port, socket, pipe or pty.
+     * @return Number of characters written. -1 if an error happens before anything is written, errno is set.
+     */
+    ssize_t flushTx(int fd);
+
+    /**
+     * @brief Same as flushTx() for sockets. It writes with MSG_NOSIGNAL so closed peer fails with EPIPE
+     * instead of raising SIGPIPE.
+     * @param socket: Socket descriptor.
+     * @return Number of characters written. -1 if an error happens before anything is written, errno is set.
+     */
+    ssize_t sendTx(int socket);
+
+    /**
+     * @brief Read data from file descriptor directly to free space of RX buffer with one readv() call.
+     * It never removes old data to make space.
+     * @param fd: File descriptor. For example serial port, socket, pipe or pty.
+     * @return Number of characters read. 0 on end of file.
+     * -1 on error and errno is set. It is EAGAIN for no data on non-blocking descriptor and ENOBUFS for full RX buffer.
+     */
+    ssize_t fillRx(int fd);
 
 private:
 
     std::deque<char>* _txBuffer;        ///! @brief TX deque buffer pointer
     std::deque<char>* _rxBuffer;        ///! @brief RX deque buffer pointer.
 
+    RingBuffer* _txRing;                ///! @brief TX ring buffer pointer. It is used instead of _txBuffer if not nullptr.
+    RingBuffer* _rxRing;                ///! @brief RX ring buffer pointer. It is used instead of _rxBuffer if not nullptr.
+
     size_t _txBufferSize;               ///! @brief Max size for transmit data buffer.
     size_t _rxBufferSize;               ///! @brief Max size for receive data buffer.
 
+    bool _spscMode;                     ///! @brief Single producer/single consumer mode flag.
+
+    bool _mpscMode;                     ///! @brief Multi producer/single consumer mode flag of TX buffer.
+
+    std::atomic<uint64_t> _rxReadCount; ///! @brief Total number of characters removed from front of RX buffer.
+
+    /**
+     * @struct BufferControl
+     * @brief Overflow and watermark settings of one buffer direction.
+     */
+    struct BufferControl
+    {
+        OverflowPolicy policy = OverflowPolicy::DROP_OLDEST;    ///! @brief Overflow policy.
+        char frameDelimiter = '\n';                             ///! @brief Last character of frames for OverflowPolicy::DROP_OLDEST_FRAME.
+        uint32_t timeout = 0;                                   ///! @brief Max wait time of OverflowPolicy::BLOCK in milliseconds.
+        size_t highWatermark = SIZE_MAX;                        ///! @brief High watermark.
+        size_t lowWatermark = 0;                                ///! @brief Low watermark.
+        WatermarkCallback callback;                             ///! @brief Watermark callback.
+        NotifyCallback notify;                                  ///! @brief RX push or TX pop notify callback.
+        std::atomic<bool> high = false;                         ///! @brief True after high watermark call until low watermark call.
+    };
+
+    BufferControl _txControl;           ///! @brief TX overflow and watermark settings.
+    BufferControl _rxControl;           ///! @brief RX overflow and watermark settings.
+
+    /// @brief Return max number of characters that RX or TX buffer can store.
+    size_t _bufferLimit(bool rx) const;
+
+#if STREAM_STATS
+    StreamStatsCounter _txStats;        ///! @brief TX statistics counters.
+    StreamStatsCounter _rxStats;        ///! @brief RX statistics counters.
+#endif
+
+    /**
+     * @brief Remove characters from front of RX or TX buffer without watermark check and statistics.
+     * @return Number of removed characters.
+     */
+    size_t _removeFront(bool rx, size_t size);
+
+    /// @brief Find first position of a character in RX or TX buffer from offset. std::string::npos if it is not found.
+    size_t _find(bool rx, char value, size_t offset) const;
+
+    /**
+     * @brief Apply overflow policy of RX or TX buffer before new data is stored.
+     * @param rx: true for RX buffer and false for TX buffer.
+     * @param size: Size of new data. It is updated to number of characters that can be stored.
+     * @return Number of characters from front of new data that must be skipped.
+     */
+    size_t _makeSpace(bool rx, size_t &size);
+
+    /// @brief Call watermark callback of RX or TX buffer if its length crossed a watermark.
+    void _checkWatermark(bool rx);
+
+    /// @brief Count a push of requested characters that stored some of them and check watermarks.
+    void _afterPush(bool rx, size_t requested, size_t stored);
+
+    /// @brief Count a pop or remove of characters by consumer and check watermarks.
+    void _afterPop(bool rx, size_t size);
+
+    /// @brief Write TX buffer to descriptor for flushTx() and sendTx(). Sockets are written with MSG_NOSIGNAL.
+    ssize_t _flushTx(int fd, bool socket);
+
+    /// @brief Count old characters that overflow policy removed.
+    void _statsEvict(bool rx, size_t size);
+
+    /**
+     * @brief Push records to TX ring buffer in MPSC mode as one unit. It waits for space if TX policy is
+     * OverflowPolicy::BLOCK.
+     * @return Number of characters stored. It is 0 or total size of records.
+     */
+    size_t _pushShared(const std::string_view* records, size_t count);
+
+    /// @brief Push all of data to ring buffer only if it fits in max size of buffer.
+    static bool _tryPushRing(RingBuffer* ring, size_t bufferSize, const char* data, size_t size);
+
+    /// @brief Get free regions of ring buffer limited to max size of buffer.
+    static RingRegions<char> _prepareRing(RingBuffer* ring, size_t bufferSize, size_t size);
+
 };
\ No newline at end of file
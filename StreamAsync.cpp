@@ -0,0 +1,147 @@
+// ####################################################################################################
+// Include libraries:
+
+#include "StreamAsync.h"
+
+// ######################################################################################################
+// AsyncStream Class:
+
+AsyncStream::AsyncStream(Stream &stream, Executor executor) : _stream(stream), _executor(std::move(executor))
+{
+    _txWait.kind = Wait::DRAIN;
+    _stream.setRxNotify([this]() { _notify(_rxWait); });
+    _stream.setTxNotify([this]() { _notify(_txWait); });
+}
+
+AsyncStream::~AsyncStream()
+{
+    _stream.setRxNotify(nullptr);
+    _stream.setTxNotify(nullptr);
+}
+
+AsyncStream::BytesAwaiter AsyncStream::readBytes(size_t size)
+{
+    _rxWait.kind = Wait::BYTES;
+    _rxWait.size = size;
+
+    return BytesAwaiter(*this, _rxWait);
+}
+
+AsyncStream::DelimiterAwaiter AsyncStream::readUntil(char delimiter)
+{
+    _rxWait.kind = Wait::DELIMITER;
+    _rxWait.delimiter = delimiter;
+    _rxWait.scanned = _stream.getRxReadCount();
+
+    return DelimiterAwaiter(*this, _rxWait);
+}
+
+AsyncStream::RegionsAwaiter AsyncStream::waitBytes(size_t size)
+{
+    _rxWait.kind = Wait::BYTES;
+    _rxWait.size = size;
+
+    return RegionsAwaiter(*this, _rxWait);
+}
+
+AsyncStream::DrainAwaiter AsyncStream::drainTx(void)
+{
+    return DrainAwaiter(*this, _txWait);
+}
+
+std::string AsyncStream::DelimiterAwaiter::await_resume(void)
+{
+    size_t position = _async._stream.findRx(_wait.delimiter, _async._scanStart(_wait));
+    std::string data = _async._stream.popFrontRxBuffer(position);
+    _async._stream.removeFrontRxBuffer(1);
+
+    return data;
+}
+
+bool AsyncStream::_ready(Wait &wait)
+{
+    switch(wait.kind)
+    {
+        case Wait::BYTES:
+        {
+            return _stream.getRxBufferLength() >= wait.size;
+        }
+
+        case Wait::DELIMITER:
+        {
+            // Continue scan from the last checked character. Read count before length keeps the end position
+            // conservative if overflow policy removes old characters meanwhile.
+            uint64_t readCount = _stream.getRxReadCount();
+            uint64_t scanned = wait.scanned.load(std::memory_order_relaxed);
+            uint64_t end = readCount + _stream.getRxBufferLength();
+
+            if(_stream.findRx(wait.delimiter, _scanStart(wait)) != std::string::npos)
+            {
+                return true;
+            }
+
+            // Producer and consumer can both scan. Keep the larger position.
+            while((scanned < end) && !wait.scanned.compare_exchange_weak(scanned, end, std::memory_order_relaxed))
+            {
+            }
+
+            return false;
+        }
+
+        case Wait::DRAIN:
+        {
+            return _stream.getTxBufferLength() == 0;
+        }
+    }
+
+    return false;
+}
+
+size_t AsyncStream::_scanStart(const Wait &wait) const
+{
+    // Characters removed from front of RX buffer, for example by DROP_OLDEST policy, shift the scan position down.
+    uint64_t readCount = _stream.getRxReadCount();
+    uint64_t scanned = wait.scanned.load(std::memory_order_relaxed);
+
+    return (scanned > readCount) ? (size_t)(scanned - readCount) : 0;
+}
+
+bool AsyncStream::_suspend(Wait &wait, std::coroutine_handle<> handle)
+{
+    wait.handle.store(handle.address(), std::memory_order_release);
+
+    // Data can arrive between await_ready() and store of handle. Take handle back if so.
+    if(_ready(wait) && (wait.handle.exchange(nullptr, std::memory_order_acq_rel) != nullptr))
+    {
+        return false;
+    }
+
+    return true;
+}
+
+void AsyncStream::_notify(Wait &wait)
+{
+    if((wait.handle.load(std::memory_order_acquire) == nullptr) || !_ready(wait))
+    {
+        return;
+    }
+
+    // Only one of notify and _suspend() takes the handle.
+    void* address = wait.handle.exchange(nullptr, std::memory_order_acq_rel);
+
+    if(address == nullptr)
+    {
+        return;
+    }
+
+    std::coroutine_handle<> handle = std::coroutine_handle<>::from_address(address);
+
+    if(_executor)
+    {
+        _executor(handle);
+    }
+    else
+    {
+        handle.resume();
+    }
+}
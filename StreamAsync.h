@@ -0,0 +1,194 @@
+#pragma once
+
+// ####################################################################################################
+// Include libraries:
+
+#include <atomic>                   // Waiting coroutine handles
+#include <coroutine>                // C++20 coroutines
+#include <exception>                // std::terminate
+#include <functional>               // Executor
+#include <string>                   // String class and related functions
+#include "Stream.h"                 // Stream class
+
+// ######################################################################################################
+// StreamTask Struct:
+
+/**
+ * @struct StreamTask
+ * @brief Return type of fire-and-forget coroutines, for example one protocol session.
+ * The coroutine starts immediately and its frame is destroyed when it returns.
+ * @code
+ * StreamTask session(AsyncStream &link)
+ * {
+ *     std::string line = co_await link.readUntil('\n');
+ *     link.stream().pushBackTxBuffer(line);
+ *     co_await link.drainTx();
+ * }
+ * @endcode
+ */
+struct StreamTask
+{
+    struct promise_type
+    {
+        StreamTask get_return_object(void) { return {}; }
+        std::suspend_never initial_suspend(void) noexcept { return {}; }
+        std::suspend_never final_suspend(void) noexcept { return {}; }
+        void return_void(void) {}
+        void unhandled_exception(void) { std::terminate(); }
+    };
+};
+
+// ######################################################################################################
+// AsyncStream Class:
+
+/**
+ * @class AsyncStream
+ * @brief Awaitable read and drain operations on a stream for C++20 coroutines.
+ * A coroutine that awaits RX data is suspended until receiveData, pushBackRxBuffer, fillRx, ... stores enough data.
+ * A coroutine that awaits TX drain is suspended until TX buffer is empty.
+ * @note It uses notify callbacks of stream. Only one AsyncStream can be attached to a stream.
+ * @note One coroutine may wait for RX and one coroutine may wait for TX at the same time.
+ * @note Coroutines are resumed with executor. If executor is empty, they are resumed inline in the thread that stores
+ * RX data or removes TX data. With a thread pool, executor should post the handle to consumer thread of the stream.
+ * @note If RX data is stored in another thread, stream must be in SPSC mode.
+ */
+class AsyncStream
+{
+public:
+
+    /// @brief Executor that resumes a suspended coroutine.
+    using Executor = std::function<void(std::coroutine_handle<>)>;
+
+    /**
+     * @brief Constructor. Attach to notify callbacks of stream.
+     * @param stream: Stream. It must be valid until destruction.
+     * @param executor: Executor of coroutines. Empty executor resumes inline.
+     */
+    AsyncStream(Stream &stream, Executor executor = nullptr);
+
+    /**
+     * Destructor. Detach from notify callbacks of stream.
+     * @note Suspended coroutines are not resumed.
+     */
+    ~AsyncStream();
+
+    AsyncStream(const AsyncStream&) = delete;
+    AsyncStream& operator=(const AsyncStream&) = delete;
+
+    /// @brief Return the stream.
+    Stream& stream(void) { return _stream; }
+
+    /**
+     * @struct Wait
+     * @brief Condition of one suspended coroutine.
+     */
+    struct Wait
+    {
+        enum Kind : uint8_t
+        {
+            BYTES,                      ///< RX buffer has at least size characters.
+            DELIMITER,                  ///< RX buffer has delimiter character.
+            DRAIN                       ///< TX buffer is empty.
+        };
+
+        Kind kind = BYTES;                          ///! @brief Condition kind.
+        size_t size = 0;                            ///! @brief Number of characters for BYTES.
+        char delimiter = '\n';                      ///! @brief Delimiter character for DELIMITER.
+        std::atomic<uint64_t> scanned{0};           ///! @brief RX read count at end of characters without delimiter.
+        std::atomic<void*> handle{nullptr};         ///! @brief Suspended coroutine address.
+    };
+
+    /**
+     * @class Awaiter
+     * @brief Base of awaitable operations. Result type is defined by derived classes.
+     */
+    class Awaiter
+    {
+    public:
+
+        Awaiter(AsyncStream &async, Wait &wait) : _async(async), _wait(wait) {}
+
+        bool await_ready(void) { return _async._ready(_wait); }
+
+        bool await_suspend(std::coroutine_handle<> handle) { return _async._suspend(_wait, handle); }
+
+    protected:
+
+        AsyncStream &_async;            ///! @brief Owner.
+        Wait &_wait;                    ///! @brief Condition.
+    };
+
+    /// @brief Awaiter of readBytes(). Result is popped characters.
+    class BytesAwaiter : public Awaiter
+    {
+    public:
+        using Awaiter::Awaiter;
+        std::string await_resume(void) { return _async._stream.popFrontRxBuffer(_wait.size); }
+    };
+
+    /// @brief Awaiter of readUntil(). Result is popped characters before delimiter. Delimiter is removed.
+    class DelimiterAwaiter : public Awaiter
+    {
+    public:
+        using Awaiter::Awaiter;
+        std::string await_resume(void);
+    };
+
+    /// @brief Awaiter of waitBytes(). Result is RX buffer regions of requested size without copy.
+    class RegionsAwaiter : public Awaiter
+    {
+    public:
+        using Awaiter::Awaiter;
+        RingRegions<const char> await_resume(void) { return _async._stream.peekRx().subRegions(0, _wait.size); }
+    };
+
+    /// @brief Awaiter of drainTx().
+    class DrainAwaiter : public Awaiter
+    {
+    public:
+        using Awaiter::Awaiter;
+        void await_resume(void) {}
+    };
+
+    /**
+     * @brief Wait until RX buffer has at least size characters and pop them.
+     * @note size must not be larger than max size of RX buffer.
+     */
+    BytesAwaiter readBytes(size_t size);
+
+    /**
+     * @brief Wait until RX buffer has delimiter character. Pop characters before it and remove delimiter.
+     * @note If RX buffer becomes full without delimiter, coroutine is not resumed. Use overflow policy to make space.
+     */
+    DelimiterAwaiter readUntil(char delimiter);
+
+    /**
+     * @brief Wait until RX buffer has at least size characters and return them as regions without copy.
+     * Call Stream::consumeRx() after they are used.
+     * @note It needs ring buffer backend. For deque backend empty regions are returned.
+     */
+    RegionsAwaiter waitBytes(size_t size);
+
+    /// @brief Wait until TX buffer is empty.
+    DrainAwaiter drainTx(void);
+
+private:
+
+    Stream &_stream;                    ///! @brief Stream.
+    Executor _executor;                 ///! @brief Executor of coroutines.
+    Wait _rxWait;                       ///! @brief Condition of coroutine that waits for RX data.
+    Wait _txWait;                       ///! @brief Condition of coroutine that waits for TX drain.
+
+    /// @brief Return true if condition is true. It can be called by consumer and producer at the same time.
+    bool _ready(Wait &wait);
+
+    /// @brief Return RX position where delimiter scan of condition continues.
+    size_t _scanStart(const Wait &wait) const;
+
+    /// @brief Store handle of coroutine. Return false if condition became true, so coroutine is not suspended.
+    bool _suspend(Wait &wait, std::coroutine_handle<> handle);
+
+    /// @brief Resume coroutine of condition if it is suspended and condition is true.
+    void _notify(Wait &wait);
+
+};
@@ -0,0 +1,648 @@
+// ####################################################################################################
+// Include libraries:
+
+#include "StreamFramer.h"
+
+// ####################################################################################################
+// Private macros:
+
+#define SLIP_END                    ((char)0xC0)
+#define SLIP_ESC                    ((char)0xDB)
+#define SLIP_ESC_END                ((char)0xDC)
+#define SLIP_ESC_ESC                ((char)0xDD)
+
+// ######################################################################################################
+// StreamFramer Class:
+
+StreamFramer::StreamFramer(Stream* stream, size_t maxFrameSize)
+{
+    _maxFrameSize = maxFrameSize;
+    _errorCount = 0;
+    setStream(stream);
+}
+
+StreamFramer::~StreamFramer()
+{
+
+}
+
+void StreamFramer::setStream(Stream* stream)
+{
+    _stream = stream;
+    reset();
+}
+
+void StreamFramer::setMaxFrameSize(size_t size)
+{
+    _maxFrameSize = size;
+}
+
+void StreamFramer::reset(void)
+{
+    _scanPos = 0;
+    _readCount = (_stream != nullptr) ? _stream->getRxReadCount() : 0;
+    _frameReady = false;
+    _payloadOffset = 0;
+    _payloadSize = 0;
+    _frameSize = 0;
+    _resetState();
+}
+
+uint32_t StreamFramer::getErrorCount(void) const
+{
+    return _errorCount;
+}
+
+bool StreamFramer::nextFrame(RingRegions<const char> &payload)
+{
+    _syncPosition();
+
+    if(!_frameReady)
+    {
+        _frameReady = _findFrame();
+    }
+
+    if(!_frameReady)
+    {
+        return false;
+    }
+
+    payload = _stream->peekRx().subRegions(_payloadOffset, _payloadSize);
+
+    return true;
+}
+
+void StreamFramer::consumeFrame(void)
+{
+    // Found frame is not at the same position if characters are removed from RX buffer since nextFrame().
+    _syncPosition();
+
+    if(!_frameReady)
+    {
+        return;
+    }
+
+    _stream->removeFrontRxBuffer(_frameSize);
+    _readCount = _stream->getRxReadCount();
+    _scanPos = 0;
+    _frameReady = false;
+}
+
+bool StreamFramer::popFrame(std::string &payload)
+{
+    RingRegions<const char> regions;
+
+    while(nextFrame(regions))
+    {
+        payload.resize(_payloadSize);
+        _stream->peekFrontRxBuffer(payload.data(), _payloadSize, _payloadOffset);
+        consumeFrame();
+
+        size_t size = payload.size();
+        if(_decodePayload(payload.data(), size))
+        {
+            payload.resize(size);
+            return true;
+        }
+
+        // Corrupted frame is removed. Continue with next frame.
+        _errorCount++;
+    }
+
+    return false;
+}
+
+bool StreamFramer::popFrame(PooledBuffer &payload, BufferPool &pool)
+{
+    RingRegions<const char> regions;
+
+    while(nextFrame(regions))
+    {
+        payload = pool.acquire(_payloadSize);
+        if(_payloadSize > 0)
+        {
+            _stream->peekFrontRxBuffer(payload.data(), _payloadSize, _payloadOffset);
+        }
+        consumeFrame();
+
+        size_t size = payload.size();
+        if(_decodePayload(payload.data(), size))
+        {
+            payload.resize(size);
+            return true;
+        }
+
+        // Corrupted frame is removed. Continue with next frame.
+        _errorCount++;
+    }
+
+    payload.reset();
+
+    return false;
+}
+
+bool StreamFramer::pushFrame(const char* payload, size_t size)
+{
+    if(!encodeFrame(payload, size, _txFrame))
+    {
+        return false;
+    }
+
+    return _stream->tryPushBackTxBuffer(_txFrame.data(), _txFrame.size());
+}
+
+bool StreamFramer::_decodePayload(char* payload, size_t &size) const
+{
+    (void)payload;
+    (void)size;
+    return true;
+}
+
+void StreamFramer::_dropFront(size_t size)
+{
+    _stream->removeFrontRxBuffer(size);
+    _readCount = _stream->getRxReadCount();
+    _scanPos = 0;
+    _frameReady = false;
+    _errorCount++;
+}
+
+void StreamFramer::_resetState(void)
+{
+
+}
+
+void StreamFramer::_syncPosition(void)
+{
+    uint64_t readCount = _stream->getRxReadCount();
+
+    if(readCount == _readCount)
+    {
+        return;
+    }
+
+    // Characters are removed from front of RX buffer. Shift scan position and search the frame again.
+    size_t removed = (size_t)(readCount - _readCount);
+    _scanPos = (removed < _scanPos) ? _scanPos - removed : 0;
+    _readCount = readCount;
+    _frameReady = false;
+}
+
+// ######################################################################################################
+// DelimiterFramer Class:
+
+DelimiterFramer::DelimiterFramer(Stream* stream, char delimiter, size_t maxFrameSize) : StreamFramer(stream, maxFrameSize)
+{
+    _delimiter = delimiter;
+    _skipEmptyFrames = false;
+    _discarding = false;
+}
+
+bool DelimiterFramer::encodeFrame(const char* payload, size_t size, std::string &frame) const
+{
+    if(size > _maxFrameSize)
+    {
+        return false;
+    }
+
+    frame.assign(payload, size);
+    frame.push_back(_delimiter);
+
+    return true;
+}
+
+bool DelimiterFramer::_findFrame(void)
+{
+    while(true)
+    {
+        size_t pos = _stream->findRx(_delimiter, _scanPos);
+
+        if(pos == std::string::npos)
+        {
+            size_t length = _stream->getRxBufferLength();
+
+            if(_discarding)
+            {
+                // Still inside a dropped frame.
+                _stream->removeFrontRxBuffer(length);
+                _readCount = _stream->getRxReadCount();
+                _scanPos = 0;
+            }
+            else if(length > _maxFrameSize)
+            {
+                // No delimiter in max frame size. Drop scanned data and the rest of frame until next delimiter.
+                _dropFront(length);
+                _discarding = true;
+            }
+            else
+            {
+                _scanPos = length;
+            }
+
+            return false;
+        }
+
+        if(_discarding)
+        {
+            // End of a frame that its front part is dropped.
+            _stream->removeFrontRxBuffer(pos + 1);
+            _readCount = _stream->getRxReadCount();
+            _scanPos = 0;
+            _discarding = false;
+            continue;
+        }
+
+        if(pos > _maxFrameSize)
+        {
+            // Frame is too long. Drop it and search next frame.
+            _dropFront(pos + 1);
+            continue;
+        }
+
+        if((pos == 0) && _skipEmptyFrames)
+        {
+            _stream->removeFrontRxBuffer(1);
+            _readCount = _stream->getRxReadCount();
+            _scanPos = 0;
+            continue;
+        }
+
+        _scanPos = pos;
+        _payloadOffset = 0;
+        _payloadSize = pos;
+        _frameSize = pos + 1;
+
+        return true;
+    }
+}
+
+void DelimiterFramer::_resetState(void)
+{
+    _discarding = false;
+}
+
+// ######################################################################################################
+// LengthPrefixFramer Class:
+
+LengthPrefixFramer::LengthPrefixFramer(Stream* stream, uint8_t headerSize, bool bigEndian, size_t maxFrameSize) : StreamFramer(stream, maxFrameSize)
+{
+    _headerSize = ((headerSize == 1) || (headerSize == 4)) ? headerSize : 2;
+    _bigEndian = bigEndian;
+}
+
+bool LengthPrefixFramer::encodeFrame(const char* payload, size_t size, std::string &frame) const
+{
+    if((size > _maxFrameSize) || ((_headerSize < 4) && (size >> (8 * _headerSize)) != 0))
+    {
+        return false;
+    }
+
+    frame.resize(_headerSize);
+
+    for(uint8_t i = 0; i < _headerSize; i++)
+    {
+        uint8_t shift = _bigEndian ? 8 * (_headerSize - 1 - i) : 8 * i;
+        frame[i] = (char)((size >> shift) & 0xFF);
+    }
+
+    frame.append(payload, size);
+
+    return true;
+}
+
+bool LengthPrefixFramer::_findFrame(void)
+{
+    while(true)
+    {
+        size_t length = _stream->getRxBufferLength();
+
+        if(length < _headerSize)
+        {
+            return false;
+        }
+
+        uint8_t header[4];
+        _stream->peekFrontRxBuffer((char*)header, _headerSize);
+
+        size_t size = 0;
+        for(uint8_t i = 0; i < _headerSize; i++)
+        {
+            uint8_t shift = _bigEndian ? 8 * (_headerSize - 1 - i) : 8 * i;
+            size |= (size_t)header[i] << shift;
+        }
+
+        if(size > _maxFrameSize)
+        {
+            // Invalid length header. Drop one byte and try to find a valid header.
+            _dropFront(1);
+            continue;
+        }
+
+        if(length < _headerSize + size)
+        {
+            return false;
+        }
+
+        _payloadOffset = _headerSize;
+        _payloadSize = size;
+        _frameSize = _headerSize + size;
+
+        return true;
+    }
+}
+
+// ######################################################################################################
+// SlipFramer Class:
+
+SlipFramer::SlipFramer(Stream* stream, size_t maxFrameSize) : DelimiterFramer(stream, SLIP_END, maxFrameSize)
+{
+    // Leading END characters only flush line noise.
+    _skipEmptyFrames = true;
+}
+
+bool SlipFramer::encodeFrame(const char* payload, size_t size, std::string &frame) const
+{
+    frame.clear();
+    frame.reserve(2 * size + 2);
+    frame.push_back(SLIP_END);
+
+    for(size_t i = 0; i < size; i++)
+    {
+        if(payload[i] == SLIP_END)
+        {
+            frame.push_back(SLIP_ESC);
+            frame.push_back(SLIP_ESC_END);
+        }
+        else if(payload[i] == SLIP_ESC)
+        {
+            frame.push_back(SLIP_ESC);
+            frame.push_back(SLIP_ESC_ESC);
+        }
+        else
+        {
+            frame.push_back(payload[i]);
+        }
+    }
+
+    if(frame.size() - 1 > _maxFrameSize)
+    {
+        return false;
+    }
+
+    frame.push_back(SLIP_END);
+
+    return true;
+}
+
+bool SlipFramer::_decodePayload(char* payload, size_t &size) const
+{
+    size_t out = 0;
+
+    for(size_t i = 0; i < size; i++)
+    {
+        char c = payload[i];
+
+        if(c == SLIP_ESC)
+        {
+            if(++i == size)
+            {
+                return false;
+            }
+
+            if(payload[i] == SLIP_ESC_END)
+            {
+                c = SLIP_END;
+            }
+            else if(payload[i] == SLIP_ESC_ESC)
+            {
+                c = SLIP_ESC;
+            }
+            else
+            {
+                return false;
+            }
+        }
+
+        payload[out++] = c;
+    }
+
+    size = out;
+
+    return true;
+}
+
+// ######################################################################################################
+// CobsFramer Class:
+
+CobsFramer::CobsFramer(Stream* stream, size_t maxFrameSize) : DelimiterFramer(stream, '\0', maxFrameSize)
+{
+    _skipEmptyFrames = true;
+}
+
+bool CobsFramer::encodeFrame(const char* payload, size_t size, std::string &frame) const
+{
+    frame.clear();
+    frame.reserve(size + size / 254 + 2);
+
+    // Each block starts with a code byte: distance to next zero byte or 0xFF for 254 non-zero bytes.
+    size_t codeIndex = 0;
+    uint8_t code = 1;
+    frame.push_back(0);
+
+    for(size_t i = 0; i < size; i++)
+    {
+        if(payload[i] == 0)
+        {
+            frame[codeIndex] = (char)code;
+            codeIndex = frame.size();
+            frame.push_back(0);
+            code = 1;
+            continue;
+        }
+
+        frame.push_back(payload[i]);
+        code++;
+
+        if(code == 0xFF)
+        {
+            frame[codeIndex] = (char)code;
+            codeIndex = frame.size();
+            frame.push_back(0);
+            code = 1;
+        }
+    }
+
+    frame[codeIndex] = (char)code;
+
+    if(frame.size() > _maxFrameSize)
+    {
+        return false;
+    }
+
+    frame.push_back(0);
+
+    return true;
+}
+
+bool CobsFramer::_decodePayload(char* payload, size_t &size) const
+{
+    size_t in = 0;
+    size_t out = 0;
+
+    // Decoded data is never longer than encoded data, so it is decoded in place.
+    while(in < size)
+    {
+        uint8_t code = (uint8_t)payload[in++];
+
+        if(code == 0)
+        {
+            return false;
+        }
+
+        for(uint8_t i = 1; i < code; i++)
+        {
+            if(in >= size)
+            {
+                return false;
+            }
+
+            payload[out++] = payload[in++];
+        }
+
+        if((code < 0xFF) && (in < size))
+        {
+            payload[out++] = 0;
+        }
+    }
+
+    size = out;
+
+    return true;
+}
+
+// ######################################################################################################
+// RecordFramer Class:
+
+RecordFramer::RecordFramer(Stream* stream, size_t maxFrameSize) : StreamFramer(stream, maxFrameSize)
+{
+    _resetState();
+}
+
+bool RecordFramer::encodeFrame(const char* payload, size_t size, std::string &frame) const
+{
+    if(size > _maxFrameSize)
+    {
+        return false;
+    }
+
+    char header[VARINT_MAX_SIZE];
+    size_t headerSize = encodeVarint(size, header);
+    // Header is in CRC too, so a zero length frame does not have a zero CRC.
+    uint32_t crc = crc32c(payload, size, crc32c(header, headerSize));
+
+    frame.assign(header, headerSize);
+    frame.append(payload, size);
+
+    for(int i = 0; i < 4; i++)
+    {
+        frame.push_back((char)((crc >> (8 * i)) & 0xFF));
+    }
+
+    return true;
+}
+
+bool RecordFramer::_findFrame(void)
+{
+    while(true)
+    {
+        size_t length = _stream->getRxBufferLength();
+        uint64_t readCount = _stream->getRxReadCount();
+
+        // Header of an incomplete frame is decoded only once. Removal from front of RX buffer makes it invalid.
+        if(!_headerValid || (_headerReadCount != readCount))
+        {
+            char header[VARINT_MAX_SIZE];
+            size_t count = _stream->peekFrontRxBuffer(header, sizeof(header));
+
+            uint64_t size;
+            size_t headerSize = decodeVarint(header, count, size);
+
+            if(headerSize == 0)
+            {
+                if(count < VARINT_MAX_SIZE)
+                {
+                    // Length header is not complete yet.
+                    return false;
+                }
+
+                _dropFront(1);
+                continue;
+            }
+
+            if(size > _maxFrameSize)
+            {
+                // Invalid length header. Drop one byte and try to find a valid header.
+                _dropFront(1);
+                continue;
+            }
+
+            _headerValid = true;
+            _headerReadCount = readCount;
+            _headerSize = headerSize;
+            _headerPayloadSize = (size_t)size;
+            _headerCrc = crc32c(header, headerSize);
+        }
+
+        size_t headerSize = _headerSize;
+        size_t size = _headerPayloadSize;
+
+        if(length < headerSize + size + 4)
+        {
+            return false;
+        }
+
+        // Frame is complete. Header is decoded again for the next frame.
+        _headerValid = false;
+
+        uint32_t crc = _headerCrc;
+        RingRegions<const char> payload = _stream->peekRx().subRegions(headerSize, size);
+
+        if(payload.size() == size)
+        {
+            crc = crc32c(payload.first.data(), payload.first.size(), crc);
+            crc = crc32c(payload.second.data(), payload.second.size(), crc);
+        }
+        else
+        {
+            // Deque backend is not contiguous.
+            _crcBuffer.resize(size);
+            _stream->peekFrontRxBuffer(_crcBuffer.data(), size, headerSize);
+            crc = crc32c(_crcBuffer.data(), size, crc);
+        }
+
+        uint8_t trailer[4];
+        _stream->peekFrontRxBuffer((char*)trailer, sizeof(trailer), headerSize + size);
+        uint32_t frameCrc = (uint32_t)trailer[0] | ((uint32_t)trailer[1] << 8) | ((uint32_t)trailer[2] << 16) | ((uint32_t)trailer[3] << 24);
+
+        if(crc != frameCrc)
+        {
+            _dropFront(1);
+            continue;
+        }
+
+        _payloadOffset = headerSize;
+        _payloadSize = size;
+        _frameSize = headerSize + size + 4;
+
+        return true;
+    }
+}
+
+void RecordFramer::_resetState(void)
+{
+    _headerValid = false;
+    _headerReadCount = 0;
+    _headerSize = 0;
+    _headerPayloadSize = 0;
+    _headerCrc = 0;
+}
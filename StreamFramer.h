@@ -0,0 +1,287 @@
+#pragma once
+
+// ####################################################################################################
+// Include libraries:
+
+#include <string>                   // String class and related functions
+#include <cstdint>                  // Fixed width integer types
+#include "Stream.h"                 // Stream class
+
+// ######################################################################################################
+// StreamFramer Class:
+
+/**
+ * @class StreamFramer
+ * @brief Base class for extracting complete frames from RX buffer of a Stream and pushing encoded frames to its TX buffer.
+ * @note Scan position is kept between calls, so data that arrives in fragments is scanned only once.
+ * It stays valid while data is removed from front of RX buffer by other functions or by overflow.
+ * @note On corrupted data or frames longer than max frame size the framer drops data until next frame boundary
+ * and increases error count.
+ */
+class StreamFramer
+{
+public:
+
+    /**
+     * @brief Constructor.
+     * @param stream: Stream pointer that framer is attached to.
+     * @param maxFrameSize: Max payload size of a frame.
+     */
+    StreamFramer(Stream* stream = nullptr, size_t maxFrameSize = 4096);
+
+    /**
+     * Destructor.
+     */
+    virtual ~StreamFramer();
+
+    /// @brief Attach framer to a stream and reset its state.
+    void setStream(Stream* stream);
+
+    /// @brief Set max payload size of a frame.
+    void setMaxFrameSize(size_t size);
+
+    /// @brief Reset scan state. Data in stream is not changed.
+    void reset(void);
+
+    /// @brief Return number of times that data is dropped for resynchronization.
+    uint32_t getErrorCount(void) const;
+
+    /**
+     * @brief Find next complete frame and get its raw payload as memory regions without copy.
+     * The frame is not removed. Call consumeFrame() after using payload.
+     * @note It is not a pure peek: corrupted data and too long frames before the next complete frame are removed
+     * from RX buffer for resynchronization.
+     * @note For SLIP/COBS framers the payload is still encoded. Use popFrame() to get decoded payload.
+     * @note It needs ring buffer backend. For deque backend payload regions are empty. Use popFrame() instead.
+     * @return true if a complete frame exists.
+     */
+    bool nextFrame(RingRegions<const char> &payload);
+
+    /// @brief Remove frame that is found by nextFrame() from RX buffer.
+    void consumeFrame(void);
+
+    /**
+     * @brief Find next complete frame, copy its decoded payload to string and remove frame from RX buffer.
+     * @param payload: Payload string. Its memory is reused, so a string that is passed on every call does not allocate
+     * after it reaches max frame size.
+     * @return true if a frame is popped.
+     */
+    bool popFrame(std::string &payload);
+
+    /**
+     * @brief Find next complete frame, copy its decoded payload to a pooled buffer and remove frame from RX buffer.
+     * @param payload: Payload buffer. Its previous block is released. It is empty if no frame is popped.
+     * @param pool: Pool of payload buffer. Steady state use does not allocate from heap.
+     * @return true if a frame is popped.
+     */
+    bool popFrame(PooledBuffer &payload, BufferPool &pool);
+
+    /**
+     * @brief Encode payload to a frame.
+     * @param frame: Encoded frame. Its previous content is replaced.
+     * @return true if succeeded. false if payload can not be framed. For example it is larger than max frame size.
+     */
+    virtual bool encodeFrame(const char* payload, size_t size, std::string &frame) const = 0;
+
+    /**
+     * @brief Encode payload to a frame and push it to TX buffer of stream.
+     * @return true if succeeded. false if payload can not be framed or whole frame does not fit in TX buffer.
+     */
+    bool pushFrame(const char* payload, size_t size);
+
+protected:
+
+    Stream* _stream;                    ///! @brief Attached stream pointer.
+    size_t _maxFrameSize;               ///! @brief Max payload size of a frame.
+    uint32_t _errorCount;               ///! @brief Number of resynchronizations.
+
+    size_t _scanPos;                    ///! @brief Number of characters from front of RX buffer that are scanned.
+    uint64_t _readCount;                ///! @brief RX read count of stream when _scanPos is updated.
+
+    bool _frameReady;                   ///! @brief True if a complete frame is found and not consumed yet.
+    size_t _payloadOffset;              ///! @brief Payload position of found frame from front of RX buffer.
+    size_t _payloadSize;                ///! @brief Payload size of found frame.
+    size_t _frameSize;                  ///! @brief Total size of found frame in RX buffer.
+
+    std::string _txFrame;               ///! @brief Reused buffer for encoding frames to push.
+
+    /**
+     * @brief Continue scan of RX buffer from _scanPos to find next complete frame.
+     * On success _payloadOffset, _payloadSize and _frameSize must be set.
+     * @return true if a complete frame is found.
+     */
+    virtual bool _findFrame(void) = 0;
+
+    /**
+     * @brief Decode raw payload in place. Decoded payload is never longer than raw payload.
+     * @param size: Raw payload size. It is changed to decoded payload size.
+     * @return true if succeeded. false if payload is corrupted.
+     */
+    virtual bool _decodePayload(char* payload, size_t &size) const;
+
+    /// @brief Remove certain number of characters from front of RX buffer for resynchronization.
+    void _dropFront(size_t size);
+
+    /// @brief Reset scan state of derived class. It is called by reset() after common state is reset.
+    virtual void _resetState(void);
+
+private:
+
+    /// @brief Update scan position if characters are removed from front of RX buffer since last call.
+    void _syncPosition(void);
+
+};
+
+// ######################################################################################################
+// DelimiterFramer Class:
+
+/**
+ * @class DelimiterFramer
+ * @brief Frames that end with a delimiter character. For example newline terminated text.
+ */
+class DelimiterFramer : public StreamFramer
+{
+public:
+
+    /**
+     * @brief Constructor.
+     * @param stream: Stream pointer that framer is attached to.
+     * @param delimiter: Frame end character. It is not part of payload.
+     * @param maxFrameSize: Max payload size of a frame.
+     */
+    DelimiterFramer(Stream* stream = nullptr, char delimiter = '\n', size_t maxFrameSize = 4096);
+
+    bool encodeFrame(const char* payload, size_t size, std::string &frame) const override;
+
+protected:
+
+    char _delimiter;                    ///! @brief Frame end character.
+    bool _skipEmptyFrames;              ///! @brief If true frames with empty payload are removed and not returned.
+    bool _discarding;                   ///! @brief True if the rest of a too long frame must be dropped.
+
+    bool _findFrame(void) override;
+
+    void _resetState(void) override;
+
+};
+
+// ######################################################################################################
+// LengthPrefixFramer Class:
+
+/**
+ * @class LengthPrefixFramer
+ * @brief Binary frames that start with payload length header.
+ */
+class LengthPrefixFramer : public StreamFramer
+{
+public:
+
+    /**
+     * @brief Constructor.
+     * @param stream: Stream pointer that framer is attached to.
+     * @param headerSize: Size of length header in bytes. It can be 1, 2 or 4.
+     * @param bigEndian: Byte order of length header.
+     * @param maxFrameSize: Max payload size of a frame.
+     */
+    LengthPrefixFramer(Stream* stream = nullptr, uint8_t headerSize = 2, bool bigEndian = true, size_t maxFrameSize = 4096);
+
+    bool encodeFrame(const char* payload, size_t size, std::string &frame) const override;
+
+protected:
+
+    uint8_t _headerSize;                ///! @brief Size of length header in bytes.
+    bool _bigEndian;                    ///! @brief Byte order of length header.
+
+    bool _findFrame(void) override;
+
+};
+
+// ######################################################################################################
+// SlipFramer Class:
+
+/**
+ * @class SlipFramer
+ * @brief SLIP (RFC 1055) frames. Payload is escaped and frame ends with END character (0xC0).
+ */
+class SlipFramer : public DelimiterFramer
+{
+public:
+
+    /**
+     * @brief Constructor.
+     * @param stream: Stream pointer that framer is attached to.
+     * @param maxFrameSize: Max encoded payload size of a frame.
+     */
+    SlipFramer(Stream* stream = nullptr, size_t maxFrameSize = 4096);
+
+    bool encodeFrame(const char* payload, size_t size, std::string &frame) const override;
+
+protected:
+
+    bool _decodePayload(char* payload, size_t &size) const override;
+
+};
+
+// ######################################################################################################
+// CobsFramer Class:
+
+/**
+ * @class CobsFramer
+ * @brief COBS (Consistent Overhead Byte Stuffing) frames. Payload is encoded without zero bytes and frame ends with zero.
+ */
+class CobsFramer : public DelimiterFramer
+{
+public:
+
+    /**
+     * @brief Constructor.
+     * @param stream: Stream pointer that framer is attached to.
+     * @param maxFrameSize: Max encoded payload size of a frame.
+     */
+    CobsFramer(Stream* stream = nullptr, size_t maxFrameSize = 4096);
+
+    bool encodeFrame(const char* payload, size_t size, std::string &frame) const override;
+
+protected:
+
+    bool _decodePayload(char* payload, size_t &size) const override;
+
+};
+
+// ######################################################################################################
+// RecordFramer Class:
+
+/**
+ * @class RecordFramer
+ * @brief Binary frames with varint payload length header and CRC-32C of header and payload after it.
+ * Frame: [varint length][payload][CRC-32C, 4 bytes little endian].
+ * @note A frame with wrong CRC or too long length is dropped byte by byte until a valid frame is found.
+ */
+class RecordFramer : public StreamFramer
+{
+public:
+
+    /**
+     * @brief Constructor.
+     * @param stream: Stream pointer that framer is attached to.
+     * @param maxFrameSize: Max payload size of a frame.
+     */
+    RecordFramer(Stream* stream = nullptr, size_t maxFrameSize = 4096);
+
+    bool encodeFrame(const char* payload, size_t size, std::string &frame) const override;
+
+protected:
+
+    std::string _crcBuffer;             ///! @brief Reused buffer for CRC check of deque backend.
+
+    bool _headerValid;                  ///! @brief True if header of the frame at front of RX buffer is decoded.
+    uint64_t _headerReadCount;          ///! @brief RX read count of stream when header is decoded.
+    size_t _headerSize;                 ///! @brief Size of decoded varint length header.
+    size_t _headerPayloadSize;          ///! @brief Payload size of decoded header.
+    uint32_t _headerCrc;                ///! @brief CRC-32C of decoded header.
+
+    bool _findFrame(void) override;
+
+    void _resetState(void) override;
+
+};
@@ -0,0 +1,212 @@
+// ####################################################################################################
+// Include libraries:
+
+#include "StreamMux.h"
+#include <algorithm>                // std::min, std::max
+
+// ######################################################################################################
+// StreamMux Class:
+
+StreamMux::StreamMux(Stream* link, size_t maxFrameSize) :
+    _maxFrameSize(std::max(maxFrameSize, (size_t)2)),
+    _framer(link, _maxFrameSize)
+{
+    _link = link;
+    _next = 0;
+    _visiting = false;
+    _errorCount = 0;
+}
+
+void StreamMux::setLink(Stream* link)
+{
+    _link = link;
+    _framer.setStream(link);
+}
+
+bool StreamMux::addChannel(uint8_t id, Stream* channel, uint32_t weight)
+{
+    if((channel == nullptr) || (weight == 0) || (_channels[id].stream != nullptr))
+    {
+        return false;
+    }
+
+    _channels[id] = {channel, weight, 0};
+    _order.push_back(id);
+
+    return true;
+}
+
+bool StreamMux::removeChannel(uint8_t id)
+{
+    if(_channels[id].stream == nullptr)
+    {
+        return false;
+    }
+
+    _channels[id] = Channel();
+
+    size_t position = std::find(_order.begin(), _order.end(), id) - _order.begin();
+    _order.erase(_order.begin() + position);
+
+    // Keep the channel that is scheduled now.
+    if(position < _next)
+    {
+        _next--;
+    }
+    else if(position == _next)
+    {
+        _visiting = false;
+    }
+
+    if(_next >= _order.size())
+    {
+        _next = 0;
+    }
+
+    return true;
+}
+
+bool StreamMux::setWeight(uint8_t id, uint32_t weight)
+{
+    if((_channels[id].stream == nullptr) || (weight == 0))
+    {
+        return false;
+    }
+
+    _channels[id].weight = weight;
+
+    return true;
+}
+
+size_t StreamMux::pollTx(void)
+{
+    if((_link == nullptr) || _order.empty())
+    {
+        return 0;
+    }
+
+    size_t sent = 0;
+    size_t idle = 0;
+
+    // Deficit round robin. Stop after a whole round without data or when link TX buffer is full.
+    while(idle < _order.size())
+    {
+        uint8_t id = _order[_next];
+        Channel &channel = _channels[id];
+
+        if(!_visiting)
+        {
+            channel.deficit += (size_t)channel.weight * STREAM_MUX_QUANTUM;
+            _visiting = true;
+        }
+
+        bool active = false;
+
+        while(channel.deficit > 0)
+        {
+            size_t pending = channel.stream->getTxBufferLength();
+
+            if(pending == 0)
+            {
+                // An empty channel does not keep its deficit for later bursts.
+                channel.deficit = 0;
+                break;
+            }
+
+            size_t size = std::min({pending, channel.deficit, _maxFrameSize - 1});
+
+            if(!_sendChunk(id, channel.stream, size))
+            {
+                // Continue with the same channel and deficit when link has space again.
+                return sent;
+            }
+
+            channel.deficit -= size;
+            sent += size;
+            active = true;
+        }
+
+        idle = active ? 0 : idle + 1;
+        _visiting = false;
+        _next = (_next + 1) % _order.size();
+    }
+
+    return sent;
+}
+
+size_t StreamMux::pollRx(void)
+{
+    if(_link == nullptr)
+    {
+        return 0;
+    }
+
+    size_t count = 0;
+    RingRegions<const char> payload;
+
+    while(_framer.nextFrame(payload))
+    {
+        if(!payload.empty())
+        {
+            // Ring buffer backend: route payload directly from link RX.
+            _route(payload);
+            _framer.consumeFrame();
+        }
+        else
+        {
+            // Deque backend or empty payload.
+            _framer.popFrame(_rxPayload);
+            _route({{_rxPayload.data(), _rxPayload.size()}, {}});
+        }
+
+        count++;
+    }
+
+    return count;
+}
+
+uint32_t StreamMux::getErrorCount(void) const
+{
+    return _errorCount + _framer.getErrorCount();
+}
+
+bool StreamMux::_sendChunk(uint8_t id, Stream* channel, size_t size)
+{
+    // Frame: varint length, channel id, data, CRC-32C.
+    char header[VARINT_MAX_SIZE];
+    size_t frameSize = encodeVarint(size + 1, header) + size + 1 + 4;
+
+    if(frameSize > _link->getTxFreeSpace())
+    {
+        return false;
+    }
+
+    _txPayload.resize(size + 1);
+    _txPayload[0] = (char)id;
+    channel->tryPopFrontTxBuffer(_txPayload.data() + 1, size);
+
+    return _framer.pushFrame(_txPayload.data(), _txPayload.size());
+}
+
+void StreamMux::_route(RingRegions<const char> payload)
+{
+    Stream* channel = payload.empty() ? nullptr : _channels[(uint8_t)payload.first[0]].stream;
+
+    if(channel == nullptr)
+    {
+        _errorCount++;
+        return;
+    }
+
+    RingRegions<const char> data = payload.subRegions(1);
+
+    if(!data.first.empty())
+    {
+        channel->pushBackRxBuffer(data.first.data(), data.first.size());
+    }
+
+    if(!data.second.empty())
+    {
+        channel->pushBackRxBuffer(data.second.data(), data.second.size());
+    }
+}
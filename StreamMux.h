@@ -0,0 +1,131 @@
+#pragma once
+
+// ####################################################################################################
+// Include libraries:
+
+#include <array>                    // Channel table
+#include <string>                   // Reused frame buffers
+#include <vector>                   // Scheduling order
+#include "Stream.h"                 // Stream class
+#include "StreamFramer.h"           // RecordFramer
+
+// ####################################################################################################
+// Public macros:
+
+/// @brief Bytes that a channel with weight 1 may send in one round of TX scheduling.
+#define STREAM_MUX_QUANTUM                  256
+
+// ######################################################################################################
+// StreamMux Class:
+
+/**
+ * @class StreamMux
+ * @brief Many logical channels over one physical link stream.
+ * Each channel is a Stream object. Application pushes channel data to its TX buffer and pops received data from its
+ * RX buffer, like a stream of its own. Size and overflow policy of channel buffers are channel stream settings.
+ * Link frame: RecordFramer frame with payload [channel id][data], so each frame has CRC-32C.
+ * @note pollTx() moves data from channel TX buffers to link TX buffer with deficit round robin (DRR) scheduling.
+ * In each round a channel may send up to weight * STREAM_MUX_QUANTUM bytes, so a bulk channel can not starve
+ * a control channel on a saturated link. Data that is already in link TX buffer is not reordered, so keep link TX
+ * buffer small (a few frames) for low latency of high priority channels.
+ * @note pollRx() routes link RX frames directly into RX buffers of channel streams. For ring buffer link RX,
+ * payload is copied only once, from link RX to channel RX.
+ * @note Link TX buffer must only be written by the mux, so a frame that fits is never rejected.
+ * @note Channel data is a byte stream. Data of one push can be split to more frames and it is joined again in channel RX.
+ *
+ * Example:
+ * @code
+ * StreamMux mux(&serial);
+ * mux.addChannel(0, &control, 4);          // Control channel has 4x share of link.
+ * mux.addChannel(1, &bulk, 1);
+ * // Event loop:
+ * serial.fillRx(fd); mux.pollRx();
+ * mux.pollTx(); serial.flushTx(fd);
+ * @endcode
+ */
+class StreamMux
+{
+public:
+
+    /**
+     * @brief Constructor.
+     * @param link: Physical link stream.
+     * @param maxFrameSize: Max payload size of link frames including channel id. Values below 2 are taken as 2.
+     */
+    StreamMux(Stream* link = nullptr, size_t maxFrameSize = 1024);
+
+    /// @brief Set physical link stream. Link frame state is reset.
+    void setLink(Stream* link);
+
+    /**
+     * @brief Add a logical channel.
+     * @param id: Channel id in link frames.
+     * @param channel: Channel stream. Its TX buffer is sent and its RX buffer receives channel data.
+     * @param weight: Share of link bandwidth. It must be at least 1.
+     * @return true if succeeded. false if id is already used, channel is nullptr or weight is 0.
+     */
+    bool addChannel(uint8_t id, Stream* channel, uint32_t weight = 1);
+
+    /**
+     * @brief Remove a logical channel. Frames of its id are dropped after it.
+     * @return true if succeeded. false if id is not used.
+     */
+    bool removeChannel(uint8_t id);
+
+    /**
+     * @brief Set share of link bandwidth of a channel.
+     * @return true if succeeded. false if id is not used or weight is 0.
+     */
+    bool setWeight(uint8_t id, uint32_t weight);
+
+    /**
+     * @brief Move data from channel TX buffers to link TX buffer as frames until link TX buffer is full or all
+     * channel TX buffers are empty.
+     * @return Number of channel data characters that are sent.
+     */
+    size_t pollTx(void);
+
+    /**
+     * @brief Route all complete frames of link RX buffer to RX buffers of channels.
+     * Channel RX overflow policy decides what happens with data that does not fit.
+     * @return Number of routed frames.
+     */
+    size_t pollRx(void);
+
+    /// @brief Return number of dropped link frames: corrupted frames and frames of unknown channels.
+    uint32_t getErrorCount(void) const;
+
+private:
+
+    /**
+     * @struct Channel
+     * @brief Logical channel state.
+     */
+    struct Channel
+    {
+        Stream* stream = nullptr;       ///! @brief Channel stream. nullptr if id is not used.
+        uint32_t weight = 1;            ///! @brief Share of link bandwidth.
+        size_t deficit = 0;             ///! @brief Bytes that channel may still send in current round.
+    };
+
+    Stream* _link;                      ///! @brief Physical link stream.
+    size_t _maxFrameSize;               ///! @brief Max payload size of link frames. At least 2: channel id and data.
+    RecordFramer _framer;               ///! @brief Framer of link. It is initialized after _maxFrameSize.
+    std::array<Channel, 256> _channels; ///! @brief Channels by id.
+    std::vector<uint8_t> _order;        ///! @brief Ids of channels in round robin order.
+    size_t _next;                       ///! @brief Position in _order of channel that is scheduled now.
+    bool _visiting;                     ///! @brief True if quantum of current channel is already added in this round.
+    std::string _txPayload;             ///! @brief Reused payload buffer of TX frames.
+    std::string _rxPayload;             ///! @brief Reused payload buffer of RX frames for deque link backend.
+    uint32_t _errorCount;               ///! @brief Number of dropped link frames of unknown channels.
+
+    /**
+     * @brief Send one chunk of channel TX data as a link frame.
+     * @return true if succeeded. false if frame does not fit in link TX buffer.
+     */
+    bool _sendChunk(uint8_t id, Stream* channel, size_t size);
+
+    /// @brief Route a received payload to its channel.
+    void _route(RingRegions<const char> payload);
+
+};
@@ -0,0 +1,383 @@
+// ####################################################################################################
+// Include libraries:
+
+#include "StreamPump.h"
+#include <fcntl.h>                  // fcntl, O_NONBLOCK
+#include <sys/epoll.h>              // epoll
+#include <sys/eventfd.h>            // eventfd
+#include <sys/stat.h>               // fstat, S_ISSOCK
+
+// ######################################################################################################
+// StreamPump Class:
+
+StreamPump::StreamPump()
+{
+    _running = false;
+    _epollFd = epoll_create1(EPOLL_CLOEXEC);
+    _wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+    if((_epollFd >= 0) && (_wakeFd >= 0))
+    {
+        epoll_event event = {};
+        event.events = EPOLLIN;
+        event.data.fd = _wakeFd;
+        epoll_ctl(_epollFd, EPOLL_CTL_ADD, _wakeFd, &event);
+    }
+}
+
+StreamPump::~StreamPump()
+{
+    if(_wakeFd >= 0)
+    {
+        close(_wakeFd);
+    }
+
+    if(_epollFd >= 0)
+    {
+        close(_epollFd);
+    }
+}
+
+bool StreamPump::add(int fd, Stream* stream, DataCallback onData, CloseCallback onClose)
+{
+    if((stream == nullptr) || (_entries.count(fd) > 0))
+    {
+        errno = EINVAL;
+        return false;
+    }
+
+    int flags = fcntl(fd, F_GETFL);
+    struct stat status;
+
+    if((flags < 0) || (fcntl(fd, F_SETFL, flags | O_NONBLOCK) < 0) || (fstat(fd, &status) != 0))
+    {
+        return false;
+    }
+
+    auto entry = std::make_unique<Entry>();
+    entry->stream = stream;
+    entry->onData = std::move(onData);
+    entry->onClose = std::move(onClose);
+    entry->events = EPOLLIN;
+    entry->socket = S_ISSOCK(status.st_mode);
+    entry->hangup = false;
+
+    epoll_event event = {};
+    event.events = entry->events;
+    event.data.fd = fd;
+
+    if(epoll_ctl(_epollFd, EPOLL_CTL_ADD, fd, &event) != 0)
+    {
+        return false;
+    }
+
+    _entries[fd] = std::move(entry);
+
+    return true;
+}
+
+bool StreamPump::remove(int fd)
+{
+    auto found = _entries.find(fd);
+
+    if(found == _entries.end())
+    {
+        return false;
+    }
+
+    epoll_ctl(_epollFd, EPOLL_CTL_DEL, fd, nullptr);
+    _entries.erase(found);
+
+    return true;
+}
+
+size_t StreamPump::size(void) const
+{
+    return _entries.size();
+}
+
+int StreamPump::poll(int timeout)
+{
+    // Write TX data that is pushed since last poll. Descriptors that can not take all of it wait for output event.
+    std::vector<std::pair<int, int>> failed;
+    std::vector<int> drained;
+    bool stalled = false;
+
+    for(auto &[fd, entry] : _entries)
+    {
+        // Hung up descriptor is not in epoll. Its rest is read when consumer has made space in RX buffer.
+        if(entry->hangup)
+        {
+            if(entry->stream->getRxFreeSpace() > 0)
+            {
+                drained.push_back(fd);
+            }
+
+            stalled = true;
+            continue;
+        }
+
+        int error = _write(fd, *entry);
+
+        if(error != 0)
+        {
+            failed.emplace_back(fd, error);
+            continue;
+        }
+
+        _updateEvents(fd, *entry);
+
+        if((entry->events & EPOLLIN) == 0)
+        {
+            stalled = true;
+        }
+    }
+
+    for(auto [fd, error] : failed)
+    {
+        _close(fd, (error < 0) ? 0 : error);
+    }
+
+    for(int fd : drained)
+    {
+        _drain(fd);
+    }
+
+    // Nothing wakes the pump when consumer of other thread makes space in full RX buffer without wakeup().
+    if(stalled && ((timeout < 0) || (timeout > STREAM_PUMP_STALL_TIMEOUT)))
+    {
+        timeout = STREAM_PUMP_STALL_TIMEOUT;
+    }
+
+    epoll_event events[STREAM_PUMP_MAX_EVENTS];
+    int count = epoll_wait(_epollFd, events, STREAM_PUMP_MAX_EVENTS, timeout);
+
+    if(count < 0)
+    {
+        return (errno == EINTR) ? 0 : -1;
+    }
+
+    for(int i = 0; i < count; i++)
+    {
+        int fd = events[i].data.fd;
+
+        if(fd == _wakeFd)
+        {
+            uint64_t value;
+            while(read(_wakeFd, &value, sizeof(value)) > 0);
+            continue;
+        }
+
+        // A callback of previous event can remove the descriptor.
+        auto found = _entries.find(fd);
+
+        if(found == _entries.end())
+        {
+            continue;
+        }
+
+        Entry* entry = found->second.get();
+        int error = 0;
+
+        if(events[i].events & EPOLLOUT)
+        {
+            error = _write(fd, *entry);
+        }
+
+        if((error == 0) && (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)))
+        {
+            bool received = false;
+            error = _read(fd, *entry, received);
+
+            if(received && entry->onData)
+            {
+                entry->onData(*entry->stream, fd);
+
+                found = _entries.find(fd);
+                if(found == _entries.end())
+                {
+                    continue;
+                }
+                entry = found->second.get();
+            }
+        }
+
+        if(error != 0)
+        {
+            _close(fd, (error < 0) ? 0 : error);
+            continue;
+        }
+
+        // Hang up without end of file means RX buffer is full. epoll reports hang up even if no event is watched,
+        // so the descriptor leaves epoll and close callback waits until its rest is read.
+        if(events[i].events & (EPOLLHUP | EPOLLERR))
+        {
+            epoll_ctl(_epollFd, EPOLL_CTL_DEL, fd, nullptr);
+            entry->events = 0;
+            entry->hangup = true;
+            continue;
+        }
+
+        _updateEvents(fd, *entry);
+    }
+
+    return count;
+}
+
+void StreamPump::run(void)
+{
+    _running = true;
+
+    while(_running)
+    {
+        if((poll(-1) < 0) && (errno != EINTR))
+        {
+            break;
+        }
+    }
+}
+
+void StreamPump::stop(void)
+{
+    _running = false;
+    wakeup();
+}
+
+void StreamPump::wakeup(void)
+{
+    uint64_t value = 1;
+    ssize_t written = write(_wakeFd, &value, sizeof(value));
+    (void)written;
+}
+
+int StreamPump::_read(int fd, Entry &entry, bool &received)
+{
+    while(true)
+    {
+        ssize_t size = entry.stream->fillRx(fd);
+
+        if(size > 0)
+        {
+            received = true;
+            continue;
+        }
+
+        if(size == 0)
+        {
+            return -1;
+        }
+
+        // Full RX buffer is not a failure. Input event is disabled until consumer makes space.
+        if((errno == EAGAIN) || (errno == EWOULDBLOCK) || (errno == ENOBUFS))
+        {
+            return 0;
+        }
+
+        // Closed pty reports EIO instead of end of file.
+        return (errno == EIO) ? -1 : errno;
+    }
+}
+
+int StreamPump::_write(int fd, Entry &entry)
+{
+    if(entry.stream->getTxBufferLength() == 0)
+    {
+        return 0;
+    }
+
+    ssize_t written = entry.socket ? entry.stream->sendTx(fd) : entry.stream->flushTx(fd);
+
+    if(written < 0)
+    {
+        return (errno == EPIPE) ? -1 : errno;
+    }
+
+    return 0;
+}
+
+void StreamPump::_updateEvents(int fd, Entry &entry)
+{
+    uint32_t events = 0;
+
+    if(entry.stream->getRxFreeSpace() > 0)
+    {
+        events |= EPOLLIN;
+    }
+
+    if(entry.stream->getTxBufferLength() > 0)
+    {
+        events |= EPOLLOUT;
+    }
+
+    if(events == entry.events)
+    {
+        return;
+    }
+
+    epoll_event event = {};
+    event.events = events;
+    event.data.fd = fd;
+    epoll_ctl(_epollFd, EPOLL_CTL_MOD, fd, &event);
+    entry.events = events;
+}
+
+void StreamPump::_drain(int fd)
+{
+    while(true)
+    {
+        auto found = _entries.find(fd);
+
+        // Callback can remove the descriptor or register it again.
+        if((found == _entries.end()) || !found->second->hangup)
+        {
+            return;
+        }
+
+        Entry* entry = found->second.get();
+        bool received = false;
+        int error = _read(fd, *entry, received);
+
+        if(received && entry->onData)
+        {
+            entry->onData(*entry->stream, fd);
+
+            found = _entries.find(fd);
+            if((found == _entries.end()) || !found->second->hangup)
+            {
+                return;
+            }
+        }
+
+        if(error != 0)
+        {
+            _close(fd, (error < 0) ? 0 : error);
+            return;
+        }
+
+        // RX buffer is full again. Wait for consumer.
+        if(!received)
+        {
+            return;
+        }
+    }
+}
+
+void StreamPump::_close(int fd, int error)
+{
+    auto found = _entries.find(fd);
+
+    if(found == _entries.end())
+    {
+        return;
+    }
+
+    // Keep entry alive for callback. Callback can add a new descriptor with the same number.
+    std::unique_ptr<Entry> entry = std::move(found->second);
+    epoll_ctl(_epollFd, EPOLL_CTL_DEL, fd, nullptr);
+    _entries.erase(found);
+
+    if(entry->onClose)
+    {
+        entry->onClose(*entry->stream, fd, error);
+    }
+}
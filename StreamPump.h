@@ -0,0 +1,144 @@
+#pragma once
+
+// ####################################################################################################
+// Include libraries:
+
+#include <atomic>                   // Stop flag
+#include <functional>               // Stream callbacks
+#include <memory>                   // std::unique_ptr
+#include <unordered_map>            // Registered file descriptors
+#include <vector>                   // Pending close and drain lists
+#include "Stream.h"                 // Stream class
+
+// ####################################################################################################
+// Public macros:
+
+/// @brief Max number of epoll events that are handled by one poll() call.
+#define STREAM_PUMP_MAX_EVENTS              64
+
+/// @brief Max wait time of poll() in milliseconds while a stream has full RX buffer and its input is not watched.
+#define STREAM_PUMP_STALL_TIMEOUT           10
+
+// ######################################################################################################
+// StreamPump Class:
+
+/**
+ * @class StreamPump
+ * @brief Event driven I/O for many streams from one thread with epoll.
+ * Each registered file descriptor is bound to a stream. When a descriptor is readable its data is read into RX buffer
+ * of stream with fillRx() and data callback is called. TX buffer is written with flushTx() and if the descriptor
+ * can not take all of it, the rest is written when the descriptor becomes writable.
+ * @note Descriptors are set to non-blocking mode. They are not closed by the pump.
+ * @note Callbacks run in the thread that calls poll()/run(). If other threads push to TX buffers, enable SPSC or
+ * MPSC mode of the streams and call wakeup() so the pump writes new TX data without waiting for next event.
+ * @note Input of a stream with full RX buffer is not watched until consumer makes space. If consumer pops RX data
+ * from another thread, call wakeup() after it. Otherwise the pump checks full streams every STREAM_PUMP_STALL_TIMEOUT
+ * milliseconds. Hang up of such descriptor is reported by close callback after RX data before it is read.
+ * @note Sockets are written with MSG_NOSIGNAL. Pipes and FIFOs raise SIGPIPE when their reader is closed, so ignore
+ * SIGPIPE in the process if they are registered.
+ * @note Use one pump per thread to spread many descriptors over a few threads.
+ */
+class StreamPump
+{
+public:
+
+    /**
+     * @brief Data callback. It is called after new data is read into RX buffer of stream.
+     * @param stream: Stream of descriptor.
+     * @param fd: File descriptor.
+     */
+    using DataCallback = std::function<void(Stream &stream, int fd)>;
+
+    /**
+     * @brief Close callback. It is called once when descriptor reaches end of file, hangs up or fails.
+     * The descriptor is already removed from the pump.
+     * @param error: errno value of the failure. 0 for end of file or hang up.
+     */
+    using CloseCallback = std::function<void(Stream &stream, int fd, int error)>;
+
+    /**
+     * @brief Constructor. Create epoll instance and wakeup event.
+     */
+    StreamPump();
+
+    /**
+     * Destructor. Close epoll instance and wakeup event. Registered descriptors are not closed.
+     */
+    ~StreamPump();
+
+    StreamPump(const StreamPump&) = delete;
+    StreamPump& operator=(const StreamPump&) = delete;
+
+    /**
+     * @brief Register a file descriptor with its stream.
+     * @param fd: File descriptor. For example serial port, socket, pipe or pty. It is set to non-blocking mode.
+     * @param stream: Stream pointer. It must be valid until fd is removed.
+     * @param onData: Data callback. It can be empty.
+     * @param onClose: Close callback. It can be empty.
+     * @return true if succeeded. false if fd is already registered or epoll fails, errno is set.
+     */
+    bool add(int fd, Stream* stream, DataCallback onData, CloseCallback onClose = nullptr);
+
+    /**
+     * @brief Unregister a file descriptor. It can be called from callbacks.
+     * @return true if succeeded. false if fd is not registered.
+     */
+    bool remove(int fd);
+
+    /// @brief Return number of registered file descriptors.
+    size_t size(void) const;
+
+    /**
+     * @brief Write pending TX data of all streams and wait for events once and handle them.
+     * @param timeout: Max wait time in milliseconds. -1 waits until an event happens.
+     * @return Number of handled events. -1 if epoll fails, errno is set.
+     */
+    int poll(int timeout);
+
+    /// @brief Call poll() until stop() is called.
+    void run(void);
+
+    /// @brief Make run() return. It can be called from any thread.
+    void stop(void);
+
+    /// @brief Make a waiting poll() return to write new TX data or watch input again. It can be called from any thread.
+    void wakeup(void);
+
+private:
+
+    /**
+     * @struct Entry
+     * @brief Registered file descriptor.
+     */
+    struct Entry
+    {
+        Stream* stream;                 ///! @brief Stream of file descriptor.
+        DataCallback onData;            ///! @brief Data callback.
+        CloseCallback onClose;          ///! @brief Close callback.
+        uint32_t events;                ///! @brief Current epoll events of file descriptor.
+        bool socket;                    ///! @brief Descriptor is a socket. TX is written with sendTx().
+        bool hangup;                    ///! @brief Hang up with full RX buffer. Descriptor is out of epoll until RX drains.
+    };
+
+    int _epollFd;                       ///! @brief epoll instance.
+    int _wakeFd;                        ///! @brief eventfd for wakeup() and stop().
+    std::atomic<bool> _running;         ///! @brief False after stop() is called.
+
+    std::unordered_map<int, std::unique_ptr<Entry>> _entries;   ///! @brief Registered file descriptors.
+
+    /// @brief Read descriptor until it would block or RX buffer is full. Return errno of failure, -1 for end of file.
+    int _read(int fd, Entry &entry, bool &received);
+
+    /// @brief Write TX buffer of stream. Return errno of failure, -1 if peer is closed or 0.
+    int _write(int fd, Entry &entry);
+
+    /// @brief Change epoll events of descriptor to need of its stream: input if RX has space and output if TX has data.
+    void _updateEvents(int fd, Entry &entry);
+
+    /// @brief Read rest of hung up descriptor after consumer made space in RX buffer. Close it at end of file.
+    void _drain(int fd);
+
+    /// @brief Remove descriptor and call its close callback.
+    void _close(int fd, int error);
+
+};
@@ -0,0 +1,163 @@
+#pragma once
+
+// ####################################################################################################
+// Include libraries:
+
+#include <array>                    // Fixed size array container
+#include <string>                   // String class and related functions
+#include <string_view>              // Non-owning string views
+#include <tuple>                    // Tuple container for decoded rows
+#include <type_traits>              // Compile time type checks
+#include <utility>                  // std::index_sequence
+#include "Stream.h"                 // parseValue, nextToken
+
+// ######################################################################################################
+// Schema type functions:
+
+/**
+ * @ingroup public_general_functions
+ * @brief Return true if type is supported as a Schema column type.
+ */
+template<typename T>
+constexpr bool isSchemaType(void)
+{
+    return std::is_same_v<T, uint8_t> || std::is_same_v<T, uint16_t> || std::is_same_v<T, uint32_t> || std::is_same_v<T, uint64_t> ||
+           std::is_same_v<T, int8_t> || std::is_same_v<T, int16_t> || std::is_same_v<T, int32_t> || std::is_same_v<T, int64_t> ||
+           std::is_same_v<T, float> || std::is_same_v<T, double> || std::is_same_v<T, bool> ||
+           std::is_same_v<T, std::string_view> || std::is_same_v<T, std::string>;
+}
+
+/**
+ * @ingroup public_general_functions
+ * @brief Return checkValuetype() type name of a Schema column type. For example "uint16" for uint16_t.
+ */
+template<typename T>
+constexpr std::string_view schemaTypeName(void)
+{
+    if constexpr (std::is_same_v<T, uint8_t>) return "uint8";
+    else if constexpr (std::is_same_v<T, uint16_t>) return "uint16";
+    else if constexpr (std::is_same_v<T, uint32_t>) return "uint32";
+    else if constexpr (std::is_same_v<T, uint64_t>) return "uint64";
+    else if constexpr (std::is_same_v<T, int8_t>) return "int8";
+    else if constexpr (std::is_same_v<T, int16_t>) return "int16";
+    else if constexpr (std::is_same_v<T, int32_t>) return "int32";
+    else if constexpr (std::is_same_v<T, int64_t>) return "int64";
+    else if constexpr (std::is_same_v<T, float>) return "float";
+    else if constexpr (std::is_same_v<T, double>) return "double";
+    else if constexpr (std::is_same_v<T, bool>) return "bool";
+    else return "string";
+}
+
+// ######################################################################################################
+// Schema Class:
+
+/**
+ * @class Schema
+ * @brief Compile time row schema. It splits, validates and decodes a delimited row in one pass.
+ * Column types are checked at compile time, so there is no type name dispatch at runtime.
+ * @tparam Types Column types. Supported types: uint8_t, uint16_t, uint32_t, uint64_t, int8_t, int16_t, int32_t, int64_t,
+ * float, double, bool, std::string_view and std::string.
+ * @note A row is valid with the same rules as splitString() + validateRow() + checkValuetype():
+ * The row has exactly one field per column, no field is empty after trim and every field is valid for its type.
+ * @note std::string_view fields point to memory of the decoded line.
+ *
+ * Example:
+ * @code
+ * using TelemetrySchema = Schema<uint16_t, float, bool, std::string_view>;
+ * TelemetrySchema::Row row;
+ * if(TelemetrySchema::decode("12, 3.5, true, GPS", ',', row)) { ... }
+ * @endcode
+ */
+template<typename... Types>
+class Schema
+{
+public:
+
+    /// @brief Decoded row type.
+    using Row = std::tuple<Types...>;
+
+    /// @brief Number of columns.
+    static constexpr size_t columnCount = sizeof...(Types);
+
+    static_assert(columnCount > 0, "Schema needs at least one column.");
+    static_assert((isSchemaType<Types>() && ...), "Schema column type is not supported. Supported types: uint8_t...uint64_t, int8_t...int64_t, float, double, bool, std::string_view, std::string.");
+
+    /// @brief Column type names as used by checkValuetype(). For example "uint16".
+    static constexpr std::array<std::string_view, columnCount> typeNames = {schemaTypeName<Types>()...};
+
+    /**
+     * @brief Split, validate and decode a row in one pass.
+     * @param line: Row string.
+     * @param delimiter: Column delimiter character.
+     * @param row: Decoded row. Its content is undefined if decode failed.
+     * @return true if row is valid.
+     */
+    static bool decode(std::string_view line, char delimiter, Row &row)
+    {
+        size_t position = 0;
+        return _decode(line, delimiter, position, row, std::index_sequence_for<Types...>{});
+    }
+
+    /**
+     * @brief Split, validate and decode a row in one pass to a user struct.
+     * @tparam T Struct type that can be constructed from column values in order. For example an aggregate with same
+     * member types as columns.
+     * @return true if row is valid. out is changed only if row is valid.
+     */
+    template<typename T>
+    static bool decodeTo(std::string_view line, char delimiter, T &out)
+    {
+        Row row;
+
+        if(!decode(line, delimiter, row))
+        {
+            return false;
+        }
+
+        out = std::make_from_tuple<T>(std::move(row));
+        return true;
+    }
+
+    /**
+     * @brief Validate a row without keeping decoded values.
+     * @return true if row is valid.
+     */
+    static bool validate(std::string_view line, char delimiter)
+    {
+        Row row;
+        return decode(line, delimiter, row);
+    }
+
+private:
+
+    /// @brief Decode all columns in order. It stops at first invalid column.
+    template<size_t... I>
+    static bool _decode(std::string_view line, char delimiter, size_t &position, Row &row, std::index_sequence<I...>)
+    {
+        // Row is valid only if there is no token after last column. Same as tokens of splitString().
+        return (_decodeField(line, delimiter, position, std::get<I>(row)) && ...) && (position >= line.size());
+    }
+
+    /// @brief Get next token from position and decode it.
+    template<typename T>
+    static bool _decodeField(std::string_view line, char delimiter, size_t &position, T &value)
+    {
+        std::string_view token;
+
+        if(!nextToken(line, delimiter, position, token) || token.empty())
+        {
+            return false;
+        }
+
+        if constexpr (std::is_same_v<T, std::string>)
+        {
+            value.assign(token.data(), token.size());
+            return true;
+        }
+        else
+        {
+            return parseValue(token, value);
+        }
+    }
+
+};
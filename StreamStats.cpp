@@ -0,0 +1,200 @@
+// ####################################################################################################
+// Include libraries:
+
+#include "StreamStats.h"
+#include <algorithm>                // std::min, std::max
+#include <bit>                      // std::bit_width for latency buckets
+
+// ####################################################################################################
+// Private functions:
+
+/// @brief Append statistics of one direction as text lines.
+static void appendText(std::string &text, const char* name, const StreamDirectionStats &stats)
+{
+    text += name;
+    text += ": in=" + std::to_string(stats.bytesIn);
+    text += " out=" + std::to_string(stats.bytesOut);
+    text += " dropped=" + std::to_string(stats.bytesDropped);
+    text += " pushes=" + std::to_string(stats.pushCount);
+    text += " pops=" + std::to_string(stats.popCount);
+    text += " fill=" + std::to_string(stats.currentFill);
+    text += " peak=" + std::to_string(stats.peakFill);
+    text += '\n';
+
+    if(stats.latencyCount == 0)
+    {
+        return;
+    }
+
+    text += name;
+    text += " latency: samples=" + std::to_string(stats.latencyCount) + '\n';
+
+    // Only non empty buckets. Bucket i is [2^i, 2^(i+1)) nanoseconds.
+    for(size_t i = 0; i < STREAM_STATS_LATENCY_BUCKETS; i++)
+    {
+        if(stats.latencyHistogram[i] > 0)
+        {
+            text += "  <" + std::to_string(1ULL << (i + 1)) + "ns: " + std::to_string(stats.latencyHistogram[i]) + '\n';
+        }
+    }
+}
+
+/// @brief Append statistics of one direction as a JSON object.
+static void appendJson(std::string &json, const StreamDirectionStats &stats)
+{
+    json += "{\"bytesIn\":" + std::to_string(stats.bytesIn);
+    json += ",\"bytesOut\":" + std::to_string(stats.bytesOut);
+    json += ",\"bytesDropped\":" + std::to_string(stats.bytesDropped);
+    json += ",\"pushCount\":" + std::to_string(stats.pushCount);
+    json += ",\"popCount\":" + std::to_string(stats.popCount);
+    json += ",\"currentFill\":" + std::to_string(stats.currentFill);
+    json += ",\"peakFill\":" + std::to_string(stats.peakFill);
+    json += ",\"latencyCount\":" + std::to_string(stats.latencyCount);
+    json += ",\"latencyHistogram\":[";
+
+    for(size_t i = 0; i < STREAM_STATS_LATENCY_BUCKETS; i++)
+    {
+        if(i > 0)
+        {
+            json += ',';
+        }
+        json += std::to_string(stats.latencyHistogram[i]);
+    }
+
+    json += "]}";
+}
+
+// ######################################################################################################
+// StreamStatsSnapshot Struct:
+
+std::string StreamStatsSnapshot::toText(void) const
+{
+    if(!enabled)
+    {
+        return "stats disabled\n";
+    }
+
+    std::string text;
+    appendText(text, "tx", tx);
+    appendText(text, "rx", rx);
+
+    return text;
+}
+
+std::string StreamStatsSnapshot::toJson(void) const
+{
+    std::string json = "{\"enabled\":";
+    json += enabled ? "true" : "false";
+    json += ",\"tx\":";
+    appendJson(json, tx);
+    json += ",\"rx\":";
+    appendJson(json, rx);
+    json += '}';
+
+    return json;
+}
+
+// ######################################################################################################
+// StreamStatsCounter Class:
+
+void StreamStatsCounter::setLatency(bool enable)
+{
+    _latency.store(enable, std::memory_order_relaxed);
+}
+
+void StreamStatsCounter::setShared(bool enable)
+{
+    _shared.store(enable, std::memory_order_relaxed);
+}
+
+void StreamStatsCounter::snapshot(StreamDirectionStats &stats) const
+{
+    stats.bytesIn = _bytesIn.load(std::memory_order_relaxed);
+    stats.bytesOut = _bytesOut.load(std::memory_order_relaxed);
+    stats.bytesDropped = _bytesDropped.load(std::memory_order_relaxed);
+    stats.pushCount = _pushCount.load(std::memory_order_relaxed);
+    stats.popCount = _popCount.load(std::memory_order_relaxed);
+    stats.peakFill = _peakFill.load(std::memory_order_relaxed);
+    stats.latencyCount = _latencyCount.load(std::memory_order_relaxed);
+
+    for(size_t i = 0; i < STREAM_STATS_LATENCY_BUCKETS; i++)
+    {
+        stats.latencyHistogram[i] = _histogram[i].load(std::memory_order_relaxed);
+    }
+}
+
+void StreamStatsCounter::reset(void)
+{
+    _bytesIn.store(0, std::memory_order_relaxed);
+    _bytesDropped.store(0, std::memory_order_relaxed);
+    _pushCount.store(0, std::memory_order_relaxed);
+    _peakFill.store(0, std::memory_order_relaxed);
+    _bytesOut.store(0, std::memory_order_relaxed);
+    _popCount.store(0, std::memory_order_relaxed);
+    _latencyCount.store(0, std::memory_order_relaxed);
+
+    for(auto &bucket : _histogram)
+    {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+
+    // Positions start again from zero, so old marks are not valid.
+    _readPosition = 0;
+    _markHead.store(0, std::memory_order_relaxed);
+    _markTail.store(0, std::memory_order_relaxed);
+}
+
+void StreamStatsCounter::_pushShared(size_t stored, size_t rejected, size_t fill)
+{
+    _bytesDropped.fetch_add(rejected, std::memory_order_relaxed);
+
+    if(stored == 0)
+    {
+        return;
+    }
+
+    _bytesIn.fetch_add(stored, std::memory_order_relaxed);
+    _pushCount.fetch_add(1, std::memory_order_relaxed);
+
+    size_t peak = _peakFill.load(std::memory_order_relaxed);
+    while((fill > peak) && !_peakFill.compare_exchange_weak(peak, fill, std::memory_order_relaxed))
+    {
+    }
+}
+
+void StreamStatsCounter::_mark(uint64_t position)
+{
+    uint32_t tail = _markTail.load(std::memory_order_relaxed);
+
+    if(tail - _markHead.load(std::memory_order_acquire) >= STREAM_STATS_LATENCY_MARKS)
+    {
+        return;
+    }
+
+    _marks[tail & (STREAM_STATS_LATENCY_MARKS - 1)] = {position, _now()};
+    _markTail.store(tail + 1, std::memory_order_release);
+}
+
+void StreamStatsCounter::_finishMarks(bool popped)
+{
+    uint32_t head = _markHead.load(std::memory_order_relaxed);
+    uint32_t tail = _markTail.load(std::memory_order_acquire);
+    int64_t now = popped ? _now() : 0;
+
+    while((head != tail) && (_marks[head & (STREAM_STATS_LATENCY_MARKS - 1)].position <= _readPosition))
+    {
+        if(popped)
+        {
+            int64_t latency = now - _marks[head & (STREAM_STATS_LATENCY_MARKS - 1)].time;
+            size_t bucket = std::bit_width((uint64_t)std::max<int64_t>(latency, 1)) - 1;
+            bucket = std::min(bucket, (size_t)(STREAM_STATS_LATENCY_BUCKETS - 1));
+
+            _add(_histogram[bucket], 1);
+            _add(_latencyCount, 1);
+        }
+
+        head++;
+    }
+
+    _markHead.store(head, std::memory_order_release);
+}
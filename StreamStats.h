@@ -0,0 +1,219 @@
+#pragma once
+
+// ####################################################################################################
+// Include libraries:
+
+#include <cstddef>                  // Size types like size_t
+#include <cstdint>                  // Fixed width integer types
+#include <atomic>                   // Relaxed atomic counters
+#include <chrono>                   // Latency timestamps
+#include <string>                   // Text and JSON dump
+
+// ####################################################################################################
+// Public macros:
+
+/// @brief Enable Stream statistics counters. Build with -DSTREAM_STATS=0 to remove them from hot paths.
+#ifndef STREAM_STATS
+#define STREAM_STATS                        1
+#endif
+
+/// @brief Number of buckets of latency histogram. Bucket i counts latencies in [2^i, 2^(i+1)) nanoseconds.
+#define STREAM_STATS_LATENCY_BUCKETS        40
+
+/// @brief Max number of pushes that wait for their pop time in latency measurement. It must be a power of two.
+#define STREAM_STATS_LATENCY_MARKS          64
+
+// ######################################################################################################
+// StreamDirectionStats Struct:
+
+/**
+ * @struct StreamDirectionStats
+ * @brief Statistics of one buffer direction (TX or RX) of a stream.
+ */
+struct StreamDirectionStats
+{
+    uint64_t bytesIn = 0;               ///! @brief Total number of characters stored in buffer.
+    uint64_t bytesOut = 0;              ///! @brief Total number of characters popped or removed from buffer by consumer.
+    uint64_t bytesDropped = 0;          ///! @brief Total number of characters dropped by overflow policy. Old and new data.
+    uint64_t pushCount = 0;             ///! @brief Number of push calls that stored data.
+    uint64_t popCount = 0;              ///! @brief Number of pop/remove calls that removed data.
+    size_t currentFill = 0;             ///! @brief Number of characters in buffer at snapshot time.
+    size_t peakFill = 0;                ///! @brief Max number of characters in buffer after a push.
+    uint64_t latencyCount = 0;          ///! @brief Number of latency samples.
+    uint64_t latencyHistogram[STREAM_STATS_LATENCY_BUCKETS] = {};   ///! @brief Push to pop latency histogram.
+};
+
+// ######################################################################################################
+// StreamStatsSnapshot Struct:
+
+/**
+ * @struct StreamStatsSnapshot
+ * @brief Statistics of a stream at a point in time. Use Stream::getStats() to make it.
+ */
+struct StreamStatsSnapshot
+{
+    bool enabled = false;               ///! @brief False if statistics are disabled by STREAM_STATS.
+    StreamDirectionStats tx;            ///! @brief TX buffer statistics.
+    StreamDirectionStats rx;            ///! @brief RX buffer statistics.
+
+    /// @brief Return statistics as human readable text lines.
+    std::string toText(void) const;
+
+    /// @brief Return statistics as one JSON object.
+    std::string toJson(void) const;
+};
+
+// ######################################################################################################
+// StreamStatsCounter Class:
+
+/**
+ * @class StreamStatsCounter
+ * @brief Hot path counters of one buffer direction of a stream.
+ * @note Push side counters are written only by producer and pop side counters only by consumer, so in SPSC mode
+ * counters are updated with relaxed load/store and no atomic read-modify-write.
+ * @note Latency is measured per push: time from end of push until its last character is popped. Pushes are
+ * sampled when more than STREAM_STATS_LATENCY_MARKS of them wait in buffer.
+ */
+class StreamStatsCounter
+{
+public:
+
+    /**
+     * @brief Count a push.
+     * @param stored: Number of characters stored.
+     * @param rejected: Number of new characters that are not stored.
+     * @param fill: Buffer length after push.
+     */
+    void push(size_t stored, size_t rejected, size_t fill)
+    {
+        if(_shared.load(std::memory_order_relaxed))
+        {
+            _pushShared(stored, rejected, fill);
+            return;
+        }
+
+        if(rejected > 0)
+        {
+            _add(_bytesDropped, rejected);
+        }
+
+        if(stored == 0)
+        {
+            return;
+        }
+
+        uint64_t position = _bytesIn.load(std::memory_order_relaxed) + stored;
+        _bytesIn.store(position, std::memory_order_relaxed);
+        _add(_pushCount, 1);
+
+        if(fill > _peakFill.load(std::memory_order_relaxed))
+        {
+            _peakFill.store(fill, std::memory_order_relaxed);
+        }
+
+        if(_latency.load(std::memory_order_relaxed))
+        {
+            _mark(position);
+        }
+    }
+
+    /// @brief Count characters popped or removed by consumer.
+    void pop(size_t size)
+    {
+        if(size == 0)
+        {
+            return;
+        }
+
+        _add(_bytesOut, size);
+        _add(_popCount, 1);
+        _advance(size, true);
+    }
+
+    /// @brief Count old characters removed by overflow policy to make space for new data.
+    void evict(size_t size)
+    {
+        if(size == 0)
+        {
+            return;
+        }
+
+        _add(_bytesDropped, size);
+        _advance(size, false);
+    }
+
+    /// @brief Enable/Disable push to pop latency measurement. It reads a clock on every push and pop. Default is disabled.
+    void setLatency(bool enable);
+
+    /**
+     * @brief Enable/Disable shared mode for many producer threads. Push counters are updated with atomic
+     * read-modify-write and latency is not measured.
+     */
+    void setShared(bool enable);
+
+    /// @brief Copy counters to stats. currentFill is not set.
+    void snapshot(StreamDirectionStats &stats) const;
+
+    /// @brief Set all counters to zero. It is not thread safe.
+    void reset(void);
+
+private:
+
+    /**
+     * @struct Mark
+     * @brief End position of a push in buffer and its time.
+     */
+    struct Mark
+    {
+        uint64_t position;              ///! @brief Value of bytesIn after push.
+        int64_t time;                   ///! @brief Push time in nanoseconds.
+    };
+
+    std::atomic<uint64_t> _bytesIn{0};              ///! @brief Written by producer.
+    std::atomic<uint64_t> _bytesDropped{0};         ///! @brief Written by producer.
+    std::atomic<uint64_t> _pushCount{0};            ///! @brief Written by producer.
+    std::atomic<size_t> _peakFill{0};               ///! @brief Written by producer.
+    std::atomic<uint64_t> _bytesOut{0};             ///! @brief Written by consumer.
+    std::atomic<uint64_t> _popCount{0};             ///! @brief Written by consumer.
+    std::atomic<uint64_t> _latencyCount{0};         ///! @brief Written by consumer.
+    std::atomic<uint64_t> _histogram[STREAM_STATS_LATENCY_BUCKETS] = {};  ///! @brief Written by consumer.
+
+    std::atomic<bool> _latency{false};              ///! @brief Latency measurement flag.
+    std::atomic<bool> _shared{false};               ///! @brief Shared mode flag for many producers.
+    uint64_t _readPosition = 0;                     ///! @brief Popped and evicted characters. Used by consumer.
+    Mark _marks[STREAM_STATS_LATENCY_MARKS];        ///! @brief SPSC queue of push marks.
+    std::atomic<uint32_t> _markHead{0};             ///! @brief Next mark to read. Written by consumer.
+    std::atomic<uint32_t> _markTail{0};             ///! @brief Next mark to write. Written by producer.
+
+    /// @brief Add to a counter that has only one writer thread.
+    static void _add(std::atomic<uint64_t> &counter, uint64_t value)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+
+    /// @brief Return monotonic time in nanoseconds.
+    static int64_t _now(void)
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    /// @brief Count a push in shared mode.
+    void _pushShared(size_t stored, size_t rejected, size_t fill);
+
+    /// @brief Add a push mark. It is skipped if mark queue is full.
+    void _mark(uint64_t position);
+
+    /// @brief Move read position and finish marks of characters that left buffer.
+    void _advance(size_t size, bool popped)
+    {
+        _readPosition += size;
+
+        if(_markHead.load(std::memory_order_relaxed) != _markTail.load(std::memory_order_acquire))
+        {
+            _finishMarks(popped);
+        }
+    }
+
+    /// @brief Remove marks that are fully read. Record their latency if popped is true.
+    void _finishMarks(bool popped);
+};
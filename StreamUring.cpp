@@ -0,0 +1,351 @@
+// ####################################################################################################
+// Include libraries:
+
+#include "StreamUring.h"
+#include <atomic>                   // Ordered access to shared ring indices
+#include <linux/io_uring.h>         // io_uring structures and constants
+#include <sys/mman.h>               // mmap
+#include <sys/syscall.h>            // io_uring system call numbers
+
+// ####################################################################################################
+// Private functions:
+
+/// @brief Load an index that kernel writes.
+static unsigned loadAcquire(const unsigned* value)
+{
+    return std::atomic_ref<const unsigned>(*value).load(std::memory_order_acquire);
+}
+
+/// @brief Store an index that kernel reads.
+static void storeRelease(unsigned* value, unsigned newValue)
+{
+    std::atomic_ref<unsigned>(*value).store(newValue, std::memory_order_release);
+}
+
+// ######################################################################################################
+// StreamUring Class:
+
+StreamUring::StreamUring(unsigned entries)
+{
+    _sqRing = MAP_FAILED;
+    _cqRing = MAP_FAILED;
+    _sqes = MAP_FAILED;
+    _queued = 0;
+    _pending = 0;
+
+    io_uring_params params = {};
+    _ringFd = (int)syscall(__NR_io_uring_setup, entries, &params);
+
+    if(_ringFd < 0)
+    {
+        return;
+    }
+
+    _sqEntries = params.sq_entries;
+    _sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    _cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+
+    // New kernels map both rings with one mmap.
+    bool single = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if(single)
+    {
+        _sqRingSize = std::max(_sqRingSize, _cqRingSize);
+    }
+
+    _sqRing = mmap(nullptr, _sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _ringFd, IORING_OFF_SQ_RING);
+    if(_sqRing == MAP_FAILED)
+    {
+        _release();
+        return;
+    }
+
+    _cqRing = single ? _sqRing : mmap(nullptr, _cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _ringFd, IORING_OFF_CQ_RING);
+    if(_cqRing == MAP_FAILED)
+    {
+        _release();
+        return;
+    }
+
+    _sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    _sqes = mmap(nullptr, _sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _ringFd, IORING_OFF_SQES);
+    if(_sqes == MAP_FAILED)
+    {
+        _release();
+        return;
+    }
+
+    char* sq = (char*)_sqRing;
+    char* cq = (char*)_cqRing;
+    _sqHead = (unsigned*)(sq + params.sq_off.head);
+    _sqTail = (unsigned*)(sq + params.sq_off.tail);
+    _sqMask = (unsigned*)(sq + params.sq_off.ring_mask);
+    _sqArray = (unsigned*)(sq + params.sq_off.array);
+    _cqHead = (unsigned*)(cq + params.cq_off.head);
+    _cqTail = (unsigned*)(cq + params.cq_off.tail);
+    _cqMask = (unsigned*)(cq + params.cq_off.ring_mask);
+    _cqes = cq + params.cq_off.cqes;
+}
+
+StreamUring::~StreamUring()
+{
+    _release();
+}
+
+bool StreamUring::isUring(void) const
+{
+    return _ringFd >= 0;
+}
+
+bool StreamUring::add(int fd, Stream* stream, CompletionCallback callback)
+{
+    if((stream == nullptr) || (_channels.count(fd) > 0))
+    {
+        return false;
+    }
+
+    auto channel = std::make_unique<Channel>();
+    channel->stream = stream;
+    channel->callback = std::move(callback);
+    channel->fill = {fd, true, false, {}};
+    channel->flush = {fd, false, false, {}};
+    _channels[fd] = std::move(channel);
+
+    return true;
+}
+
+bool StreamUring::remove(int fd)
+{
+    auto found = _channels.find(fd);
+
+    if((found == _channels.end()) || found->second->fill.pending || found->second->flush.pending)
+    {
+        return false;
+    }
+
+    _channels.erase(found);
+
+    return true;
+}
+
+bool StreamUring::fill(int fd)
+{
+    auto found = _channels.find(fd);
+
+    if((found == _channels.end()) || found->second->fill.pending)
+    {
+        return false;
+    }
+
+    Stream* stream = found->second->stream;
+    Operation &operation = found->second->fill;
+
+    if(stream->getRxFreeSpace() == 0)
+    {
+        return false;
+    }
+
+    // Read into both regions of RX free space. Empty regions with free space means deque backend.
+    RingRegions<char> regions = stream->prepareRxRegions(SIZE_MAX);
+    operation.iov[0] = {regions.first.data(), regions.first.size()};
+    operation.iov[1] = {regions.second.data(), regions.second.size()};
+
+    return _queue(operation, !regions.empty());
+}
+
+bool StreamUring::flush(int fd)
+{
+    auto found = _channels.find(fd);
+
+    if((found == _channels.end()) || found->second->flush.pending)
+    {
+        return false;
+    }
+
+    Stream* stream = found->second->stream;
+    Operation &operation = found->second->flush;
+
+    if(stream->getTxBufferLength() == 0)
+    {
+        return false;
+    }
+
+    // Write both regions of TX data. Empty regions with stored data means deque backend.
+    RingRegions<const char> regions = stream->peekTx();
+    operation.iov[0] = {(void*)regions.first.data(), regions.first.size()};
+    operation.iov[1] = {(void*)regions.second.data(), regions.second.size()};
+
+    return _queue(operation, !regions.empty());
+}
+
+int StreamUring::submit(unsigned waitCount)
+{
+    int handled = 0;
+
+    // Synchronous fallback operations. Completion is immediate.
+    std::vector<Operation*> syncQueue;
+    syncQueue.swap(_syncQueue);
+
+    for(Operation* operation : syncQueue)
+    {
+        Stream* stream = _channels[operation->fd]->stream;
+        ssize_t result = operation->read ? stream->fillRx(operation->fd) : stream->flushTx(operation->fd);
+
+        operation->pending = false;
+        _pending--;
+        handled++;
+
+        // Data is already stored or removed by fillRx/flushTx. Only callback is left.
+        Channel &channel = *_channels[operation->fd];
+        if(channel.callback)
+        {
+            channel.callback(*stream, operation->fd, operation->read, (result < 0) ? -errno : (int)result);
+        }
+    }
+
+    if((_ringFd < 0) || ((_queued == 0) && (_pending == 0)))
+    {
+        return handled;
+    }
+
+    // Do not wait for more completions than submitted operations.
+    waitCount = std::min<unsigned>(waitCount, _pending);
+
+    if(((_queued > 0) || (waitCount > 0)) && !_enter(waitCount))
+    {
+        return -1;
+    }
+
+    // Handle all available completions.
+    unsigned head = *_cqHead;
+    unsigned tail = loadAcquire(_cqTail);
+
+    while(head != tail)
+    {
+        io_uring_cqe* cqe = (io_uring_cqe*)_cqes + (head & *_cqMask);
+        Operation* operation = (Operation*)(uintptr_t)cqe->user_data;
+        int result = cqe->res;
+        head++;
+
+        storeRelease(_cqHead, head);
+        _complete(*operation, result);
+        handled++;
+
+        tail = loadAcquire(_cqTail);
+    }
+
+    return handled;
+}
+
+size_t StreamUring::pending(void) const
+{
+    return _pending;
+}
+
+bool StreamUring::_queue(Operation &operation, bool async)
+{
+    if(!async || (_ringFd < 0))
+    {
+        _syncQueue.push_back(&operation);
+        operation.pending = true;
+        _pending++;
+        return true;
+    }
+
+    unsigned tail = *_sqTail;
+
+    // Submission queue is full. Pass entries to kernel to make space.
+    if(tail - loadAcquire(_sqHead) >= _sqEntries)
+    {
+        if(!_enter(0) || (tail - loadAcquire(_sqHead) >= _sqEntries))
+        {
+            return false;
+        }
+    }
+
+    unsigned index = tail & *_sqMask;
+    io_uring_sqe* sqe = (io_uring_sqe*)_sqes + index;
+
+    *sqe = {};
+    sqe->opcode = operation.read ? IORING_OP_READV : IORING_OP_WRITEV;
+    sqe->fd = operation.fd;
+    sqe->addr = (uintptr_t)operation.iov;
+    sqe->len = (operation.iov[1].iov_len > 0) ? 2 : 1;
+    sqe->off = (uint64_t)-1;        // Current file position. Needed for pipes and sockets.
+    sqe->user_data = (uintptr_t)&operation;
+
+    _sqArray[index] = index;
+    storeRelease(_sqTail, tail + 1);
+
+    operation.pending = true;
+    _queued++;
+    _pending++;
+
+    return true;
+}
+
+bool StreamUring::_enter(unsigned waitCount)
+{
+    int result;
+
+    do
+    {
+        result = (int)syscall(__NR_io_uring_enter, _ringFd, _queued, waitCount, (waitCount > 0) ? IORING_ENTER_GETEVENTS : 0, nullptr, 0);
+
+        // Kernel can take fewer entries than queued, also before an interrupted wait. The rest stays queued.
+        _queued = *_sqTail - loadAcquire(_sqHead);
+    } while((result < 0) && (errno == EINTR));
+
+    return result >= 0;
+}
+
+void StreamUring::_complete(Operation &operation, int result)
+{
+    operation.pending = false;
+    _pending--;
+
+    Channel &channel = *_channels[operation.fd];
+
+    if(result > 0)
+    {
+        if(operation.read)
+        {
+            channel.stream->commitRx(result);
+        }
+        else
+        {
+            channel.stream->consumeTx(result);
+        }
+    }
+
+    if(channel.callback)
+    {
+        channel.callback(*channel.stream, operation.fd, operation.read, result);
+    }
+}
+
+void StreamUring::_release(void)
+{
+    if(_sqes != MAP_FAILED)
+    {
+        munmap(_sqes, _sqesSize);
+        _sqes = MAP_FAILED;
+    }
+
+    if((_cqRing != MAP_FAILED) && (_cqRing != _sqRing))
+    {
+        munmap(_cqRing, _cqRingSize);
+    }
+    _cqRing = MAP_FAILED;
+
+    if(_sqRing != MAP_FAILED)
+    {
+        munmap(_sqRing, _sqRingSize);
+        _sqRing = MAP_FAILED;
+    }
+
+    if(_ringFd >= 0)
+    {
+        close(_ringFd);
+        _ringFd = -1;
+    }
+}
@@ -0,0 +1,167 @@
+#pragma once
+
+// ####################################################################################################
+// Include libraries:
+
+#include <functional>               // Completion callback
+#include <memory>                   // std::unique_ptr
+#include <unordered_map>            // Registered file descriptors
+#include <vector>                   // Fallback operation queue
+#include <sys/uio.h>                // iovec
+#include "Stream.h"                 // Stream class
+
+// ####################################################################################################
+// Public macros:
+
+/// @brief Default number of submission queue entries of StreamUring.
+#define STREAM_URING_DEFAULT_ENTRIES        256
+
+// ######################################################################################################
+// StreamUring Class:
+
+/**
+ * @class StreamUring
+ * @brief Asynchronous fill of RX and flush of TX buffers of many streams with io_uring.
+ * fill() and flush() queue operations and submit() passes all of them to kernel with one system call and handles
+ * completions. Reads go directly into RX free space and writes come directly from TX data, so there is no copy
+ * between a temporary buffer and stream.
+ * @note If io_uring is not available, or a stream has deque backend, operations are done synchronously with
+ * Stream::fillRx() and Stream::flushTx() in submit(). Results and callbacks are the same.
+ * @note While a fill is pending, RX buffer must not be pushed by other functions. While a flush is pending,
+ * TX buffer must not be removed by other functions. Popping RX and pushing TX are allowed.
+ * @note It is not thread safe. Use one StreamUring per thread.
+ */
+class StreamUring
+{
+public:
+
+    /**
+     * @brief Completion callback.
+     * @param stream: Stream of descriptor.
+     * @param fd: File descriptor.
+     * @param read: true for fill and false for flush.
+     * @param result: Number of characters read/written. 0 on end of file. Negative errno value on failure.
+     */
+    using CompletionCallback = std::function<void(Stream &stream, int fd, bool read, int result)>;
+
+    /**
+     * @brief Constructor. Set up io_uring. If it fails, synchronous fallback is used.
+     * @param entries: Number of submission queue entries.
+     */
+    StreamUring(unsigned entries = STREAM_URING_DEFAULT_ENTRIES);
+
+    /**
+     * Destructor. Release io_uring. Registered descriptors are not closed.
+     * @note Pending operations must be completed by submit() before destruction.
+     */
+    ~StreamUring();
+
+    StreamUring(const StreamUring&) = delete;
+    StreamUring& operator=(const StreamUring&) = delete;
+
+    /// @brief Return true if io_uring is used. false if synchronous fallback is used.
+    bool isUring(void) const;
+
+    /**
+     * @brief Register a file descriptor with its stream.
+     * @param fd: File descriptor. For example UDP socket, pipe, serial port.
+     * @param stream: Stream pointer. It must be valid until fd is removed.
+     * @param callback: Completion callback. It can be empty.
+     * @return true if succeeded. false if fd is already registered.
+     */
+    bool add(int fd, Stream* stream, CompletionCallback callback = nullptr);
+
+    /**
+     * @brief Unregister a file descriptor.
+     * @return true if succeeded. false if fd is not registered or it has a pending operation.
+     */
+    bool remove(int fd);
+
+    /**
+     * @brief Queue a read from descriptor into free space of RX buffer.
+     * @return true if succeeded. false if fd is not registered, a fill is already pending or RX buffer is full.
+     */
+    bool fill(int fd);
+
+    /**
+     * @brief Queue a write of TX buffer data to descriptor. Written characters are removed on completion.
+     * @return true if succeeded. false if fd is not registered, a flush is already pending or TX buffer is empty.
+     */
+    bool flush(int fd);
+
+    /**
+     * @brief Submit queued operations with one system call and handle completions.
+     * @param waitCount: Min number of completions to wait for.
+     * @return Number of handled completions. -1 if io_uring fails, errno is set.
+     */
+    int submit(unsigned waitCount = 0);
+
+    /// @brief Return number of queued or submitted operations that are not completed.
+    size_t pending(void) const;
+
+private:
+
+    /**
+     * @struct Operation
+     * @brief A fill or flush of a descriptor. Its address is user data of io_uring entry.
+     */
+    struct Operation
+    {
+        int fd;                         ///! @brief File descriptor.
+        bool read;                      ///! @brief true for fill and false for flush.
+        bool pending;                   ///! @brief True from queue until completion.
+        iovec iov[2];                   ///! @brief Regions of RX free space or TX data.
+    };
+
+    /**
+     * @struct Channel
+     * @brief Registered file descriptor.
+     */
+    struct Channel
+    {
+        Stream* stream;                 ///! @brief Stream of file descriptor.
+        CompletionCallback callback;    ///! @brief Completion callback.
+        Operation fill;                 ///! @brief Fill operation.
+        Operation flush;                ///! @brief Flush operation.
+    };
+
+    int _ringFd;                        ///! @brief io_uring descriptor. -1 for synchronous fallback.
+    void* _sqRing;                      ///! @brief Mapped submission queue ring.
+    void* _cqRing;                      ///! @brief Mapped completion queue ring. It can be the same mapping as _sqRing.
+    size_t _sqRingSize;                 ///! @brief Size of submission queue ring mapping.
+    size_t _cqRingSize;                 ///! @brief Size of completion queue ring mapping.
+    void* _sqes;                        ///! @brief Mapped submission queue entries.
+    size_t _sqesSize;                   ///! @brief Size of submission queue entries mapping.
+
+    unsigned* _sqHead;                  ///! @brief Submission queue head. Written by kernel.
+    unsigned* _sqTail;                  ///! @brief Submission queue tail. Written by us.
+    unsigned* _sqMask;                  ///! @brief Submission queue index mask.
+    unsigned* _sqArray;                 ///! @brief Submission queue index array.
+    unsigned* _cqHead;                  ///! @brief Completion queue head. Written by us.
+    unsigned* _cqTail;                  ///! @brief Completion queue tail. Written by kernel.
+    unsigned* _cqMask;                  ///! @brief Completion queue index mask.
+    void* _cqes;                        ///! @brief Completion queue entries.
+    unsigned _sqEntries;                ///! @brief Number of submission queue entries.
+
+    unsigned _queued;                   ///! @brief Number of entries that are added after last submit.
+    size_t _pending;                    ///! @brief Number of operations that are not completed.
+    std::vector<Operation*> _syncQueue; ///! @brief Operations of synchronous fallback.
+
+    std::unordered_map<int, std::unique_ptr<Channel>> _channels;    ///! @brief Registered file descriptors.
+
+    /// @brief Queue an operation to io_uring or to synchronous fallback.
+    bool _queue(Operation &operation, bool async);
+
+    /**
+     * @brief Pass queued entries to kernel and wait for certain number of completions. Retry if interrupted.
+     * @return true if succeeded. false if io_uring fails, errno is set.
+     */
+    bool _enter(unsigned waitCount);
+
+    /// @brief Apply result of a completed operation to its stream and call callback.
+    void _complete(Operation &operation, int result);
+
+    /// @brief Release io_uring mappings and descriptor.
+    void _release(void);
+
+};
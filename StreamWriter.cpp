@@ -0,0 +1,208 @@
+// ####################################################################################################
+// Include libraries:
+
+#include "StreamWriter.h"
+#include <cstring>                  // std::memcpy, std::strlen
+
+// ######################################################################################################
+// StreamWriter Class:
+
+StreamWriter::StreamWriter(Stream &stream) : _stream(stream)
+{
+    _precision = STREAM_WRITER_DEFAULT_PRECISION;
+    _begin();
+}
+
+StreamWriter::~StreamWriter()
+{
+    if(_length > 0)
+    {
+        commit();
+    }
+}
+
+StreamWriter& StreamWriter::setPrecision(uint8_t precision)
+{
+    _precision = precision;
+    return *this;
+}
+
+bool StreamWriter::commit(void)
+{
+    // Record memory in TX buffer is reserved by prepareTx(), so a direct record is always stored whole.
+    size_t stored = _length;
+
+    if(_overflow)
+    {
+        stored = 0;
+        _stream.countTxDropped(_length + _dropped);
+    }
+    else if(_length > 0)
+    {
+        if(_direct)
+        {
+            _stream.commitTx(_length);
+        }
+        else
+        {
+            stored = _stream.pushBackTxBuffer(_buffer, _length);
+        }
+    }
+
+    bool result = (stored == _length);
+
+    _begin();
+
+    return result;
+}
+
+size_t StreamWriter::length(void) const
+{
+    return _length;
+}
+
+StreamWriter& StreamWriter::operator<<(char value)
+{
+    _write(&value, 1);
+    return *this;
+}
+
+StreamWriter& StreamWriter::operator<<(bool value)
+{
+    if(value)
+    {
+        _write("true", 4);
+    }
+    else
+    {
+        _write("false", 5);
+    }
+
+    return *this;
+}
+
+StreamWriter& StreamWriter::operator<<(const char* value)
+{
+    if(value != nullptr)
+    {
+        _write(value, std::strlen(value));
+    }
+
+    return *this;
+}
+
+StreamWriter& StreamWriter::operator<<(std::string_view value)
+{
+    _write(value.data(), value.size());
+    return *this;
+}
+
+StreamWriter& StreamWriter::operator<<(const std::string &value)
+{
+    _write(value.data(), value.size());
+    return *this;
+}
+
+StreamWriter& StreamWriter::operator<<(double value)
+{
+    return *this << fixed(value, _precision);
+}
+
+StreamWriter& StreamWriter::operator<<(float value)
+{
+    return *this << fixed(value, _precision);
+}
+
+StreamWriter& StreamWriter::operator<<(const Fixed &value)
+{
+    size_t length;
+
+    // Most values are short. Try remaining space first.
+    if(!_overflow)
+    {
+        _acquire();
+        size_t size = _capacity - _length;
+        char* data = _data + _length;
+        length = value.isFloat ? decimalToChars((float)value.value, value.precision, data, size) : decimalToChars(value.value, value.precision, data, size);
+
+        if(length > 0)
+        {
+            _length += length;
+            return *this;
+        }
+    }
+
+    // Max size is larger than a usual record. Format to stack and write only the used characters.
+    char local[DECIMAL_STRING_MAX_SIZE];
+    length = value.isFloat ? decimalToChars((float)value.value, value.precision, local, sizeof(local)) : decimalToChars(value.value, value.precision, local, sizeof(local));
+    _write(local, length);
+
+    return *this;
+}
+
+void StreamWriter::_begin(void)
+{
+    // TX memory is taken by first write, so pushes of other code between records are not overwritten.
+    _data = nullptr;
+    _capacity = 0;
+    _length = 0;
+    _direct = false;
+    _overflow = false;
+    _dropped = 0;
+}
+
+void StreamWriter::_acquire(void)
+{
+    if(_data != nullptr)
+    {
+        return;
+    }
+
+    std::span<char> region = _stream.prepareTx(SIZE_MAX);
+
+    _direct = !region.empty();
+    _data = _direct ? region.data() : _buffer;
+    _capacity = _direct ? region.size() : sizeof(_buffer);
+}
+
+char* StreamWriter::_reserve(size_t size)
+{
+    if(_overflow)
+    {
+        _dropped += size;
+        return nullptr;
+    }
+
+    _acquire();
+
+    if(_length + size <= _capacity)
+    {
+        return _data + _length;
+    }
+
+    // Not enough contiguous TX space. Continue record in internal buffer.
+    if(_direct && (_length + size <= sizeof(_buffer)))
+    {
+        std::memcpy(_buffer, _data, _length);
+        _data = _buffer;
+        _capacity = sizeof(_buffer);
+        _direct = false;
+        return _data + _length;
+    }
+
+    _overflow = true;
+    _dropped += size;
+
+    return nullptr;
+}
+
+void StreamWriter::_write(const char* data, size_t size)
+{
+    char* target = _reserve(size);
+
+    if(target != nullptr)
+    {
+        std::memcpy(target, data, size);
+        _length += size;
+    }
+}
@@ -0,0 +1,183 @@
+#pragma once
+
+// ####################################################################################################
+// Include libraries:
+
+#include <charconv>                 // std::to_chars
+#include <string>                   // String class and related functions
+#include <string_view>              // Non-owning string views
+#include <type_traits>              // Compile time type checks
+#include "Stream.h"                 // Stream class, decimalToChars
+
+// ####################################################################################################
+// Public macros:
+
+/// @brief Size of StreamWriter internal buffer. It is the max record size when TX buffer has no contiguous space for it.
+#define STREAM_WRITER_BUFFER_SIZE           1024
+
+/// @brief Default number of characters after dot for float/double values of StreamWriter.
+#define STREAM_WRITER_DEFAULT_PRECISION     6
+
+// ######################################################################################################
+// Fixed Struct:
+
+/**
+ * @struct Fixed
+ * @brief Float/double value with certain precision for StreamWriter. Use fixed() to make it.
+ */
+struct Fixed
+{
+    double value;                       ///! @brief Value.
+    uint8_t precision;                  ///! @brief Number of characters after dot character.
+    bool isFloat;                       ///! @brief True if value is float. Output is the same as decimalToString(float).
+};
+
+/// @brief Make a double value with certain precision for StreamWriter.
+inline Fixed fixed(double value, uint8_t precision) { return {value, precision, false}; }
+
+/// @brief Make a float value with certain precision for StreamWriter.
+inline Fixed fixed(float value, uint8_t precision) { return {value, precision, true}; }
+
+// ######################################################################################################
+// StreamWriter Class:
+
+/**
+ * @class StreamWriter
+ * @brief Format typed values of a record directly into TX buffer of a stream and push the record once.
+ * Integers, float/double with fixed precision, bool, characters and strings are formatted without printf,
+ * iostream or intermediate strings.
+ * @note The record is written directly into contiguous free space of TX ring buffer and it is stored by commit().
+ * If there is not enough contiguous space, or backend is deque, the record is formatted in an internal buffer and
+ * pushed with pushBackTxBuffer().
+ * @note TX memory is taken by first write of a record. Do not push to TX buffer of the stream from other code
+ * until the record is committed, because the direct record memory would be overwritten.
+ * @note The destructor commits the record if it is not committed, so a temporary writer sends one record:
+ * @code
+ * StreamWriter(stream) << id << ',' << fixed(temperature, 2) << ',' << true << '\n';
+ * @endcode
+ */
+class StreamWriter
+{
+public:
+
+    /**
+     * @brief Constructor. TX space for a record is taken by its first write.
+     * @param stream: Stream that record is pushed to its TX buffer.
+     */
+    StreamWriter(Stream &stream);
+
+    /**
+     * Destructor. Commit record if it is not committed.
+     */
+    ~StreamWriter();
+
+    StreamWriter(const StreamWriter&) = delete;
+    StreamWriter& operator=(const StreamWriter&) = delete;
+
+    /// @brief Set default number of characters after dot for float/double values.
+    StreamWriter& setPrecision(uint8_t precision);
+
+    /**
+     * @brief Store the record in TX buffer. Next values start a new record.
+     * @return true if whole record is stored. false if record is larger than STREAM_WRITER_BUFFER_SIZE and it is
+     * dropped, or TX buffer could store only part of it. A dropped record is counted in dropped characters of TX
+     * statistics.
+     */
+    bool commit(void);
+
+    /// @brief Return number of characters of current record.
+    size_t length(void) const;
+
+    /// @brief Write character.
+    StreamWriter& operator<<(char value);
+
+    /// @brief Write "true" or "false".
+    StreamWriter& operator<<(bool value);
+
+    /// @brief Write string. nullptr writes nothing.
+    StreamWriter& operator<<(const char* value);
+
+    /// @brief Write string.
+    StreamWriter& operator<<(std::string_view value);
+
+    /// @brief Write string.
+    StreamWriter& operator<<(const std::string &value);
+
+    /// @brief Write double with default precision.
+    StreamWriter& operator<<(double value);
+
+    /// @brief Write float with default precision.
+    StreamWriter& operator<<(float value);
+
+    /// @brief Write float/double with certain precision.
+    StreamWriter& operator<<(const Fixed &value);
+
+    /// @brief Write integer. int8_t and uint8_t are written as numbers.
+    template<typename T, typename std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool> && !std::is_same_v<T, char>, int> = 0>
+    StreamWriter& operator<<(T value)
+    {
+        // Max digits of 64 bit integer with sign. Only the used characters are reserved in record.
+        char digits[20];
+        _write(digits, std::to_chars(digits, digits + sizeof(digits), value).ptr - digits);
+
+        return *this;
+    }
+
+    /**
+     * @brief Write fields separated by delimiter and end the record with '\n', then commit it.
+     * @return true if succeeded.
+     */
+    template<typename... Fields>
+    bool writeRecord(char delimiter, const Fields&... fields)
+    {
+        bool first = true;
+        ((first ? (void)(first = false) : (void)(*this << delimiter), *this << fields), ...);
+        *this << '\n';
+
+        return commit();
+    }
+
+private:
+
+    Stream& _stream;                    ///! @brief Target stream.
+    char* _data;                        ///! @brief Memory that record is written into. TX buffer, _buffer or nullptr.
+    size_t _capacity;                   ///! @brief Size of _data memory.
+    size_t _length;                     ///! @brief Length of record.
+    bool _direct;                       ///! @brief True if _data is TX buffer memory.
+    bool _overflow;                     ///! @brief True if record does not fit in _buffer.
+    size_t _dropped;                    ///! @brief Number of characters that are written after overflow.
+    uint8_t _precision;                 ///! @brief Default precision of float/double values.
+    char _buffer[STREAM_WRITER_BUFFER_SIZE];    ///! @brief Internal buffer for record.
+
+    /// @brief Start a new record. TX memory is not taken yet.
+    void _begin(void);
+
+    /// @brief Take TX memory or internal buffer for record if it is not taken yet.
+    void _acquire(void);
+
+    /**
+     * @brief Get memory for next size characters of record.
+     * @return Memory pointer. nullptr if record does not fit in internal buffer.
+     */
+    char* _reserve(size_t size);
+
+    /// @brief Write characters to record.
+    void _write(const char* data, size_t size);
+
+};
+
+// ######################################################################################################
+// Public general functions:
+
+/**
+ * @ingroup public_general_functions
+ * @brief Write fields separated by delimiter and '\n' at the end as one record to TX buffer of a stream.
+ * Float/double fields use default precision. Use fixed() for certain precision.
+ * @return true if succeeded.
+ *  */
+template<typename... Fields>
+bool writeRecord(Stream &stream, char delimiter, const Fields&... fields)
+{
+    StreamWriter writer(stream);
+    return writer.writeRecord(delimiter, fields...);
+}
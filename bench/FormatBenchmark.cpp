@@ -0,0 +1,110 @@
+// ####################################################################################################
+// Benchmark of decimalToString and decimalToChars.
+// Build: cmake -S .. -B build && cmake --build build --target FormatBenchmark
+
+// ####################################################################################################
+// Include libraries:
+
+#include <benchmark/benchmark.h>    // Google Benchmark
+#include <random>                   // Random telemetry values
+#include "Stream.h"
+
+// ####################################################################################################
+// Benchmark data:
+
+/// @brief Random telemetry like values.
+static std::vector<double> makeValues(size_t count)
+{
+    std::mt19937_64 generator(1);
+    std::uniform_real_distribution<double> distribution(-10000.0, 10000.0);
+    std::vector<double> values(count);
+
+    for(auto &value : values)
+    {
+        value = distribution(generator);
+    }
+
+    return values;
+}
+
+/// @brief Previous ostringstream implementation of decimalToString.
+static std::string decimalToStringStream(double value, uint8_t precision)
+{
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(precision) << value;
+    return oss.str();
+}
+
+// ####################################################################################################
+// Benchmarks:
+
+static void BM_DecimalToStringStream(benchmark::State& state)
+{
+    std::vector<double> values = makeValues(1024);
+    uint8_t precision = state.range(0);
+
+    for(auto _ : state)
+    {
+        for(double value : values)
+        {
+            benchmark::DoNotOptimize(decimalToStringStream(value, precision));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * values.size());
+}
+BENCHMARK(BM_DecimalToStringStream)->Arg(0)->Arg(3)->Arg(6)->Arg(17);
+
+static void BM_DecimalToString(benchmark::State& state)
+{
+    std::vector<double> values = makeValues(1024);
+    uint8_t precision = state.range(0);
+
+    for(auto _ : state)
+    {
+        for(double value : values)
+        {
+            benchmark::DoNotOptimize(decimalToString(value, precision));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * values.size());
+}
+BENCHMARK(BM_DecimalToString)->Arg(0)->Arg(3)->Arg(6)->Arg(17);
+
+static void BM_DecimalToChars(benchmark::State& state)
+{
+    std::vector<double> values = makeValues(1024);
+    uint8_t precision = state.range(0);
+    char buffer[DECIMAL_STRING_MAX_SIZE];
+
+    for(auto _ : state)
+    {
+        for(double value : values)
+        {
+            benchmark::DoNotOptimize(decimalToChars(value, precision, buffer, sizeof(buffer)));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * values.size());
+}
+BENCHMARK(BM_DecimalToChars)->Arg(0)->Arg(3)->Arg(6)->Arg(17);
+
+static void BM_PushBackTxDecimal(benchmark::State& state)
+{
+    std::vector<double> values = makeValues(1024);
+    RingBuffer tx(1 << 16), rx(16);
+    Stream stream(&tx, &rx);
+
+    for(auto _ : state)
+    {
+        for(double value : values)
+        {
+            stream.pushBackTxDecimal(value, 3);
+        }
+        stream.removeAllTxBuffer();
+    }
+
+    state.SetItemsProcessed(state.iterations() * values.size());
+}
+BENCHMARK(BM_PushBackTxDecimal);
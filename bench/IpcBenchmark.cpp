@@ -0,0 +1,156 @@
+// ####################################################################################################
+// Benchmark of Stream channel between two processes: pipe against shared memory ring buffer.
+// Each iteration sends a request of certain size to child process and waits for its 1 byte reply, so small
+// sizes measure round trip latency and large sizes measure throughput.
+// Build: cmake -S .. -B build && cmake --build build --target IpcBenchmark
+
+// ####################################################################################################
+// Include libraries:
+
+#include <benchmark/benchmark.h>    // Google Benchmark
+#include <unistd.h>                 // fork, pipe
+#include <sys/wait.h>               // waitpid
+#include "Stream.h"
+#include "SharedRingBuffer.h"
+
+// ####################################################################################################
+// Benchmark data:
+
+/// @brief Capacity of channel buffers. It fits the largest request.
+static const size_t channelCapacity = 1 << 17;
+
+/// @brief First character of request that stops child process.
+static const char quitMark = 'q';
+
+// ####################################################################################################
+// Benchmarks:
+
+static void BM_IpcPipe(benchmark::State& state)
+{
+    size_t size = state.range(0);
+    int request[2];
+    int reply[2];
+    if((pipe(request) != 0) || (pipe(reply) != 0))
+    {
+        state.SkipWithError("pipe failed");
+        return;
+    }
+
+    pid_t pid = fork();
+    if(pid == 0)
+    {
+        // Child: read whole request to RX, drop it and write reply.
+        close(request[1]);
+        close(reply[0]);
+        RingBuffer rxRing(channelCapacity);
+        RingBuffer txRing(64);
+        Stream stream(&txRing, &rxRing);
+
+        while(true)
+        {
+            while(stream.getRxBufferLength() < size)
+            {
+                if(stream.fillRx(request[0]) <= 0)
+                {
+                    _exit(0);
+                }
+            }
+            stream.consumeRx(size);
+            stream.pushBackTxBuffer("a", 1);
+            stream.flushTx(reply[1]);
+        }
+    }
+
+    close(request[0]);
+    close(reply[1]);
+    RingBuffer txRing(channelCapacity);
+    RingBuffer rxRing(64);
+    Stream stream(&txRing, &rxRing);
+    std::string data(size, 'x');
+
+    for(auto _ : state)
+    {
+        stream.pushBackTxBuffer(data.data(), data.size());
+        while(stream.getTxBufferLength() > 0)
+        {
+            stream.flushTx(request[1]);
+        }
+        while(stream.getRxBufferLength() == 0)
+        {
+            stream.fillRx(reply[0]);
+        }
+        stream.consumeRx(1);
+    }
+
+    close(request[1]);
+    close(reply[0]);
+    waitpid(pid, nullptr, 0);
+    state.SetBytesProcessed(state.iterations() * size);
+}
+BENCHMARK(BM_IpcPipe)->Arg(64)->Arg(4096)->Arg(65536)->UseRealTime();
+
+static void BM_IpcShared(benchmark::State& state)
+{
+    size_t size = state.range(0);
+    const char* requestName = "/stream_bench_request";
+    const char* replyName = "/stream_bench_reply";
+    SharedRingBuffer::unlink(requestName);
+    SharedRingBuffer::unlink(replyName);
+
+    SharedRingBuffer request;
+    SharedRingBuffer reply;
+    if(!request.open(requestName, channelCapacity) || !reply.open(replyName, 64))
+    {
+        state.SkipWithError("shared memory failed");
+        return;
+    }
+
+    pid_t pid = fork();
+    if(pid == 0)
+    {
+        // Child: RX of its stream is TX of parent stream.
+        Stream stream(&reply, &request);
+        stream.setSpscMode(true);
+
+        while(true)
+        {
+            while(stream.getRxBufferLength() < size)
+            {
+                request.waitData(-1);
+            }
+            char mark;
+            stream.peekFrontRxBuffer(&mark, 1);
+            if(mark == quitMark)
+            {
+                _exit(0);
+            }
+            stream.consumeRx(size);
+            stream.pushBackTxBuffer("a", 1);
+            reply.notifyData();
+        }
+    }
+
+    Stream stream(&request, &reply);
+    stream.setSpscMode(true);
+    std::string data(size, 'x');
+
+    for(auto _ : state)
+    {
+        stream.pushBackTxBuffer(data.data(), data.size());
+        request.notifyData();
+        reply.waitData(-1);
+        stream.consumeRx(1);
+    }
+
+    data[0] = quitMark;
+    stream.pushBackTxBuffer(data.data(), data.size());
+    request.notifyData();
+    waitpid(pid, nullptr, 0);
+
+    request.close();
+    reply.close();
+    SharedRingBuffer::unlink(requestName);
+    SharedRingBuffer::unlink(replyName);
+    state.SetBytesProcessed(state.iterations() * size);
+}
+BENCHMARK(BM_IpcShared)->Arg(64)->Arg(4096)->Arg(65536)->UseRealTime();
@@ -0,0 +1,151 @@
+// ####################################################################################################
+// Benchmark of RecordCodec binary records against text rows and of CRC-32C.
+// Build: cmake -S .. -B build && cmake --build build --target RecordBenchmark
+
+// ####################################################################################################
+// Include libraries:
+
+#include <benchmark/benchmark.h>    // Google Benchmark
+#include "RecordCodec.h"
+
+// ####################################################################################################
+// Benchmark data:
+
+/// @brief Field types of telemetry rows. Same rows as SplitBenchmark.
+static const std::vector<std::string> recordTypes = {"uint32", "double", "double", "double", "float", "uint8", "bool", "string"};
+
+/// @brief Realistic CSV telemetry rows.
+static std::vector<std::string> makeLines(size_t count)
+{
+    std::vector<std::string> lines;
+
+    for(size_t i = 0; i < count; i++)
+    {
+        lines.push_back(std::to_string(i) + ", 1712345678.125, 35.6892, 51.3890, 1203.5, " + std::to_string(i % 256) + ", true, GPS_FIX_3D");
+    }
+
+    return lines;
+}
+
+/// @brief Encode rows to framed binary records.
+static std::string makeFrames(const std::vector<std::string> &lines)
+{
+    RecordCodec codec(recordTypes);
+    RecordFramer framer;
+    std::vector<std::string_view> tokens;
+    std::string payload;
+    std::string frame;
+    std::string frames;
+
+    for(const auto& line : lines)
+    {
+        splitString(std::string_view(line), ',', tokens);
+        codec.encodeText(tokens, payload);
+        framer.encodeFrame(payload.data(), payload.size(), frame);
+        frames += frame;
+    }
+
+    return frames;
+}
+
+// ####################################################################################################
+// Benchmarks:
+
+/// @brief Text path: newline framed rows through RX buffer, split and validated.
+static void BM_RecordTextRows(benchmark::State& state)
+{
+    std::vector<std::string> lines = makeLines(1000);
+    std::string rows;
+    for(const auto& line : lines)
+    {
+        rows += line + '\n';
+    }
+
+    RingBuffer rx(1 << 20);
+    Stream stream(nullptr, &rx);
+    DelimiterFramer framer(&stream);
+    std::string row;
+    std::vector<std::string_view> tokens;
+
+    for(auto _ : state)
+    {
+        stream.pushBackRxBuffer(rows.data(), rows.size());
+        while(framer.popFrame(row))
+        {
+            bool valid = splitString(std::string_view(row), ',', tokens) == recordTypes.size();
+            for(size_t i = 0; valid && (i < tokens.size()); i++)
+            {
+                valid = checkValuetype(tokens[i], recordTypes[i]);
+            }
+            benchmark::DoNotOptimize(valid);
+        }
+    }
+
+    state.SetBytesProcessed(state.iterations() * rows.size());
+    state.SetItemsProcessed(state.iterations() * lines.size());
+    state.counters["bytes/row"] = (double)rows.size() / lines.size();
+}
+BENCHMARK(BM_RecordTextRows);
+
+/// @brief Binary path: CRC checked record frames through RX buffer and decoded.
+static void BM_RecordBinaryRows(benchmark::State& state)
+{
+    std::vector<std::string> lines = makeLines(1000);
+    std::string frames = makeFrames(lines);
+
+    RingBuffer rx(1 << 20);
+    Stream stream(nullptr, &rx);
+    RecordFramer framer(&stream);
+    RecordCodec codec(recordTypes);
+    std::vector<RecordValue> values;
+
+    for(auto _ : state)
+    {
+        stream.pushBackRxBuffer(frames.data(), frames.size());
+        while(codec.popRecord(framer, values))
+        {
+            benchmark::DoNotOptimize(values.data());
+        }
+    }
+
+    state.SetBytesProcessed(state.iterations() * frames.size());
+    state.SetItemsProcessed(state.iterations() * lines.size());
+    state.counters["bytes/row"] = (double)frames.size() / lines.size();
+}
+BENCHMARK(BM_RecordBinaryRows);
+
+/// @brief Typed encode of a record and push of its frame to TX buffer.
+static void BM_RecordPush(benchmark::State& state)
+{
+    RingBuffer tx(1 << 16);
+    Stream stream(&tx, nullptr);
+    RecordFramer framer(&stream);
+    RecordCodec codec(recordTypes);
+    uint32_t counter = 0;
+
+    for(auto _ : state)
+    {
+        if(!codec.pushRecord(framer, counter, 1712345678.125, 35.6892, 51.3890, 1203.5f, (uint8_t)counter, true, std::string_view("GPS_FIX_3D")))
+        {
+            stream.removeAllTxBuffer();
+        }
+
+        counter++;
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RecordPush);
+
+static void BM_Crc32c(benchmark::State& state)
+{
+    std::string data(state.range(0), 'x');
+
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(crc32c(data.data(), data.size()));
+    }
+
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+BENCHMARK(BM_Crc32c)->Arg(64)->Arg(4096);
@@ -0,0 +1,152 @@
+// ####################################################################################################
+// Benchmark of splitString, checkValuetype and findCharacter.
+// Build: cmake -S .. -B build && cmake --build build --target SplitBenchmark
+
+// ####################################################################################################
+// Include libraries:
+
+#include <benchmark/benchmark.h>    // Google Benchmark
+#include <cstring>                  // std::memchr
+#include "Stream.h"
+
+// ####################################################################################################
+// Benchmark data:
+
+/// @brief Realistic CSV telemetry rows.
+static std::string makeRows(size_t count)
+{
+    std::string rows;
+
+    for(size_t i = 0; i < count; i++)
+    {
+        rows += std::to_string(i) + ", 1712345678.125, 35.6892, 51.3890, 1203.5, " + std::to_string(i % 256) + ", true, GPS_FIX_3D\n";
+    }
+
+    return rows;
+}
+
+/// @brief Split text to lines.
+static std::vector<std::string> makeLines(size_t count)
+{
+    return splitString(makeRows(count), '\n');
+}
+
+// ####################################################################################################
+// Benchmarks:
+
+static void BM_SplitStringStream(benchmark::State& state)
+{
+    std::vector<std::string> lines = makeLines(1000);
+    size_t bytes = 0;
+
+    for(auto _ : state)
+    {
+        for(const auto& line : lines)
+        {
+            std::vector<std::string> tokens = splitString(line, ',');
+            benchmark::DoNotOptimize(tokens.data());
+            bytes += line.size();
+        }
+    }
+
+    state.SetBytesProcessed(bytes);
+    state.SetItemsProcessed(state.iterations() * lines.size());
+}
+BENCHMARK(BM_SplitStringStream);
+
+static void BM_SplitStringView(benchmark::State& state)
+{
+    std::vector<std::string> lines = makeLines(1000);
+    std::vector<std::string_view> tokens;
+    size_t bytes = 0;
+
+    for(auto _ : state)
+    {
+        for(const auto& line : lines)
+        {
+            splitString(std::string_view(line), ',', tokens);
+            benchmark::DoNotOptimize(tokens.data());
+            bytes += line.size();
+        }
+    }
+
+    state.SetBytesProcessed(bytes);
+    state.SetItemsProcessed(state.iterations() * lines.size());
+}
+BENCHMARK(BM_SplitStringView);
+
+static void BM_FindCharacter(benchmark::State& state)
+{
+    std::string data(state.range(0), 'x');
+    data.back() = '\n';
+
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(findCharacter(data.data(), data.size(), '\n'));
+    }
+
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+BENCHMARK(BM_FindCharacter)->Arg(64)->Arg(1024)->Arg(65536);
+
+static void BM_FindCharacterLoop(benchmark::State& state)
+{
+    std::string data(state.range(0), 'x');
+    data.back() = '\n';
+
+    for(auto _ : state)
+    {
+        size_t i = 0;
+        while(data[i] != '\n')
+        {
+            i++;
+        }
+        benchmark::DoNotOptimize(i);
+    }
+
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+BENCHMARK(BM_FindCharacterLoop)->Arg(64)->Arg(1024)->Arg(65536);
+
+static void BM_FindRxRing(benchmark::State& state)
+{
+    RingBuffer tx(16), rx(state.range(0));
+    Stream stream(&tx, &rx);
+    std::string data(rx.capacity() - 1, 'x');
+    data.push_back('\n');
+    stream.pushBackRxBuffer(data.data(), data.size());
+
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(stream.findRx('\n'));
+    }
+
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+BENCHMARK(BM_FindRxRing)->Arg(1024)->Arg(65536);
+
+static void BM_SplitValidateRow(benchmark::State& state)
+{
+    std::vector<std::string> lines = makeLines(1000);
+    std::vector<std::string_view> tokens;
+    static const std::string_view types[] = {"uint32", "double", "double", "double", "float", "uint8", "bool", "string"};
+    size_t bytes = 0;
+
+    for(auto _ : state)
+    {
+        for(const auto& line : lines)
+        {
+            bool valid = splitString(std::string_view(line), ',', tokens) == std::size(types);
+            for(size_t i = 0; valid && (i < tokens.size()); i++)
+            {
+                valid = checkValuetype(tokens[i], types[i]);
+            }
+            benchmark::DoNotOptimize(valid);
+            bytes += line.size();
+        }
+    }
+
+    state.SetBytesProcessed(bytes);
+    state.SetItemsProcessed(state.iterations() * lines.size());
+}
+BENCHMARK(BM_SplitValidateRow);
@@ -0,0 +1,419 @@
+// ####################################################################################################
+// Benchmark of Stream push/pop for deque and ring buffer backends, of descriptor I/O, of capture to file and of
+// channel multiplexing.
+// Build: cmake -S .. -B build && cmake --build build --target StreamBenchmark
+
+// ####################################################################################################
+// Include libraries:
+
+#include <benchmark/benchmark.h>    // Google Benchmark
+#include <array>                    // Pipe descriptor pairs
+#include <mutex>                    // Mutex baseline of multi producer push
+#include <cstdio>                   // fwrite baseline of capture
+#include <fcntl.h>                  // pipe2
+#include <unistd.h>                 // unlink
+#include "Stream.h"
+#include "StreamUring.h"
+#include "MappedRingBuffer.h"
+#include "StreamMux.h"
+
+// ####################################################################################################
+// Benchmark data:
+
+/// @brief Backend of benchmark stream.
+enum Backend : int64_t
+{
+    DEQUE,
+    RING
+};
+
+/**
+ * @struct BenchStream
+ * @brief Stream with deque or ring buffer backend. Buffer size is the same for both backends.
+ */
+struct BenchStream
+{
+    std::deque<char> txDeque, rxDeque;
+    RingBuffer txRing, rxRing;
+    Stream stream;
+
+    BenchStream(int64_t backend, size_t size) : txRing(size), rxRing(size)
+    {
+        if(backend == RING)
+        {
+            stream.setTxBuffer(&txRing);
+            stream.setRxBuffer(&rxRing);
+        }
+        else
+        {
+            stream.setTxBuffer(&txDeque, size);
+            stream.setRxBuffer(&rxDeque, size);
+        }
+    }
+};
+
+/// @brief Arguments: backend and buffer size.
+static void bufferArgs(benchmark::internal::Benchmark* benchmark)
+{
+    benchmark->ArgNames({"backend", "size"});
+
+    for(int64_t backend : {DEQUE, RING})
+    {
+        for(int64_t size : {256, 4096, 65536})
+        {
+            benchmark->Args({backend, size});
+        }
+    }
+}
+
+// ####################################################################################################
+// Benchmarks:
+
+static void BM_PushPopByte(benchmark::State& state)
+{
+    BenchStream bench(state.range(0), state.range(1));
+    Stream &stream = bench.stream;
+    size_t size = state.range(1);
+    char value = 'x';
+
+    for(auto _ : state)
+    {
+        for(size_t i = 0; i < size; i++)
+        {
+            stream.pushBackRxBuffer(&value, 1);
+        }
+        for(size_t i = 0; i < size; i++)
+        {
+            benchmark::DoNotOptimize(stream.tryPopFrontRxBuffer(&value, 1));
+        }
+    }
+
+    state.SetBytesProcessed(state.iterations() * size);
+}
+BENCHMARK(BM_PushPopByte)->Apply(bufferArgs);
+
+static void BM_PushPopBulk(benchmark::State& state)
+{
+    BenchStream bench(state.range(0), state.range(1));
+    Stream &stream = bench.stream;
+    std::string data(state.range(1), 'x');
+
+    for(auto _ : state)
+    {
+        stream.pushBackRxBuffer(data.data(), data.size());
+        benchmark::DoNotOptimize(stream.tryPopFrontRxBuffer(data.data(), data.size()));
+    }
+
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+BENCHMARK(BM_PushPopBulk)->Apply(bufferArgs);
+
+static void BM_PopFrontRxString(benchmark::State& state)
+{
+    BenchStream bench(state.range(0), state.range(1));
+    Stream &stream = bench.stream;
+    std::string data(state.range(1), 'x');
+
+    for(auto _ : state)
+    {
+        stream.pushBackRxBuffer(data.data(), data.size());
+        benchmark::DoNotOptimize(stream.popFrontRxBuffer(data.size()));
+    }
+
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+BENCHMARK(BM_PopFrontRxString)->Apply(bufferArgs);
+
+static void BM_PopFrontRxPooled(benchmark::State& state)
+{
+    BenchStream bench(state.range(0), state.range(1));
+    Stream &stream = bench.stream;
+    std::string data(state.range(1), 'x');
+    BufferPool pool;
+
+    for(auto _ : state)
+    {
+        stream.pushBackRxBuffer(data.data(), data.size());
+        benchmark::DoNotOptimize(stream.popFrontRxBuffer(data.size(), pool));
+    }
+
+    state.SetBytesProcessed(state.iterations() * data.size());
+    state.counters["upstream"] = pool.getUpstreamCount();
+}
+BENCHMARK(BM_PopFrontRxPooled)->Apply(bufferArgs);
+
+static void BM_OverflowEviction(benchmark::State& state)
+{
+    BenchStream bench(state.range(0), state.range(1));
+    Stream &stream = bench.stream;
+    std::string data(state.range(1), 'x');
+
+    // Keep buffer full, so every push removes old data. It is the steady state of a consumer that is too slow.
+    stream.pushBackRxBuffer(data.data(), data.size());
+    std::string row(64, 'y');
+
+    for(auto _ : state)
+    {
+        stream.pushBackRxBuffer(row.data(), row.size());
+    }
+
+    state.SetBytesProcessed(state.iterations() * row.size());
+}
+BENCHMARK(BM_OverflowEviction)->Apply(bufferArgs);
+
+/// @brief Shared TX stream of multi producer benchmarks. Thread 0 is also the consumer.
+static RingBuffer sharedTx(1 << 20), sharedRx(16);
+static Stream sharedStream(&sharedTx, &sharedRx);
+static std::mutex sharedMutex;
+
+static void BM_MultiProducerMutex(benchmark::State& state)
+{
+    std::string row(64, 'x');
+    char chunk[4096];
+
+    for(auto _ : state)
+    {
+        {
+            std::lock_guard<std::mutex> lock(sharedMutex);
+            sharedStream.pushBackTxBuffer(row);
+        }
+
+        if(state.thread_index() == 0)
+        {
+            std::lock_guard<std::mutex> lock(sharedMutex);
+            while(sharedStream.tryPopFrontTxBuffer(chunk, sizeof(chunk)));
+        }
+    }
+
+    state.SetBytesProcessed(state.iterations() * row.size());
+}
+BENCHMARK(BM_MultiProducerMutex)->ThreadRange(1, 8)->UseRealTime();
+
+static void BM_MultiProducerMpsc(benchmark::State& state)
+{
+    std::string row(64, 'x');
+    char chunk[4096];
+
+    if(state.thread_index() == 0)
+    {
+        sharedStream.setMpscMode(true);
+    }
+
+    for(auto _ : state)
+    {
+        sharedStream.pushBackTxBuffer(row);
+
+        if(state.thread_index() == 0)
+        {
+            while(sharedStream.tryPopFrontTxBuffer(chunk, sizeof(chunk)));
+        }
+    }
+
+    state.SetBytesProcessed(state.iterations() * row.size());
+}
+BENCHMARK(BM_MultiProducerMpsc)->ThreadRange(1, 8)->UseRealTime();
+
+/**
+ * @struct PipeSet
+ * @brief Non-blocking pipes with a ring buffer stream for each read end.
+ */
+struct PipeSet
+{
+    std::vector<std::array<int, 2>> pipes;
+    std::vector<std::unique_ptr<RingBuffer>> rings;
+    std::vector<std::unique_ptr<Stream>> streams;
+    std::string data;
+
+    PipeSet(size_t count, size_t size) : pipes(count), data(size, 'x')
+    {
+        for(auto &fds : pipes)
+        {
+            pipe2(fds.data(), O_NONBLOCK);
+            rings.push_back(std::make_unique<RingBuffer>(65536));
+            streams.push_back(std::make_unique<Stream>(rings.back().get(), rings.back().get()));
+        }
+    }
+
+    ~PipeSet()
+    {
+        for(auto &fds : pipes)
+        {
+            close(fds[0]);
+            close(fds[1]);
+        }
+    }
+
+    /// @brief Write data to all pipes.
+    void write(void)
+    {
+        for(auto &fds : pipes)
+        {
+            ssize_t written = ::write(fds[1], data.data(), data.size());
+            benchmark::DoNotOptimize(written);
+        }
+    }
+};
+
+static void BM_PipeFillSync(benchmark::State& state)
+{
+    PipeSet set(state.range(0), state.range(1));
+
+    for(auto _ : state)
+    {
+        set.write();
+
+        for(size_t i = 0; i < set.pipes.size(); i++)
+        {
+            set.streams[i]->fillRx(set.pipes[i][0]);
+            set.streams[i]->consumeRx(SIZE_MAX);
+        }
+    }
+
+    state.SetBytesProcessed(state.iterations() * set.pipes.size() * set.data.size());
+}
+BENCHMARK(BM_PipeFillSync)->ArgNames({"pipes", "size"})->Args({1, 4096})->Args({8, 4096})->Args({8, 512});
+
+static void BM_PipeFillUring(benchmark::State& state)
+{
+    PipeSet set(state.range(0), state.range(1));
+    StreamUring uring;
+
+    for(size_t i = 0; i < set.pipes.size(); i++)
+    {
+        uring.add(set.pipes[i][0], set.streams[i].get(), [](Stream &stream, int, bool, int) { stream.consumeRx(SIZE_MAX); });
+    }
+
+    for(auto _ : state)
+    {
+        set.write();
+
+        // All reads of one iteration are submitted and completed with one system call.
+        for(auto &fds : set.pipes)
+        {
+            uring.fill(fds[0]);
+        }
+        uring.submit(set.pipes.size());
+    }
+
+    state.SetBytesProcessed(state.iterations() * set.pipes.size() * set.data.size());
+    state.SetLabel(uring.isUring() ? "io_uring" : "fallback");
+}
+BENCHMARK(BM_PipeFillUring)->ArgNames({"pipes", "size"})->Args({1, 4096})->Args({8, 4096})->Args({8, 512});
+
+/// @brief Capture baseline: RX data is pushed to ring buffer and mirrored to a file with fwrite.
+static void BM_CaptureFwrite(benchmark::State& state)
+{
+    const char* path = "/tmp/stream_bench_capture.bin";
+    FILE* file = std::fopen(path, "wb");
+    RingBuffer rx(1 << 20);
+    Stream stream(nullptr, &rx);
+    std::string data(state.range(0), 'x');
+
+    for(auto _ : state)
+    {
+        stream.pushBackRxBuffer(data.data(), data.size());
+        std::fwrite(data.data(), 1, data.size(), file);
+        stream.consumeRx(SIZE_MAX);
+    }
+
+    std::fclose(file);
+    unlink(path);
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+BENCHMARK(BM_CaptureFwrite)->Arg(64)->Arg(4096);
+
+/// @brief Capture with mapped ring: RX buffer itself is the file.
+static void BM_CaptureMapped(benchmark::State& state)
+{
+    const char* path = "/tmp/stream_bench_capture.ring";
+    unlink(path);
+    MappedRingBuffer rx;
+    rx.open(path, 1 << 20);
+    Stream stream(nullptr, &rx);
+    std::string data(state.range(0), 'x');
+
+    for(auto _ : state)
+    {
+        stream.pushBackRxBuffer(data.data(), data.size());
+        stream.consumeRx(SIZE_MAX);
+    }
+
+    rx.close();
+    unlink(path);
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+BENCHMARK(BM_CaptureMapped)->Arg(64)->Arg(4096);
+
+/// @brief Link RX with tagged frames of 4 channels for demultiplexing benchmarks.
+struct DemuxSet
+{
+    RingBuffer linkRx{1 << 16};
+    Stream link{nullptr, &linkRx};
+    std::vector<std::unique_ptr<RingBuffer>> rings;
+    std::vector<std::unique_ptr<Stream>> channels;
+    std::string frames;
+
+    DemuxSet(size_t size)
+    {
+        RecordFramer framer;
+        std::string payload(size + 1, 'x');
+        std::string frame;
+
+        for(uint8_t id = 0; id < 4; id++)
+        {
+            rings.push_back(std::make_unique<RingBuffer>(1 << 16));
+            channels.push_back(std::make_unique<Stream>(nullptr, rings.back().get()));
+            payload[0] = (char)id;
+            framer.encodeFrame(payload.data(), payload.size(), frame);
+            frames += frame;
+        }
+    }
+};
+
+/// @brief Baseline: pop each frame to a string and copy it to its channel stream.
+static void BM_DemuxPopFrame(benchmark::State& state)
+{
+    DemuxSet set(state.range(0));
+    RecordFramer framer(&set.link);
+    std::string payload;
+
+    for(auto _ : state)
+    {
+        set.link.pushBackRxBuffer(set.frames.data(), set.frames.size());
+        while(framer.popFrame(payload))
+        {
+            set.channels[(uint8_t)payload[0]]->pushBackRxBuffer(payload.data() + 1, payload.size() - 1);
+        }
+        for(auto &channel : set.channels)
+        {
+            channel->consumeRx(SIZE_MAX);
+        }
+    }
+
+    state.SetBytesProcessed(state.iterations() * set.frames.size());
+}
+BENCHMARK(BM_DemuxPopFrame)->Arg(64)->Arg(1000);
+
+/// @brief StreamMux routes frames from link RX directly to channel RX.
+static void BM_DemuxStreamMux(benchmark::State& state)
+{
+    DemuxSet set(state.range(0));
+    StreamMux mux(&set.link, 2048);
+    for(uint8_t id = 0; id < 4; id++)
+    {
+        mux.addChannel(id, set.channels[id].get());
+    }
+
+    for(auto _ : state)
+    {
+        set.link.pushBackRxBuffer(set.frames.data(), set.frames.size());
+        mux.pollRx();
+        for(auto &channel : set.channels)
+        {
+            channel->consumeRx(SIZE_MAX);
+        }
+    }
+
+    state.SetBytesProcessed(state.iterations() * set.frames.size());
+}
+BENCHMARK(BM_DemuxStreamMux)->Arg(64)->Arg(1000);
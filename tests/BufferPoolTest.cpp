@@ -0,0 +1,247 @@
+// ####################################################################################################
+// Tests of BufferPool and PooledBuffer: size classes, upstream fallback, reference counts and pooled pops.
+// Build: cmake -S .. -B build && cmake --build build --target BufferPoolTest && ctest --test-dir build
+
+// ####################################################################################################
+// Include libraries:
+
+#include <gtest/gtest.h>            // Google Test
+#include <memory_resource>          // Counting upstream resource
+#include <string>                   // String class and related functions
+#include <utility>                  // std::move
+#include <vector>                   // Held buffers
+#include "BufferPool.h"
+#include "StreamFramer.h"
+
+// ####################################################################################################
+// Test helpers:
+
+/**
+ * @class CountingResource
+ * @brief Upstream resource that counts allocated bytes and blocks.
+ */
+class CountingResource : public std::pmr::memory_resource
+{
+public:
+
+    size_t bytes = 0;                   ///! @brief Bytes that are allocated and not deallocated.
+    size_t blocks = 0;                  ///! @brief Blocks that are allocated and not deallocated.
+
+protected:
+
+    void* do_allocate(size_t size, size_t alignment) override
+    {
+        bytes += size;
+        blocks++;
+        return std::pmr::new_delete_resource()->allocate(size, alignment);
+    }
+
+    void do_deallocate(void* p, size_t size, size_t alignment) override
+    {
+        bytes -= size;
+        blocks--;
+        std::pmr::new_delete_resource()->deallocate(p, size, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+    {
+        return this == &other;
+    }
+};
+
+/// @brief Largest block size of size classes.
+static const size_t maxBlock = (size_t)BUFFER_POOL_MIN_BLOCK << (BUFFER_POOL_CLASSES - 1);
+
+/// @brief Return block header size, the difference of smallest block and its data capacity.
+static size_t headerSize(BufferPool &pool)
+{
+    return BUFFER_POOL_MIN_BLOCK - pool.acquire(1).capacity();
+}
+
+// ####################################################################################################
+// Tests:
+
+TEST(BufferPool, SizeClassIsSmallestFittingBlock)
+{
+    BufferPool pool;
+    size_t header = headerSize(pool);
+    ASSERT_GT(header, 0u);
+    ASSERT_LT(header, (size_t)BUFFER_POOL_MIN_BLOCK);
+
+    EXPECT_TRUE(pool.acquire(0).empty());
+    EXPECT_EQ(pool.acquire(0).capacity(), 0u);
+
+    for(size_t block = BUFFER_POOL_MIN_BLOCK; block <= maxBlock; block *= 2)
+    {
+        // Exact fit stays in class. One more byte goes to the next class.
+        PooledBuffer exact = pool.acquire(block - header);
+        EXPECT_EQ(exact.size(), block - header);
+        EXPECT_EQ(exact.capacity(), block - header) << block;
+
+        if(block < maxBlock)
+        {
+            EXPECT_EQ(pool.acquire(block - header + 1).capacity(), block * 2 - header) << block;
+        }
+    }
+
+    // Blocks of held handles are different.
+    PooledBuffer a = pool.acquire(10);
+    PooledBuffer b = pool.acquire(10);
+    EXPECT_NE(a.data(), b.data());
+}
+
+TEST(BufferPool, LargeBlocksFallBackToUpstream)
+{
+    CountingResource upstream;
+    {
+        BufferPool pool(&upstream);
+        size_t header = headerSize(pool);
+        size_t slabBlocks = upstream.blocks;
+
+        // Largest class is still a slab block.
+        PooledBuffer largest = pool.acquire(maxBlock - header);
+        EXPECT_EQ(pool.getUpstreamCount(), 2u);
+        EXPECT_EQ(upstream.blocks, slabBlocks + 1);
+
+        // Larger block is taken from upstream with exact capacity and given back on release.
+        uint64_t upstreamCount = pool.getUpstreamCount();
+        size_t slabBytes = pool.getSlabBytes();
+        PooledBuffer large = pool.acquire(maxBlock - header + 1);
+        EXPECT_EQ(large.capacity(), maxBlock - header + 1);
+        EXPECT_EQ(pool.getUpstreamCount(), upstreamCount + 1);
+        EXPECT_EQ(pool.getSlabBytes(), slabBytes);
+        EXPECT_EQ(upstream.blocks, slabBlocks + 2);
+
+        large.data()[large.size() - 1] = 'x';
+        large.reset();
+        EXPECT_EQ(upstream.blocks, slabBlocks + 1);
+        EXPECT_EQ(upstream.bytes, pool.getSlabBytes());
+    }
+
+    // Destructor gives slabs back.
+    EXPECT_EQ(upstream.blocks, 0u);
+    EXPECT_EQ(upstream.bytes, 0u);
+}
+
+TEST(BufferPool, LastHandleReleasesBlock)
+{
+    BufferPool pool;
+    PooledBuffer first = pool.acquire(100);
+    char* block = first.data();
+    EXPECT_EQ(first.useCount(), 1u);
+
+    PooledBuffer copy = first;
+    PooledBuffer assigned;
+    assigned = copy;
+    EXPECT_EQ(first.useCount(), 3u);
+    EXPECT_EQ(assigned.data(), block);
+
+    PooledBuffer moved = std::move(copy);
+    EXPECT_EQ(copy.useCount(), 0u);
+    EXPECT_EQ(copy.data(), nullptr);
+    EXPECT_EQ(moved.useCount(), 3u);
+
+    // Self assignment keeps the block.
+    PooledBuffer &self = moved;
+    moved = self;
+    EXPECT_EQ(moved.useCount(), 3u);
+
+    first.reset();
+    assigned.reset();
+    EXPECT_EQ(moved.useCount(), 1u);
+
+    // Block is not free while a handle has it.
+    PooledBuffer other = pool.acquire(100);
+    EXPECT_NE(other.data(), block);
+    other.reset();
+
+    // Freed blocks are reused last in, first out.
+    moved.reset();
+    EXPECT_EQ(pool.acquire(100).data(), block);
+}
+
+TEST(BufferPool, ResizeKeepsBlock)
+{
+    BufferPool pool;
+    PooledBuffer buffer = pool.acquire(10);
+    size_t capacity = buffer.capacity();
+
+    EXPECT_TRUE(buffer.resize(capacity));
+    EXPECT_EQ(buffer.size(), capacity);
+    EXPECT_FALSE(buffer.resize(capacity + 1));
+    EXPECT_TRUE(buffer.resize(0));
+    EXPECT_TRUE(buffer.empty());
+    EXPECT_EQ(buffer.capacity(), capacity);
+
+    PooledBuffer empty;
+    EXPECT_TRUE(empty.resize(0));
+    EXPECT_FALSE(empty.resize(1));
+}
+
+TEST(BufferPool, SteadyStateDoesNotTakeUpstream)
+{
+    BufferPool pool;
+    pool.reserve(1000, 8);
+    uint64_t upstreamCount = pool.getUpstreamCount();
+
+    for(int round = 0; round < 100; round++)
+    {
+        std::vector<PooledBuffer> held;
+        for(int i = 0; i < 8; i++)
+        {
+            held.push_back(pool.acquire(1000));
+        }
+        held.push_back(pool.acquire(10));
+    }
+
+    // One slab for the small class.
+    EXPECT_EQ(pool.getUpstreamCount(), upstreamCount + 1);
+}
+
+TEST(BufferPool, MemoryResourceForPmrTokens)
+{
+    BufferPool pool;
+    std::pmr::vector<std::pmr::string> tokens(&pool);
+
+    std::string line = " a long token that does not fit in small string buffer , b ,c ";
+    ASSERT_EQ(splitString(line, ',', tokens), 3u);
+    EXPECT_EQ(tokens[0], "a long token that does not fit in small string buffer");
+    EXPECT_EQ(tokens[2], "c");
+    EXPECT_EQ(tokens[0].get_allocator().resource(), &pool);
+
+    uint64_t upstreamCount = pool.getUpstreamCount();
+    for(int i = 0; i < 100; i++)
+    {
+        splitString(line, ',', tokens);
+    }
+    EXPECT_EQ(pool.getUpstreamCount(), upstreamCount);
+}
+
+TEST(BufferPool, PooledStreamPopsAndFrames)
+{
+    RingBuffer tx(64);
+    RingBuffer rx(64);
+    Stream stream(&tx, &rx);
+    BufferPool pool;
+
+    EXPECT_TRUE(stream.popAllRxBuffer(pool).empty());
+
+    stream.pushBackRxBuffer("0123456789", 10);
+    PooledBuffer front = stream.popFrontRxBuffer(4, pool);
+    EXPECT_EQ(front.view(), "0123");
+    EXPECT_EQ(stream.popAllRxBuffer(pool).view(), "456789");
+
+    // SLIP payload is decoded in place in the pooled block.
+    SlipFramer framer(&stream, 32);
+    std::string frame;
+    ASSERT_TRUE(framer.encodeFrame("\xC0" "ab" "\xDB", 4, frame));
+    stream.pushBackRxBuffer(frame.data(), frame.size());
+
+    PooledBuffer payload = front;
+    ASSERT_TRUE(framer.popFrame(payload, pool));
+    EXPECT_EQ(payload.view(), "\xC0" "ab" "\xDB");
+    EXPECT_EQ(front.useCount(), 1u);
+
+    EXPECT_FALSE(framer.popFrame(payload, pool));
+    EXPECT_EQ(payload.data(), nullptr);
+}
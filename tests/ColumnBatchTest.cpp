@@ -0,0 +1,158 @@
+// ####################################################################################################
+// Tests of ColumnBatch: columnar decode of text blocks and Stream RX lines.
+// Build: cmake -S .. -B build && cmake --build build --target ColumnBatchTest && ctest --test-dir build
+
+// ####################################################################################################
+// Include libraries:
+
+#include <gtest/gtest.h>            // Google Test
+#include <string>                   // String class and related functions
+#include <vector>                   // Dynamic array container
+#include "ColumnBatch.h"
+
+// ####################################################################################################
+// Test helpers:
+
+/// @brief Validate row with the string based functions of Stream.h.
+static bool validateWithStrings(const std::string &line, const std::vector<std::string> &types)
+{
+    std::vector<std::string> tokens = splitString(line, ',');
+
+    if(!validateRow(tokens, types.size()))
+    {
+        return false;
+    }
+
+    for(size_t i = 0; i < tokens.size(); i++)
+    {
+        if(!checkValuetype(tokens[i], types[i]))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// ####################################################################################################
+// Tests:
+
+TEST(ColumnBatch, DecodesTextBlockToColumns)
+{
+    ColumnBatch batch({ValueType::UINT16, ValueType::FLOAT, ValueType::STRING, ValueType::BOOL});
+
+    EXPECT_EQ(batch.parse("1, 1.5, GPS, true\r\n\n   \n2,x,IMU,false\n3, -2.5, , true\n4,0.5,BARO,FALSE"), 2u);
+    ASSERT_EQ(batch.rowCount(), 4u);
+    EXPECT_EQ(batch.validRowCount(), 2u);
+
+    EXPECT_TRUE(batch.isValid(0));
+    EXPECT_FALSE(batch.isValid(1));
+    EXPECT_FALSE(batch.isValid(2));
+    EXPECT_TRUE(batch.isValid(3));
+    EXPECT_EQ(batch.validity()[0], 0b1001u);
+
+    const std::vector<uint16_t>* ids = batch.column<uint16_t>(0);
+    ASSERT_NE(ids, nullptr);
+    EXPECT_EQ(*ids, (std::vector<uint16_t>{1, 0, 0, 4}));
+
+    const std::vector<float>* values = batch.column<float>(1);
+    ASSERT_NE(values, nullptr);
+    EXPECT_FLOAT_EQ((*values)[0], 1.5f);
+    EXPECT_FLOAT_EQ((*values)[1], 0.0f);
+
+    const StringColumn* names = batch.stringColumn(2);
+    ASSERT_NE(names, nullptr);
+    EXPECT_EQ(names->at(0), "GPS");
+    EXPECT_EQ(names->at(1), "");
+    EXPECT_EQ(names->at(3), "BARO");
+
+    EXPECT_EQ(batch.column<double>(1), nullptr);
+    EXPECT_EQ(batch.stringColumn(0), nullptr);
+}
+
+TEST(ColumnBatch, SameValidityAsStringFunctions)
+{
+    const std::vector<std::string> types = {"int8", "uint32", "double", "string"};
+    const std::vector<std::string> lines = {
+        "1,2,3.5,a",
+        "-128,4294967295,1e300,b",
+        "128,1,1,c",
+        "1,-1,1,d",
+        "1,2,1e400,e",
+        "1,2,3,f,",
+        "1,2,3,g,,",
+        "1,2,3",
+        "1,2,3,h,i",
+        "+1, +2 , +3 , j k ",
+    };
+
+    ColumnBatch batch;
+    ASSERT_TRUE(batch.setColumnTypes(types));
+
+    for(const std::string &line : lines)
+    {
+        EXPECT_EQ(batch.parseRow(line), validateWithStrings(line, types)) << '"' << line << '"';
+    }
+
+    EXPECT_EQ(batch.rowCount(), lines.size());
+    EXPECT_FALSE(batch.setColumnTypes(std::vector<std::string>{"int8", "text"}));
+}
+
+TEST(ColumnBatch, ParseStreamKeepsIncompleteLine)
+{
+    RingBuffer tx(64);
+    RingBuffer rx(64);
+    Stream stream(&tx, &rx);
+
+    // Move indices so that a line is split at the wrap point.
+    stream.pushBackRxBuffer("0123456789012345678901234567890123456789012345678901234", 55);
+    stream.consumeRx(55);
+
+    ColumnBatch batch({ValueType::INT32, ValueType::STRING});
+    stream.pushBackRxBuffer("10,first\n20,wrapped\n30,pa", 25);
+
+    EXPECT_EQ(batch.parse(stream), 2u);
+    EXPECT_EQ(stream.popAllRxBuffer(), "30,pa");
+    EXPECT_EQ(batch.stringColumn(1)->at(1), "wrapped");
+
+    std::deque<char> txDeque;
+    std::deque<char> rxDeque;
+    Stream dequeStream(&txDeque, 64, &rxDeque, 64);
+    dequeStream.pushBackRxBuffer("40,deque\n50", 11);
+    EXPECT_EQ(batch.parse(dequeStream), 1u);
+    EXPECT_EQ(dequeStream.popAllRxBuffer(), "50");
+    EXPECT_EQ((*batch.column<int32_t>(0)), (std::vector<int32_t>{10, 20, 40}));
+}
+
+TEST(ColumnBatch, ClearKeepsTypesAndMemory)
+{
+    ColumnBatch batch({ValueType::UINT8, ValueType::STRING}, ';');
+    std::string text;
+    for(int i = 0; i < 100; i++)
+    {
+        text += std::to_string(i) + ";name" + std::to_string(i) + "\n";
+    }
+
+    EXPECT_EQ(batch.parse(text), 100u);
+    const uint8_t* data = batch.column<uint8_t>(0)->data();
+
+    batch.clear();
+    EXPECT_EQ(batch.rowCount(), 0u);
+    EXPECT_EQ(batch.validRowCount(), 0u);
+    EXPECT_EQ(batch.columnType(1), ValueType::STRING);
+
+    EXPECT_EQ(batch.parse(text), 100u);
+    EXPECT_EQ(batch.column<uint8_t>(0)->data(), data);
+    EXPECT_EQ(batch.stringColumn(1)->at(99), "name99");
+}
+
+TEST(ColumnBatch, ValueTypeNames)
+{
+    for(const char* name : {"uint8", "uint16", "uint32", "uint64", "int8", "int16", "int32", "int64", "float", "double", "string", "bool"})
+    {
+        EXPECT_STREQ(getValueTypeName(getValueType(name)), name);
+    }
+
+    EXPECT_EQ(getValueType("text"), ValueType::NONE);
+    EXPECT_STREQ(getValueTypeName(ValueType::NONE), "none");
+}
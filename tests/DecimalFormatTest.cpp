@@ -0,0 +1,124 @@
+// ####################################################################################################
+// Tests of decimalToChars, decimalToString and Stream::pushBackTxDecimal against ostringstream output.
+// Build: cmake -S .. -B build && cmake --build build --target DecimalFormatTest && ctest --test-dir build
+
+// ####################################################################################################
+// Include libraries:
+
+#include <gtest/gtest.h>            // Google Test
+#include <cmath>                    // NAN, INFINITY
+#include <cstring>                  // std::memcpy
+#include <iomanip>                  // std::setprecision
+#include <limits>                   // std::numeric_limits
+#include <random>                   // Random test values
+#include <sstream>                  // Reference formatting
+#include <string>                   // String class and related functions
+#include "Stream.h"
+
+// ####################################################################################################
+// Test helpers:
+
+/// @brief Reference formatting with std::fixed and std::setprecision.
+template<typename T>
+static std::string formatReference(T value, uint8_t precision)
+{
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(precision) << value;
+    return oss.str();
+}
+
+/// @brief Format with decimalToChars.
+template<typename T>
+static std::string formatChars(T value, uint8_t precision)
+{
+    char buffer[DECIMAL_STRING_MAX_SIZE];
+    return std::string(buffer, decimalToChars(value, precision, buffer, sizeof(buffer)));
+}
+
+/// @brief Random double with random sign, exponent and mantissa bits.
+static double randomDouble(std::mt19937_64 &random)
+{
+    switch(random() % 4)
+    {
+        case 0:
+            return std::uniform_real_distribution<double>(-1.0, 1.0)(random);
+        case 1:
+            return std::uniform_real_distribution<double>(-1e6, 1e6)(random);
+        case 2:
+            // Values that are exactly at a rounding step, like 0.125 or 2.5.
+            return (double)((int64_t)(random() % 20001) - 10000) / (double)(1 << (random() % 8));
+        default:
+        {
+            double value;
+            uint64_t bits = random();
+            std::memcpy(&value, &bits, sizeof(value));
+            return std::isfinite(value) ? value : 0.0;
+        }
+    }
+}
+
+// ####################################################################################################
+// Tests:
+
+TEST(DecimalFormat, DoubleMatchesOstreamForRandomValues)
+{
+    std::mt19937_64 random(12);
+
+    for(int i = 0; i < 20000; i++)
+    {
+        double value = randomDouble(random);
+        uint8_t precision = (uint8_t)(i % 18);
+        ASSERT_EQ(formatChars(value, precision), formatReference(value, precision)) << value << " " << (int)precision;
+    }
+}
+
+TEST(DecimalFormat, FloatMatchesOstreamForRandomValues)
+{
+    std::mt19937_64 random(34);
+
+    for(int i = 0; i < 20000; i++)
+    {
+        float value = (float)randomDouble(random);
+        uint8_t precision = (uint8_t)(i % 18);
+        ASSERT_EQ(formatChars(value, precision), formatReference(value, precision)) << value << " " << (int)precision;
+    }
+}
+
+TEST(DecimalFormat, EdgeValues)
+{
+    const double values[] = {0.0, -0.0, 0.5, 1.5, 2.5, -2.5, 0.05, 1e-300, 9.999999999, 1e22, 1e300,
+                             std::numeric_limits<double>::max(), std::numeric_limits<double>::denorm_min(),
+                             std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity(), NAN};
+
+    for(double value : values)
+    {
+        for(uint8_t precision = 0; precision <= 17; precision++)
+        {
+            EXPECT_EQ(formatChars(value, precision), formatReference(value, precision)) << value;
+            EXPECT_EQ(decimalToString(value, precision), formatReference(value, precision)) << value;
+            EXPECT_EQ(formatChars((float)value, precision), formatReference((float)value, precision)) << value;
+        }
+    }
+
+    // Buffer that is too small gives no output.
+    char small[3];
+    EXPECT_EQ(decimalToChars(123.25, 2, small, sizeof(small)), 0u);
+}
+
+TEST(DecimalFormat, PushBackTxDecimalReturnsStoredCount)
+{
+    std::deque<char> tx;
+    std::deque<char> rx;
+    Stream stream(&tx, 64, &rx, 64);
+
+    EXPECT_EQ(stream.pushBackTxDecimal(3.14159, 2), 4u);
+    EXPECT_EQ(stream.pushBackTxDecimal(-2.5f, 3), 6u);
+    EXPECT_EQ(std::string(tx.begin(), tx.end()), "3.14-2.500");
+
+    // Only the last part of a value that is larger than ring buffer is stored.
+    RingBuffer txRing(8);
+    RingBuffer rxRing(8);
+    Stream ringStream(&txRing, &rxRing);
+    EXPECT_EQ(ringStream.pushBackTxDecimal(123456.789, 6), 8u);
+    EXPECT_EQ(txRing.size(), 8u);
+}
@@ -0,0 +1,185 @@
+// ####################################################################################################
+// Tests of MappedRingBuffer: create, reopen, replay of a closed capture and invalid files.
+// Build: cmake -S .. -B build && cmake --build build --target MappedRingBufferTest && ctest --test-dir build
+
+// ####################################################################################################
+// Include libraries:
+
+#include <gtest/gtest.h>            // Google Test
+#include <cerrno>                   // errno
+#include <cstdio>                   // std::remove, std::fopen
+#include <string>                   // String class and related functions
+#include <unistd.h>                 // getpid
+#include "MappedRingBuffer.h"
+#include "Stream.h"
+
+// ####################################################################################################
+// Test helpers:
+
+/**
+ * @struct MappedRingTest
+ * @brief Fixture with a ring file path that is removed after test.
+ */
+struct MappedRingTest : public ::testing::Test
+{
+    std::string path;
+
+    void SetUp() override
+    {
+        path = "/tmp/mapped_ring_test_" + std::to_string(getpid()) + "_" +
+               ::testing::UnitTest::GetInstance()->current_test_info()->name() + ".ring";
+        std::remove(path.c_str());
+    }
+
+    void TearDown() override
+    {
+        std::remove(path.c_str());
+    }
+
+    /// @brief Pop all stored data of ring buffer.
+    static std::string popAll(RingBuffer &ring)
+    {
+        std::string data(ring.size(), '\0');
+        data.resize(ring.pop(data.data(), data.size()));
+        return data;
+    }
+};
+
+// ####################################################################################################
+// Tests:
+
+TEST_F(MappedRingTest, CreateAndReopenKeepsData)
+{
+    {
+        MappedRingBuffer ring;
+        EXPECT_FALSE(ring.isOpen());
+        EXPECT_EQ(ring.capacity(), 0u);
+
+        ASSERT_TRUE(ring.open(path, 1000));
+        EXPECT_TRUE(ring.isOpen());
+        EXPECT_EQ(ring.capacity(), 1024u);
+
+        ring.push("persisted", 9);
+        ring.discard(2);
+        EXPECT_TRUE(ring.sync());
+    }
+
+    // Head and tail continue from the file. Capacity 0 takes capacity of file.
+    MappedRingBuffer ring;
+    ASSERT_TRUE(ring.open(path));
+    EXPECT_EQ(ring.capacity(), 1024u);
+    EXPECT_EQ(popAll(ring), "rsisted");
+    ring.close();
+    EXPECT_FALSE(ring.isOpen());
+
+    errno = 0;
+    EXPECT_FALSE(ring.sync());
+    EXPECT_EQ(errno, EBADF);
+
+    // Capacity of existing file can not change.
+    errno = 0;
+    EXPECT_FALSE(ring.open(path, 4096));
+    EXPECT_EQ(errno, EINVAL);
+    EXPECT_TRUE(ring.open(path, 1024));
+}
+
+TEST_F(MappedRingTest, StreamDataWrapsInFile)
+{
+    MappedRingBuffer rx;
+    ASSERT_TRUE(rx.open(path, 16));
+
+    Stream stream(nullptr, &rx);
+    stream.pushBackRxBuffer("0123456789ab", 12);
+    stream.consumeRx(10);
+    stream.pushBackRxBuffer("cdefghijkl", 10);
+    EXPECT_FALSE(stream.peekRx().second.empty());
+    rx.close();
+
+    ASSERT_TRUE(rx.open(path));
+    Stream reopened(nullptr, &rx);
+    EXPECT_EQ(reopened.popAllRxBuffer(), "abcdefghijkl");
+}
+
+TEST_F(MappedRingTest, ReplayDoesNotChangeFile)
+{
+    {
+        MappedRingBuffer capture;
+        ASSERT_TRUE(capture.open(path, 64));
+        capture.push("frame1frame2", 12);
+    }
+
+    for(int i = 0; i < 2; i++)
+    {
+        MappedRingBuffer replay;
+        ASSERT_TRUE(replay.open(path, 0, true));
+        EXPECT_EQ(popAll(replay), "frame1frame2");
+        EXPECT_TRUE(replay.empty());
+
+        // Push to a replay changes only the private mapping.
+        replay.push("xyz", 3);
+    }
+
+    MappedRingBuffer capture;
+    ASSERT_TRUE(capture.open(path));
+    EXPECT_EQ(popAll(capture), "frame1frame2");
+}
+
+TEST_F(MappedRingTest, CaptureAndReplayExcludeEachOther)
+{
+    MappedRingBuffer producer;
+    MappedRingBuffer consumer;
+    MappedRingBuffer replay;
+
+    // Producer and consumer share a live capture.
+    ASSERT_TRUE(producer.open(path, 64));
+    ASSERT_TRUE(consumer.open(path));
+    producer.push("live", 4);
+    EXPECT_EQ(popAll(consumer), "live");
+
+    // Replay of a live capture would not see its new data.
+    errno = 0;
+    EXPECT_FALSE(replay.open(path, 0, true));
+    EXPECT_EQ(errno, EBUSY);
+
+    producer.close();
+    consumer.close();
+    ASSERT_TRUE(replay.open(path, 0, true));
+
+    errno = 0;
+    EXPECT_FALSE(producer.open(path));
+    EXPECT_EQ(errno, EBUSY);
+
+    replay.close();
+    EXPECT_TRUE(producer.open(path));
+}
+
+TEST_F(MappedRingTest, RejectsMissingAndInvalidFiles)
+{
+    MappedRingBuffer ring;
+
+    // Replay needs an existing file. New file needs a capacity.
+    errno = 0;
+    EXPECT_FALSE(ring.open(path, 64, true));
+    EXPECT_EQ(errno, ENOENT);
+
+    errno = 0;
+    EXPECT_FALSE(ring.open(path));
+    EXPECT_EQ(errno, EINVAL);
+
+    // File that is not a ring file.
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    ASSERT_NE(file, nullptr);
+    std::string garbage(MAPPED_RING_HEADER_SIZE + 64, 'g');
+    std::fwrite(garbage.data(), 1, garbage.size(), file);
+    std::fclose(file);
+
+    errno = 0;
+    EXPECT_FALSE(ring.open(path));
+    EXPECT_EQ(errno, EINVAL);
+    EXPECT_FALSE(ring.isOpen());
+
+    // Failed open does not keep the lock.
+    errno = 0;
+    EXPECT_FALSE(ring.open(path, 0, true));
+    EXPECT_EQ(errno, EINVAL);
+}
@@ -0,0 +1,135 @@
+// ####################################################################################################
+// Tests of ParallelFileParser: chunked parse on worker threads compared with one serial ColumnBatch.
+// Build: cmake -S .. -B build && cmake --build build --target ParallelFileParserTest && ctest --test-dir build
+
+// ####################################################################################################
+// Include libraries:
+
+#include <gtest/gtest.h>            // Google Test
+#include <cstdio>                   // std::remove
+#include <fstream>                  // Test file
+#include <string>                   // String class and related functions
+#include <vector>                   // Dynamic array container
+#include "ParallelFileParser.h"
+
+// ####################################################################################################
+// Test data:
+
+/// @brief Column types of test rows.
+static const std::vector<ValueType> testTypes = {ValueType::UINT32, ValueType::DOUBLE, ValueType::STRING};
+
+/// @brief Make text with valid rows, invalid rows and empty lines.
+static std::string makeText(size_t lines)
+{
+    std::string text;
+
+    for(size_t i = 0; i < lines; i++)
+    {
+        if(i % 17 == 5)
+        {
+            text += "\n";
+        }
+        else if(i % 13 == 3)
+        {
+            text += std::to_string(i) + ",bad,row\n";
+        }
+        else
+        {
+            text += std::to_string(i) + "," + std::to_string(i * 0.5) + ",name" + std::to_string(i % 10) + "\n";
+        }
+    }
+
+    return text;
+}
+
+/// @brief Compare chunk results with a serial parse of the whole text.
+static void expectSameAsSerial(std::string_view text, const std::vector<ChunkResult> &results)
+{
+    ColumnBatch serial(testTypes);
+    std::vector<size_t> invalidLines;
+    serial.parse(text, &invalidLines);
+
+    std::vector<uint32_t> ids;
+    std::vector<size_t> errorLines;
+    size_t rows = 0;
+    size_t nextLine = 1;
+
+    for(const ChunkResult &result : results)
+    {
+        EXPECT_EQ(result.firstLine, nextLine);
+        nextLine += result.lineCount;
+
+        const std::vector<uint32_t>* column = result.batch.column<uint32_t>(0);
+        ASSERT_NE(column, nullptr);
+        ids.insert(ids.end(), column->begin(), column->end());
+        errorLines.insert(errorLines.end(), result.errorLines.begin(), result.errorLines.end());
+        rows += result.batch.rowCount();
+    }
+
+    EXPECT_EQ(rows, serial.rowCount());
+    EXPECT_EQ(ids, *serial.column<uint32_t>(0));
+
+    // Line numbers start from 1, line indexes of ColumnBatch from 0.
+    ASSERT_EQ(errorLines.size(), invalidLines.size());
+    for(size_t i = 0; i < errorLines.size(); i++)
+    {
+        EXPECT_EQ(errorLines[i], invalidLines[i] + 1);
+    }
+}
+
+// ####################################################################################################
+// Tests:
+
+TEST(ParallelFileParser, SameRowsAndErrorLinesAsSerialParse)
+{
+    std::string text = makeText(5000);
+
+    for(unsigned threads : {1u, 2u, 4u})
+    {
+        for(size_t chunkSize : {1, 100, 4096, 1 << 20})
+        {
+            ParallelFileParser parser(testTypes, ',', threads, chunkSize);
+            std::vector<ChunkResult> results;
+            parser.parseText(text, results);
+
+            SCOPED_TRACE(std::to_string(threads) + " threads, chunk " + std::to_string(chunkSize));
+            expectSameAsSerial(text, results);
+        }
+    }
+}
+
+TEST(ParallelFileParser, LastLineWithoutNewlineAndEmptyText)
+{
+    ParallelFileParser parser(testTypes, ',', 2, 8);
+    std::vector<ChunkResult> results;
+
+    std::string text = "1,1.5,a\n2,x,b\n3,2.5,c";
+    parser.parseText(text, results);
+    expectSameAsSerial(text, results);
+
+    parser.parseText("", results);
+    size_t rows = 0;
+    for(const ChunkResult &result : results)
+    {
+        rows += result.batch.rowCount();
+    }
+    EXPECT_EQ(rows, 0u);
+}
+
+TEST(ParallelFileParser, ParsesMappedFile)
+{
+    std::string path = ::testing::TempDir() + "ParallelFileParserTest.csv";
+    std::string text = makeText(2000);
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << text;
+    }
+
+    ParallelFileParser parser(testTypes, ',', 3, 1000);
+    std::vector<ChunkResult> results;
+    ASSERT_TRUE(parser.parseFile(path, results));
+    expectSameAsSerial(text, results);
+    std::remove(path.c_str());
+
+    EXPECT_FALSE(parser.parseFile(path, results));
+}
@@ -0,0 +1,160 @@
+// ####################################################################################################
+// Tests of parseValue and string format check functions.
+// Build: cmake -S .. -B build && cmake --build build --target ParseValueTest && ctest --test-dir build
+
+// ####################################################################################################
+// Include libraries:
+
+#include <gtest/gtest.h>            // Google Test
+#include <string>                   // String class and related functions
+#include "Stream.h"
+
+// ####################################################################################################
+// Test data:
+
+/**
+ * @struct ValueCase
+ * @brief Input string, type name of checkValuetype and expected result.
+ */
+struct ValueCase
+{
+    const char* input;
+    const char* type;
+    bool valid;
+};
+
+/// @brief Table of checkValuetype cases.
+static const ValueCase valueCases[] = {
+    // Range of unsigned types. Negative numbers do not wrap around.
+    {"0", "uint8", true},
+    {"255", "uint8", true},
+    {"256", "uint8", false},
+    {"-1", "uint8", false},
+    {"-0", "uint8", false},
+    {"65535", "uint16", true},
+    {"65536", "uint16", false},
+    {"-1", "uint16", false},
+    {"4294967295", "uint32", true},
+    {"4294967296", "uint32", false},
+    {"-1", "uint32", false},
+    {"18446744073709551615", "uint64", true},
+    {"18446744073709551616", "uint64", false},
+    {"-1", "uint64", false},
+
+    // Range of signed types.
+    {"-128", "int8", true},
+    {"127", "int8", true},
+    {"128", "int8", false},
+    {"-129", "int8", false},
+    {"-32768", "int16", true},
+    {"32768", "int16", false},
+    {"-2147483648", "int32", true},
+    {"2147483648", "int32", false},
+    {"-9223372036854775808", "int64", true},
+    {"9223372036854775808", "int64", false},
+
+    // Signs and whitespaces: leading whitespaces and one '+' are accepted.
+    {"+5", "uint8", true},
+    {"+5", "int8", true},
+    {" \t5", "int32", true},
+    {"  +7", "uint16", true},
+    {"+-5", "int32", false},
+    {"+-5", "uint32", false},
+    {"-+5", "int32", false},
+    {"++5", "int32", false},
+    {"+ 5", "int32", false},
+    {"5 ", "int32", false},
+    {"5x", "int32", false},
+    {"0x10", "int32", false},
+    {"", "int32", false},
+    {"+", "int32", false},
+    {"-", "int32", false},
+    {"1.5", "int32", false},
+
+    // Floating point types.
+    {"1.5", "float", true},
+    {"-2.25e3", "double", true},
+    {" +0.5", "double", true},
+    {"3.4e38", "float", true},
+    {"1e39", "float", false},
+    {"-1e39", "float", false},
+    {"1e-50", "float", false},
+    {"1e39", "double", true},
+    {"1e400", "double", false},
+    {"1e-400", "double", false},
+    {"inf", "double", false},
+    {"nan", "float", false},
+    {"1.0.0", "double", false},
+    {"", "double", false},
+
+    // Bool and string.
+    {"true", "bool", true},
+    {"FALSE", "bool", true},
+    {"True", "bool", true},
+    {"1", "bool", false},
+    {"yes", "bool", false},
+    {"anything", "string", true},
+    {"1", "unknown", false},
+};
+
+// ####################################################################################################
+// Tests:
+
+TEST(ParseValue, CheckValuetypeTable)
+{
+    for(const ValueCase &test : valueCases)
+    {
+        EXPECT_EQ(checkValuetype(test.input, test.type), test.valid) << '"' << test.input << "\" as " << test.type;
+    }
+}
+
+TEST(ParseValue, ReturnsParsedValues)
+{
+    uint8_t u8 = 0;
+    EXPECT_TRUE(parseValue(" +200", u8));
+    EXPECT_EQ(u8, 200);
+
+    int64_t i64 = 0;
+    EXPECT_TRUE(parseValue("-9223372036854775808", i64));
+    EXPECT_EQ(i64, INT64_MIN);
+
+    double d = 0;
+    EXPECT_TRUE(parseValue("-2.5e-3", d));
+    EXPECT_DOUBLE_EQ(d, -2.5e-3);
+
+    bool b = false;
+    EXPECT_TRUE(parseValue("TrUe", b));
+    EXPECT_TRUE(b);
+
+    std::string_view view;
+    EXPECT_TRUE(parseValue(" as is ", view));
+    EXPECT_EQ(view, " as is ");
+}
+
+TEST(ParseValue, FailedParseDoesNotChangeValue)
+{
+    uint8_t u8 = 42;
+    EXPECT_FALSE(parseValue("-1", u8));
+    EXPECT_FALSE(parseValue("300", u8));
+    EXPECT_EQ(u8, 42);
+
+    float f = 1.5f;
+    EXPECT_FALSE(parseValue("1e39", f));
+    EXPECT_EQ(f, 1.5f);
+
+    bool b = true;
+    EXPECT_FALSE(parseValue("no", b));
+    EXPECT_TRUE(b);
+}
+
+TEST(ParseValue, FormatCheckFunctions)
+{
+    EXPECT_FALSE(isUInt8("-1"));
+    EXPECT_TRUE(isUInt8("255"));
+    EXPECT_FALSE(isInt16("40000"));
+    EXPECT_TRUE(isUInt64("+18446744073709551615"));
+    EXPECT_FALSE(isFloat("1e39"));
+    EXPECT_TRUE(isDouble("1e39"));
+    EXPECT_TRUE(isBoolean("false"));
+    EXPECT_FALSE(isBoolean(""));
+}
@@ -0,0 +1,355 @@
+// ####################################################################################################
+// Tests of RecordCodec, RecordFramer, varint and CRC-32C: round trip, resynchronization and strict decode.
+// Build: cmake -S .. -B build && cmake --build build --target RecordCodecTest && ctest --test-dir build
+
+// ####################################################################################################
+// Include libraries:
+
+#include <gtest/gtest.h>            // Google Test
+#include <cstdint>                  // Fixed width integer limits
+#include <limits>                   // std::numeric_limits
+#include <string>                   // String class and related functions
+#include <vector>                   // Decoded values
+#include "RecordCodec.h"
+
+// ####################################################################################################
+// Test helpers:
+
+/// @brief Field types of all supported kinds.
+static const std::vector<std::string> allTypes = {
+    "uint8", "uint16", "uint32", "uint64", "int8", "int16", "int32", "int64", "float", "double", "bool", "string"
+};
+
+/// @brief Encode one frame with framer and return it.
+static std::string makeFrame(const RecordFramer &framer, const std::string &payload)
+{
+    std::string frame;
+    EXPECT_TRUE(framer.encodeFrame(payload.data(), payload.size(), frame));
+    return frame;
+}
+
+/// @brief Remove all TX buffer data of ring buffer stream and return it.
+static std::string takeTx(Stream &stream)
+{
+    RingRegions<const char> regions = stream.peekTx();
+    std::string data(regions.first.data(), regions.first.size());
+    data.append(regions.second.data(), regions.second.size());
+    stream.consumeTx(data.size());
+    return data;
+}
+
+/**
+ * @struct RecordTest
+ * @brief Fixture with a ring buffer stream and a framer on it.
+ */
+struct RecordTest : public ::testing::Test
+{
+    RingBuffer tx{256};
+    RingBuffer rx{256};
+    Stream stream{&tx, &rx};
+    RecordFramer framer{&stream, 64};
+};
+
+// ####################################################################################################
+// Tests:
+
+TEST(RecordCodec, Crc32cKnownValueAndContinuation)
+{
+    EXPECT_EQ(crc32c("123456789", 9), 0xE3069283u);
+    EXPECT_EQ(crc32c("", 0), 0u);
+
+    std::string data(1000, '\0');
+    for(size_t i = 0; i < data.size(); i++)
+    {
+        data[i] = (char)(i * 13);
+    }
+
+    // Calculation can be continued at any split point, also at unaligned ones.
+    uint32_t whole = crc32c(data.data(), data.size());
+    for(size_t split : {0, 1, 7, 8, 9, 500, 999})
+    {
+        EXPECT_EQ(crc32c(data.data() + split, data.size() - split, crc32c(data.data(), split)), whole) << split;
+    }
+}
+
+TEST(RecordCodec, VarintRoundTripAndInvalidInput)
+{
+    char bytes[VARINT_MAX_SIZE];
+    uint64_t value;
+
+    for(uint64_t input : {0ull, 1ull, 127ull, 128ull, 16383ull, 16384ull, 0xFFFFFFFFull, ~0ull})
+    {
+        size_t size = encodeVarint(input, bytes);
+        ASSERT_EQ(decodeVarint(bytes, size, value), size) << input;
+        EXPECT_EQ(value, input);
+
+        // Missing last byte.
+        EXPECT_EQ(decodeVarint(bytes, size - 1, value), 0u) << input;
+    }
+
+    EXPECT_EQ(encodeVarint(127, bytes), 1u);
+    EXPECT_EQ(encodeVarint(128, bytes), 2u);
+    EXPECT_EQ(encodeVarint(~0ull, bytes), (size_t)VARINT_MAX_SIZE);
+
+    // Continuation bit in all of max size bytes is not a valid varint.
+    std::string tooLong(VARINT_MAX_SIZE, '\x80');
+    EXPECT_EQ(decodeVarint(tooLong.data(), tooLong.size(), value), 0u);
+}
+
+TEST(RecordCodec, TypedRoundTripOfAllTypes)
+{
+    RecordCodec codec(allTypes);
+    ASSERT_EQ(codec.fieldCount(), allTypes.size());
+    EXPECT_EQ(codec.fieldType(11), ValueType::STRING);
+    EXPECT_EQ(codec.fieldType(12), ValueType::NONE);
+
+    std::string payload;
+    std::vector<RecordValue> values;
+    std::string text("with\0zero", 9);
+
+    ASSERT_TRUE(codec.encode(payload, std::numeric_limits<uint8_t>::max(), std::numeric_limits<uint16_t>::max(),
+                             std::numeric_limits<uint32_t>::max(), std::numeric_limits<uint64_t>::max(),
+                             std::numeric_limits<int8_t>::min(), std::numeric_limits<int16_t>::min(),
+                             std::numeric_limits<int32_t>::min(), std::numeric_limits<int64_t>::min(),
+                             -1.5f, 1e300, true, std::string_view(text)));
+    ASSERT_TRUE(codec.decode(payload.data(), payload.size(), values));
+    ASSERT_EQ(values.size(), allTypes.size());
+
+    EXPECT_EQ(std::get<uint8_t>(values[0]), 255);
+    EXPECT_EQ(std::get<uint16_t>(values[1]), 65535);
+    EXPECT_EQ(std::get<uint32_t>(values[2]), 0xFFFFFFFFu);
+    EXPECT_EQ(std::get<uint64_t>(values[3]), ~0ull);
+    EXPECT_EQ(std::get<int8_t>(values[4]), -128);
+    EXPECT_EQ(std::get<int16_t>(values[5]), -32768);
+    EXPECT_EQ(std::get<int32_t>(values[6]), std::numeric_limits<int32_t>::min());
+    EXPECT_EQ(std::get<int64_t>(values[7]), std::numeric_limits<int64_t>::min());
+    EXPECT_EQ(std::get<float>(values[8]), -1.5f);
+    EXPECT_EQ(std::get<double>(values[9]), 1e300);
+    EXPECT_TRUE(std::get<bool>(values[10]));
+    EXPECT_EQ(std::get<std::string_view>(values[11]), text);
+
+    // Small values are small. Zigzag makes -1 one byte.
+    RecordCodec small(std::vector<std::string>{"uint32", "int64"});
+    ASSERT_TRUE(small.encode(payload, (uint32_t)5, (int64_t)-1));
+    EXPECT_EQ(payload.size(), 2u);
+}
+
+TEST(RecordCodec, EncodeRejectsWrongValues)
+{
+    RecordCodec codec(std::vector<std::string>{"uint16", "string"});
+    std::string payload;
+
+    EXPECT_FALSE(codec.encode(payload, (uint16_t)1));
+    EXPECT_FALSE(codec.encode(payload, (uint32_t)1, std::string_view("x")));
+    EXPECT_FALSE(codec.encode(payload, (uint16_t)1, 2.0));
+    EXPECT_TRUE(payload.empty());
+
+    RecordCodec unknown(std::vector<std::string>{"uint16", "complex"});
+    EXPECT_FALSE(unknown.encode(payload, (uint16_t)1, std::string_view("x")));
+    EXPECT_FALSE(unknown.setFieldTypes(std::vector<std::string>{"nothing"}));
+}
+
+TEST(RecordCodec, TextRoundTrip)
+{
+    RecordCodec codec({"uint16", "int8", "double", "bool", "string"});
+    std::string payload;
+    std::vector<RecordValue> values;
+
+    ASSERT_TRUE(codec.encodeText({" 1200", "-7 ", "2.5", "true", "GPS"}, payload));
+    ASSERT_TRUE(codec.decode(payload.data(), payload.size(), values));
+    EXPECT_EQ(std::get<uint16_t>(values[0]), 1200);
+    EXPECT_EQ(std::get<int8_t>(values[1]), -7);
+    EXPECT_EQ(std::get<double>(values[2]), 2.5);
+    EXPECT_TRUE(std::get<bool>(values[3]));
+    EXPECT_EQ(std::get<std::string_view>(values[4]), "GPS");
+
+    // Out of range value and wrong field count.
+    EXPECT_FALSE(codec.encodeText({"70000", "1", "2.5", "true", "x"}, payload));
+    EXPECT_TRUE(payload.empty());
+    EXPECT_FALSE(codec.encodeText({"1", "1", "2.5", "true"}, payload));
+}
+
+TEST(RecordCodec, DecodeRejectsTrailingAndMissingBytes)
+{
+    RecordCodec codec({"uint16", "bool", "string"});
+    std::string payload;
+    std::vector<RecordValue> values;
+
+    ASSERT_TRUE(codec.encode(payload, (uint16_t)300, false, std::string_view("abc")));
+    ASSERT_TRUE(codec.decode(payload.data(), payload.size(), values));
+
+    std::string trailing = payload + "x";
+    EXPECT_FALSE(codec.decode(trailing.data(), trailing.size(), values));
+    EXPECT_TRUE(values.empty());
+
+    for(size_t size = 0; size < payload.size(); size++)
+    {
+        EXPECT_FALSE(codec.decode(payload.data(), size, values)) << size;
+    }
+
+    // Bool is 0 or 1 only. String length must fit in payload.
+    std::string badBool = payload;
+    badBool[2] = 2;
+    EXPECT_FALSE(codec.decode(badBool.data(), badBool.size(), values));
+
+    std::string badLength = payload;
+    badLength[3] = 4;
+    EXPECT_FALSE(codec.decode(badLength.data(), badLength.size(), values));
+
+    // uint16 field does not accept a larger varint value.
+    RecordCodec wide({"uint32", "bool", "string"});
+    ASSERT_TRUE(wide.encode(payload, (uint32_t)70000, false, std::string_view("abc")));
+    EXPECT_FALSE(codec.decode(payload.data(), payload.size(), values));
+}
+
+TEST_F(RecordTest, FrameRoundTripAndEmptyPayload)
+{
+    std::string payload;
+
+    for(const std::string &input : {std::string("hello"), std::string(), std::string(64, '\0')})
+    {
+        ASSERT_TRUE(framer.pushFrame(input.data(), input.size()));
+        std::string frame = takeTx(stream);
+        stream.pushBackRxBuffer(frame.data(), frame.size());
+
+        ASSERT_TRUE(framer.popFrame(payload));
+        EXPECT_EQ(payload, input);
+    }
+
+    // Empty frame has header in its CRC, so it is not all zero.
+    EXPECT_NE(makeFrame(framer, ""), std::string(5, '\0'));
+    EXPECT_FALSE(framer.pushFrame(std::string(65, 'x').data(), 65));
+    EXPECT_EQ(framer.getErrorCount(), 0u);
+}
+
+TEST_F(RecordTest, FrameArrivesByteByByte)
+{
+    std::string frame = makeFrame(framer, std::string(40, 'p'));
+    std::string payload;
+
+    // Header is complete after first byte. Rest of frame arrives later.
+    for(size_t i = 0; i + 1 < frame.size(); i++)
+    {
+        stream.pushBackRxBuffer(&frame[i], 1);
+        EXPECT_FALSE(framer.popFrame(payload)) << i;
+    }
+
+    stream.pushBackRxBuffer(&frame.back(), 1);
+    ASSERT_TRUE(framer.popFrame(payload));
+    EXPECT_EQ(payload, std::string(40, 'p'));
+    EXPECT_EQ(framer.getErrorCount(), 0u);
+}
+
+TEST_F(RecordTest, ResyncAfterGarbageAndBadCrc)
+{
+    std::string good = makeFrame(framer, "good");
+    std::string bad = makeFrame(framer, "bad!");
+    bad.back() ^= 0x01;
+
+    // Too long length header, garbage and a frame with wrong CRC before valid frames. A byte of dropped data can
+    // look like a length header, so enough data must follow to reject it by CRC.
+    std::string input = "\x7F" "xy" + bad;
+    for(int i = 0; i < 8; i++)
+    {
+        input += good;
+    }
+    stream.pushBackRxBuffer(input.data(), input.size());
+
+    std::string payload;
+    for(int i = 0; i < 8; i++)
+    {
+        ASSERT_TRUE(framer.popFrame(payload)) << i;
+        EXPECT_EQ(payload, "good");
+    }
+
+    EXPECT_GE(framer.getErrorCount(), 4u);
+    EXPECT_EQ(stream.getRxBufferLength(), 0u);
+}
+
+TEST_F(RecordTest, RemovedFrontInvalidatesDecodedHeader)
+{
+    std::string first = makeFrame(framer, std::string(30, 'a'));
+    std::string second = makeFrame(framer, "second");
+    std::string payload;
+
+    // Header of incomplete first frame is decoded and kept.
+    stream.pushBackRxBuffer(first.data(), 10);
+    EXPECT_FALSE(framer.popFrame(payload));
+
+    // Consumer drops incomplete frame. Its header must not be used for the next frame.
+    stream.removeAllRxBuffer();
+    stream.pushBackRxBuffer(second.data(), second.size());
+    ASSERT_TRUE(framer.popFrame(payload));
+    EXPECT_EQ(payload, "second");
+    EXPECT_EQ(framer.getErrorCount(), 0u);
+
+    // Same after reset().
+    stream.pushBackRxBuffer(first.data(), 10);
+    EXPECT_FALSE(framer.popFrame(payload));
+    framer.reset();
+    stream.removeAllRxBuffer();
+    stream.pushBackRxBuffer(second.data(), second.size());
+    ASSERT_TRUE(framer.popFrame(payload));
+    EXPECT_EQ(payload, "second");
+}
+
+TEST(RecordFramer, FrameSpanningWrapPointAndDeque)
+{
+    RingBuffer tx(32);
+    RingBuffer rx(32);
+    Stream stream(&tx, &rx);
+    RecordFramer framer(&stream, 32);
+    std::string payload;
+
+    stream.pushBackRxBuffer(std::string(25, '-').data(), 25);
+    stream.consumeRx(25);
+    framer.reset();
+
+    std::string frame = makeFrame(framer, "across-the-wrap");
+    stream.pushBackRxBuffer(frame.data(), frame.size());
+    ASSERT_FALSE(stream.peekRx().second.empty());
+    ASSERT_TRUE(framer.popFrame(payload));
+    EXPECT_EQ(payload, "across-the-wrap");
+
+    // Deque backend checks CRC from a copy.
+    std::deque<char> txDeque;
+    std::deque<char> rxDeque;
+    Stream dequeStream(&txDeque, 256, &rxDeque, 256);
+    RecordFramer dequeFramer(&dequeStream, 32);
+    std::string bad = frame;
+    bad[3] ^= 0x20;
+    std::string input = bad + frame + frame + frame;
+    dequeStream.pushBackRxBuffer(input.data(), input.size());
+    for(int i = 0; i < 3; i++)
+    {
+        ASSERT_TRUE(dequeFramer.popFrame(payload)) << i;
+        EXPECT_EQ(payload, "across-the-wrap");
+    }
+    EXPECT_GT(dequeFramer.getErrorCount(), 0u);
+}
+
+TEST_F(RecordTest, PushAndPopRecords)
+{
+    RecordCodec codec({"uint16", "float", "bool", "string"});
+    std::vector<RecordValue> values;
+
+    for(uint16_t i = 0; i < 20; i++)
+    {
+        ASSERT_TRUE(codec.pushRecord(framer, i, i * 0.5f, (i % 2) == 0, std::string_view("GPS")));
+        std::string frame = takeTx(stream);
+        stream.pushBackRxBuffer(frame.data(), frame.size());
+
+        ASSERT_TRUE(codec.popRecord(framer, values));
+        EXPECT_EQ(std::get<uint16_t>(values[0]), i);
+        EXPECT_EQ(std::get<float>(values[1]), i * 0.5f);
+        EXPECT_EQ(std::get<bool>(values[2]), (i % 2) == 0);
+        EXPECT_EQ(std::get<std::string_view>(values[3]), "GPS");
+    }
+
+    // Valid frame with a payload that is not a record of this codec is dropped.
+    std::string frame = makeFrame(framer, "not a record");
+    stream.pushBackRxBuffer(frame.data(), frame.size());
+    EXPECT_FALSE(codec.popRecord(framer, values));
+    EXPECT_EQ(codec.getErrorCount(), 1u);
+    EXPECT_EQ(stream.getRxBufferLength(), 0u);
+}
@@ -0,0 +1,199 @@
+// ####################################################################################################
+// Tests of RingBuffer and ring buffer backend of Stream.
+// Build: cmake -S .. -B build && cmake --build build --target RingBufferTest && ctest --test-dir build
+
+// ####################################################################################################
+// Include libraries:
+
+#include <gtest/gtest.h>            // Google Test
+#include <cstring>                  // std::memcpy
+#include <string>                   // String class and related functions
+#include "RingBuffer.h"
+#include "Stream.h"
+
+// ####################################################################################################
+// Tests:
+
+TEST(RingBuffer, RoundsCapacityUpToPowerOfTwo)
+{
+    EXPECT_EQ(RingBuffer(0).capacity(), 1u);
+    EXPECT_EQ(RingBuffer(1).capacity(), 1u);
+    EXPECT_EQ(RingBuffer(3).capacity(), 4u);
+    EXPECT_EQ(RingBuffer(64).capacity(), 64u);
+    EXPECT_EQ(RingBuffer(100).capacity(), 128u);
+    EXPECT_EQ(RingBuffer(4097).capacity(), 8192u);
+}
+
+TEST(RingBuffer, PushStopsAtCapacity)
+{
+    RingBuffer ring(8);
+
+    EXPECT_TRUE(ring.empty());
+    EXPECT_EQ(ring.push("0123456789", 10), 8u);
+    EXPECT_TRUE(ring.full());
+    EXPECT_EQ(ring.freeSpace(), 0u);
+    EXPECT_EQ(ring.push("x", 1), 0u);
+
+    char data[16] = {};
+    EXPECT_EQ(ring.pop(data, sizeof(data)), 8u);
+    EXPECT_EQ(std::string(data, 8), "01234567");
+    EXPECT_EQ(ring.pop(data, 1), 0u);
+}
+
+TEST(RingBuffer, PushPopAcrossWrapPoint)
+{
+    RingBuffer ring(8);
+    char data[8];
+
+    // Move indices near end of storage, so next push is split in two parts.
+    ASSERT_EQ(ring.push("abcdef", 6), 6u);
+    ASSERT_EQ(ring.pop(data, 5), 5u);
+    ASSERT_EQ(ring.push("ghijklm", 7), 7u);
+    EXPECT_EQ(ring.size(), 8u);
+
+    EXPECT_EQ(ring.at(0), 'f');
+    EXPECT_EQ(ring.at(2), 'h');
+    EXPECT_EQ(ring.at(7), 'm');
+
+    EXPECT_EQ(ring.pop(data, 8), 8u);
+    EXPECT_EQ(std::string(data, 8), "fghijklm");
+    EXPECT_TRUE(ring.empty());
+}
+
+TEST(RingBuffer, PeekWithOffsetAcrossWrapPoint)
+{
+    RingBuffer ring(8);
+    char data[8];
+
+    ring.push("012345", 6);
+    ring.discard(4);
+    ring.push("6789ab", 6);
+
+    EXPECT_EQ(ring.peek(data, 3, 1), 3u);
+    EXPECT_EQ(std::string(data, 3), "567");
+    EXPECT_EQ(ring.peek(data, 8, 3), 5u);
+    EXPECT_EQ(std::string(data, 5), "789ab");
+    EXPECT_EQ(ring.peek(data, 1, 8), 0u);
+
+    // Peek does not remove data.
+    EXPECT_EQ(ring.size(), 8u);
+}
+
+TEST(RingBuffer, DiscardAndClear)
+{
+    RingBuffer ring(16);
+
+    ring.push("abcdef", 6);
+    EXPECT_EQ(ring.discard(2), 2u);
+    EXPECT_EQ(ring.at(0), 'c');
+    EXPECT_EQ(ring.discard(10), 4u);
+    EXPECT_TRUE(ring.empty());
+
+    ring.push("xyz", 3);
+    ring.clear();
+    EXPECT_TRUE(ring.empty());
+    EXPECT_EQ(ring.freeSpace(), 16u);
+}
+
+TEST(RingBuffer, LongRunKeepsOrder)
+{
+    RingBuffer ring(64);
+    std::string pushed;
+    std::string popped;
+    char data[64];
+
+    // Pushes and pops of sizes that are not divisors of capacity cross the wrap point at all positions.
+    for(int i = 0; i < 1000; i++)
+    {
+        std::string chunk;
+        for(int j = 0; j < (i % 13) + 1; j++)
+        {
+            chunk.push_back((char)('a' + (i + j) % 26));
+        }
+
+        size_t pushedSize = ring.push(chunk.data(), chunk.size());
+        pushed.append(chunk, 0, pushedSize);
+
+        size_t poppedSize = ring.pop(data, (i % 11) + 1);
+        popped.append(data, poppedSize);
+    }
+
+    size_t poppedSize = ring.pop(data, sizeof(data));
+    popped.append(data, poppedSize);
+
+    EXPECT_EQ(popped, pushed);
+}
+
+TEST(RingBuffer, RegionsSplitAtWrapPoint)
+{
+    RingBuffer ring(8);
+
+    ring.push("abcdef", 6);
+    ring.discard(5);
+
+    // Free space is [6, 8) and [0, 5).
+    RingRegions<char> free = ring.writeRegions();
+    EXPECT_EQ(free.first.size(), 2u);
+    EXPECT_EQ(free.second.size(), 5u);
+
+    std::memcpy(free.first.data(), "gh", 2);
+    std::memcpy(free.second.data(), "ij", 2);
+    EXPECT_EQ(ring.commit(4), 4u);
+
+    RingRegions<const char> stored = ring.readRegions();
+    EXPECT_EQ(stored.size(), 5u);
+    EXPECT_EQ(std::string(stored.first.data(), stored.first.size()), "fgh");
+    EXPECT_EQ(std::string(stored.second.data(), stored.second.size()), "ij");
+
+    RingRegions<const char> limited = ring.readRegions(2);
+    EXPECT_EQ(limited.size(), 2u);
+    EXPECT_TRUE(limited.second.empty());
+}
+
+TEST(RingBuffer, CommitIsLimitedToFreeSpace)
+{
+    RingBuffer ring(4);
+
+    ring.push("ab", 2);
+    EXPECT_EQ(ring.writeRegions(1).size(), 1u);
+    EXPECT_EQ(ring.commit(10), 2u);
+    EXPECT_TRUE(ring.full());
+}
+
+TEST(RingBufferStream, PushAndPopAcrossWrapPoint)
+{
+    RingBuffer tx(8);
+    RingBuffer rx(8);
+    Stream stream(&tx, &rx);
+
+    stream.pushBackRxBuffer("abcdef", 6);
+    EXPECT_EQ(stream.popFrontRxBuffer(4), "abcd");
+
+    stream.pushBackRxBuffer("ghijkl", 6);
+    EXPECT_EQ(stream.popAllRxBuffer(), "efghijkl");
+}
+
+TEST(RingBufferStream, OverflowDropsOldest)
+{
+    RingBuffer tx(8);
+    RingBuffer rx(8);
+    Stream stream(&tx, &rx);
+
+    stream.pushBackRxBuffer("abcde", 5);
+    stream.pushBackRxBuffer("fghij", 5);
+    EXPECT_EQ(stream.popAllRxBuffer(), "cdefghij");
+
+    stream.pushBackRxBuffer("0123456789ab", 12);
+    EXPECT_EQ(stream.popAllRxBuffer(), "456789ab");
+}
+
+TEST(RingBufferStream, BufferSizeLimitsRing)
+{
+    RingBuffer tx(16);
+    RingBuffer rx(16);
+    Stream stream(&tx, &rx);
+
+    stream.setRxBufferSize(4);
+    stream.pushBackRxBuffer("abcdef", 6);
+    EXPECT_EQ(stream.popAllRxBuffer(), "cdef");
+}
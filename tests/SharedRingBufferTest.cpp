@@ -0,0 +1,198 @@
+// ####################################################################################################
+// Tests of SharedRingBuffer: reopen of a segment and blocking waits that are woken by another process.
+// Build: cmake -S .. -B build && cmake --build build --target SharedRingBufferTest && ctest --test-dir build
+
+// ####################################################################################################
+// Include libraries:
+
+#include <gtest/gtest.h>            // Google Test
+#include <cerrno>                   // errno
+#include <chrono>                   // Wait time
+#include <string>                   // String class and related functions
+#include <thread>                   // sleep_for
+#include <unistd.h>                 // fork, getpid, _exit
+#include <sys/wait.h>               // waitpid
+#include "SharedRingBuffer.h"
+#include "Stream.h"
+
+// ####################################################################################################
+// Test helpers:
+
+/**
+ * @struct SharedRingTest
+ * @brief Fixture with a shared memory name that is unlinked after test.
+ */
+struct SharedRingTest : public ::testing::Test
+{
+    std::string name;
+
+    void SetUp() override
+    {
+        name = "/shared_ring_test_" + std::to_string(getpid()) + "_" +
+               ::testing::UnitTest::GetInstance()->current_test_info()->name();
+        SharedRingBuffer::unlink(name);
+    }
+
+    void TearDown() override
+    {
+        SharedRingBuffer::unlink(name);
+    }
+
+    /// @brief Wait for child process and return its exit code. -1 if it did not exit normally.
+    static int join(pid_t child)
+    {
+        int status = 0;
+        if((waitpid(child, &status, 0) != child) || !WIFEXITED(status))
+        {
+            return -1;
+        }
+
+        return WEXITSTATUS(status);
+    }
+};
+
+// ####################################################################################################
+// Tests:
+
+TEST_F(SharedRingTest, ReopenKeepsDataUntilUnlink)
+{
+    {
+        SharedRingBuffer ring;
+        ASSERT_TRUE(ring.open(name, 100));
+        EXPECT_EQ(ring.capacity(), 128u);
+        ring.push("segment", 7);
+    }
+
+    // Segment lives after close. Capacity 0 takes capacity of segment.
+    SharedRingBuffer ring;
+    ASSERT_TRUE(ring.open(name));
+    EXPECT_EQ(ring.capacity(), 128u);
+    EXPECT_EQ(ring.size(), 7u);
+    ring.close();
+
+    errno = 0;
+    EXPECT_FALSE(ring.open(name, 4096));
+    EXPECT_EQ(errno, EINVAL);
+
+    // Closed ring does not wait or notify.
+    EXPECT_FALSE(ring.waitData(0));
+    ring.notifyData();
+
+    // New segment after unlink is empty.
+    ASSERT_TRUE(SharedRingBuffer::unlink(name));
+    EXPECT_FALSE(SharedRingBuffer::unlink(name));
+    errno = 0;
+    EXPECT_FALSE(ring.open(name));
+    EXPECT_EQ(errno, EINVAL);
+    ASSERT_TRUE(ring.open(name, 64));
+    EXPECT_TRUE(ring.empty());
+}
+
+TEST_F(SharedRingTest, WaitTimesOut)
+{
+    SharedRingBuffer ring;
+    ASSERT_TRUE(ring.open(name, 16));
+
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(ring.waitData(20));
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(20));
+
+    ring.push("0123456789abcdef", 16);
+    EXPECT_TRUE(ring.waitData(0));
+    EXPECT_FALSE(ring.waitSpace(1, 0));
+    EXPECT_FALSE(ring.waitSpace(17, -1));
+}
+
+TEST_F(SharedRingTest, ConsumerProcessIsWokenByProducer)
+{
+    SharedRingBuffer channel;
+    ASSERT_TRUE(channel.open(name, 64));
+
+    pid_t child = fork();
+    ASSERT_GE(child, 0);
+
+    if(child == 0)
+    {
+        // Producer process opens the same segment and pushes after the consumer waits.
+        SharedRingBuffer producerChannel;
+        if(!producerChannel.open(name))
+        {
+            _exit(1);
+        }
+
+        Stream stream(&producerChannel, nullptr);
+        stream.setSpscMode(true);
+
+        for(int n = 0; n < 20; n++)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            std::string message = "msg" + std::to_string(n) + ";";
+            if(!producerChannel.waitSpace(message.size(), 5000))
+            {
+                _exit(2);
+            }
+            stream.pushBackTxBuffer(message.data(), message.size());
+            producerChannel.notifyData();
+        }
+
+        _exit(0);
+    }
+
+    Stream stream(nullptr, &channel);
+    ASSERT_TRUE(stream.setSpscMode(true));
+
+    std::string expected;
+    for(int n = 0; n < 20; n++)
+    {
+        expected += "msg" + std::to_string(n) + ";";
+    }
+
+    std::string received;
+    while((received.size() < expected.size()) && channel.waitData(5000))
+    {
+        received += stream.popAllRxBuffer();
+        channel.notifySpace();
+    }
+
+    EXPECT_EQ(join(child), 0);
+    EXPECT_EQ(received, expected);
+}
+
+TEST_F(SharedRingTest, ProducerProcessIsWokenByConsumer)
+{
+    SharedRingBuffer channel;
+    ASSERT_TRUE(channel.open(name, 16));
+    channel.push("0123456789abcdef", 16);
+
+    pid_t child = fork();
+    ASSERT_GE(child, 0);
+
+    if(child == 0)
+    {
+        // Consumer process frees space after the producer waits.
+        SharedRingBuffer consumerChannel;
+        if(!consumerChannel.open(name))
+        {
+            _exit(1);
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+        char data[16];
+        if(consumerChannel.pop(data, 10) != 10)
+        {
+            _exit(2);
+        }
+        consumerChannel.notifySpace();
+        _exit(0);
+    }
+
+    // Ring is full. Wait blocks until the other process pops.
+    EXPECT_TRUE(channel.waitSpace(8, 5000));
+    EXPECT_EQ(channel.freeSpace(), 10u);
+    EXPECT_EQ(join(child), 0);
+
+    char data[16];
+    ASSERT_EQ(channel.pop(data, sizeof(data)), 6u);
+    EXPECT_EQ(std::string(data, 6), "abcdef");
+}
@@ -0,0 +1,240 @@
+// ####################################################################################################
+// Tests of AsyncStream coroutines: suspend until data arrives, resume inline or with executor, producer thread.
+// Build: cmake -S .. -B build && cmake --build build --target StreamAsyncTest && ctest --test-dir build
+
+// ####################################################################################################
+// Include libraries:
+
+#include <gtest/gtest.h>            // Google Test
+#include <chrono>                   // Timeouts
+#include <condition_variable>       // Executor queue of consumer thread
+#include <deque>                    // Executor queue of consumer thread
+#include <mutex>                    // Executor queue of consumer thread
+#include <string>                   // String class and related functions
+#include <thread>                   // Producer thread
+#include <vector>                   // Received lines
+#include "StreamAsync.h"
+
+// ####################################################################################################
+// Test helpers:
+
+/// @brief Coroutine that reads certain number of characters and then a line.
+static StreamTask readSession(AsyncStream &async, std::vector<std::string> &results)
+{
+    results.push_back(co_await async.readBytes(3));
+    results.push_back(co_await async.readUntil('\n'));
+}
+
+/// @brief Coroutine that waits for regions without copy and consumes them.
+static StreamTask regionsSession(AsyncStream &async, std::string &result)
+{
+    RingRegions<const char> regions = co_await async.waitBytes(6);
+    result.assign(regions.first.data(), regions.first.size());
+    result.append(regions.second.data(), regions.second.size());
+    async.stream().consumeRx(regions.size());
+}
+
+/// @brief Coroutine that waits for TX drain.
+static StreamTask drainSession(AsyncStream &async, bool &drained)
+{
+    co_await async.drainTx();
+    drained = true;
+}
+
+/// @brief Coroutine that reads lines until it has certain number of them.
+static StreamTask lineSession(AsyncStream &async, size_t count, std::vector<std::string> &lines, bool &done)
+{
+    while(lines.size() < count)
+    {
+        lines.push_back(co_await async.readUntil('\n'));
+    }
+
+    done = true;
+}
+
+// ####################################################################################################
+// Tests:
+
+TEST(StreamAsync, ReadSuspendsUntilDataArrives)
+{
+    RingBuffer tx(64);
+    RingBuffer rx(64);
+    Stream stream(&tx, &rx);
+    AsyncStream async(stream);
+    std::vector<std::string> results;
+
+    readSession(async, results);
+    EXPECT_TRUE(results.empty());
+
+    // Not enough for readBytes. Coroutine stays suspended.
+    stream.pushBackRxBuffer("ab", 2);
+    EXPECT_TRUE(results.empty());
+
+    // Rest of line does not resume readUntil before delimiter arrives.
+    stream.pushBackRxBuffer("cde", 3);
+    ASSERT_EQ(results.size(), 1u);
+    EXPECT_EQ(results[0], "abc");
+
+    stream.pushBackRxBuffer("fg", 2);
+    EXPECT_EQ(results.size(), 1u);
+    stream.pushBackRxBuffer("h\nrest", 6);
+    ASSERT_EQ(results.size(), 2u);
+    EXPECT_EQ(results[1], "defgh");
+    EXPECT_EQ(stream.popAllRxBuffer(), "rest");
+}
+
+TEST(StreamAsync, ReadyDataDoesNotSuspend)
+{
+    std::deque<char> tx;
+    std::deque<char> rx;
+    Stream stream(&tx, 64, &rx, 64);
+    AsyncStream async(stream);
+    std::vector<std::string> results;
+
+    stream.pushBackRxBuffer("xyzline\n", 8);
+    readSession(async, results);
+    ASSERT_EQ(results.size(), 2u);
+    EXPECT_EQ(results[0], "xyz");
+    EXPECT_EQ(results[1], "line");
+}
+
+TEST(StreamAsync, WaitBytesReturnsRegionsAcrossWrapPoint)
+{
+    RingBuffer tx(8);
+    RingBuffer rx(8);
+    Stream stream(&tx, &rx);
+    AsyncStream async(stream);
+    std::string result;
+
+    stream.pushBackRxBuffer("012345", 6);
+    stream.consumeRx(6);
+
+    regionsSession(async, result);
+    stream.pushBackRxBuffer("abcd", 4);
+    EXPECT_TRUE(result.empty());
+    stream.pushBackRxBuffer("ef", 2);
+    EXPECT_EQ(result, "abcdef");
+    EXPECT_EQ(stream.getRxBufferLength(), 0u);
+}
+
+TEST(StreamAsync, DrainResumesWhenTxIsEmpty)
+{
+    RingBuffer tx(16);
+    RingBuffer rx(16);
+    Stream stream(&tx, &rx);
+    AsyncStream async(stream);
+    bool drained = false;
+
+    stream.pushBackTxBuffer("abcd", 4);
+    drainSession(async, drained);
+    EXPECT_FALSE(drained);
+
+    stream.consumeTx(3);
+    EXPECT_FALSE(drained);
+    stream.consumeTx(1);
+    EXPECT_TRUE(drained);
+}
+
+TEST(StreamAsync, ExecutorResumesLater)
+{
+    RingBuffer tx(16);
+    RingBuffer rx(16);
+    Stream stream(&tx, &rx);
+    std::vector<std::coroutine_handle<>> handles;
+    AsyncStream async(stream, [&handles](std::coroutine_handle<> handle) { handles.push_back(handle); });
+    std::vector<std::string> results;
+
+    readSession(async, results);
+    stream.pushBackRxBuffer("abc", 3);
+
+    // Coroutine is posted to executor instead of resumed in the pushing code.
+    ASSERT_EQ(handles.size(), 1u);
+    EXPECT_TRUE(results.empty());
+
+    handles[0].resume();
+    ASSERT_EQ(results.size(), 1u);
+    EXPECT_EQ(results[0], "abc");
+
+    stream.pushBackRxBuffer("x\n", 2);
+    ASSERT_EQ(handles.size(), 2u);
+    handles[1].resume();
+    EXPECT_EQ(results[1], "x");
+}
+
+TEST(StreamAsync, ProducerThreadResumesConsumerCoroutine)
+{
+    RingBuffer tx(16);
+    RingBuffer rx(64);
+    Stream stream(&tx, &rx);
+    ASSERT_TRUE(stream.setSpscMode(true));
+
+    // Executor posts handles from producer thread to this consumer thread.
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::deque<std::coroutine_handle<>> queue;
+    size_t posted = 0;
+
+    AsyncStream async(stream, [&](std::coroutine_handle<> handle)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        queue.push_back(handle);
+        posted++;
+        condition.notify_one();
+    });
+
+    const size_t lineCount = 2000;
+    std::vector<std::string> lines;
+    bool done = false;
+
+    // Coroutine starts before producer, so it suspends at least once.
+    lineSession(async, lineCount, lines, done);
+    ASSERT_FALSE(done);
+
+    std::thread producer([&stream]()
+    {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        uint64_t pushed = 0;
+
+        for(size_t n = 0; n < lineCount; n++)
+        {
+            std::string line = "line " + std::to_string(n) + "\n";
+
+            // Read count is written by consumer thread. Stay a few lines ahead, so consumer suspends often.
+            while(((pushed - stream.getRxReadCount() > 24) || !stream.tryPushBackRxBuffer(line.data(), line.size())) &&
+                  (std::chrono::steady_clock::now() < deadline))
+            {
+                std::this_thread::yield();
+            }
+
+            pushed += line.size();
+        }
+    });
+
+    while(!done)
+    {
+        std::coroutine_handle<> handle;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            if(!condition.wait_for(lock, std::chrono::seconds(10), [&queue]() { return !queue.empty(); }))
+            {
+                break;
+            }
+            handle = queue.front();
+            queue.pop_front();
+        }
+        handle.resume();
+    }
+
+    producer.join();
+
+    ASSERT_TRUE(done);
+    EXPECT_GE(posted, 1u);
+
+    uint64_t readCount = 0;
+    for(size_t n = 0; n < lineCount; n++)
+    {
+        ASSERT_EQ(lines[n], "line " + std::to_string(n)) << n;
+        readCount += lines[n].size() + 1;
+    }
+    EXPECT_EQ(stream.getRxReadCount(), readCount);
+}
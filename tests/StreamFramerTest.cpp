@@ -0,0 +1,289 @@
+// ####################################################################################################
+// Tests of StreamFramer implementations: round trip, fragments, resynchronization and ring wrap point.
+// Build: cmake -S .. -B build && cmake --build build --target StreamFramerTest && ctest --test-dir build
+
+// ####################################################################################################
+// Include libraries:
+
+#include <gtest/gtest.h>            // Google Test
+#include <string>                   // String class and related functions
+#include <vector>                   // Test payloads
+#include "StreamFramer.h"
+
+// ####################################################################################################
+// Test helpers:
+
+/// @brief Payloads with special characters of all framers and sizes around COBS block size.
+static std::vector<std::string> testPayloads(void)
+{
+    std::vector<std::string> payloads = {
+        "hello",
+        std::string("\0", 1),
+        std::string("a\0b\0\0c", 6),
+        "\xC0\xDB\xDC\xDD",
+        "\xDB\xC0",
+        "x",
+    };
+
+    for(size_t size : {253, 254, 255, 300})
+    {
+        std::string payload(size, '\0');
+        for(size_t i = 0; i < size; i++)
+        {
+            payload[i] = (char)(1 + i % 250);
+        }
+        payloads.push_back(payload);
+
+        payload[size / 2] = '\0';
+        payloads.push_back(payload);
+    }
+
+    return payloads;
+}
+
+/// @brief Join payload regions to a string.
+static std::string joinRegions(const RingRegions<const char> &regions)
+{
+    std::string data(regions.first.data(), regions.first.size());
+    data.append(regions.second.data(), regions.second.size());
+    return data;
+}
+
+/// @brief Encode payloads with framer and pop them back through RX buffer of its stream.
+static void expectRoundTrip(StreamFramer &framer, Stream &stream, const std::vector<std::string> &payloads)
+{
+    std::string frame;
+    std::string payload;
+
+    for(const std::string &input : payloads)
+    {
+        ASSERT_TRUE(framer.encodeFrame(input.data(), input.size(), frame)) << input.size();
+        stream.pushBackRxBuffer(frame.data(), frame.size());
+
+        ASSERT_TRUE(framer.popFrame(payload)) << input.size();
+        EXPECT_EQ(payload, input);
+        EXPECT_EQ(stream.getRxBufferLength(), 0u);
+    }
+
+    EXPECT_EQ(framer.getErrorCount(), 0u);
+}
+
+/**
+ * @struct FramerTest
+ * @brief Fixture with a ring buffer stream.
+ */
+struct FramerTest : public ::testing::Test
+{
+    RingBuffer tx{1024};
+    RingBuffer rx{1024};
+    Stream stream{&tx, &rx};
+};
+
+// ####################################################################################################
+// Tests:
+
+TEST_F(FramerTest, DelimiterRoundTrip)
+{
+    DelimiterFramer framer(&stream, '\n', 512);
+    expectRoundTrip(framer, stream, {"hello", "", "a b c", std::string(512, 'x')});
+}
+
+TEST_F(FramerTest, LengthPrefixRoundTrip)
+{
+    for(uint8_t headerSize : {1, 2, 4})
+    {
+        for(bool bigEndian : {true, false})
+        {
+            LengthPrefixFramer framer(&stream, headerSize, bigEndian, 512);
+            std::vector<std::string> payloads = testPayloads();
+
+            if(headerSize == 1)
+            {
+                payloads.resize(6);
+            }
+
+            expectRoundTrip(framer, stream, payloads);
+        }
+    }
+}
+
+TEST_F(FramerTest, SlipRoundTrip)
+{
+    SlipFramer framer(&stream, 1024);
+    expectRoundTrip(framer, stream, testPayloads());
+}
+
+TEST_F(FramerTest, CobsRoundTrip)
+{
+    CobsFramer framer(&stream, 1024);
+    expectRoundTrip(framer, stream, testPayloads());
+}
+
+TEST_F(FramerTest, FragmentedFrameIsReturnedOnceComplete)
+{
+    CobsFramer framer(&stream);
+    std::string frame;
+    std::string payload;
+
+    std::string input("frag\0mented", 11);
+    ASSERT_TRUE(framer.encodeFrame(input.data(), input.size(), frame));
+
+    for(size_t i = 0; i + 1 < frame.size(); i++)
+    {
+        stream.pushBackRxBuffer(&frame[i], 1);
+        EXPECT_FALSE(framer.popFrame(payload));
+    }
+
+    stream.pushBackRxBuffer(&frame.back(), 1);
+    ASSERT_TRUE(framer.popFrame(payload));
+    EXPECT_EQ(payload, input);
+}
+
+TEST_F(FramerTest, FrameSpanningWrapPoint)
+{
+    RingBuffer smallTx(32);
+    RingBuffer smallRx(32);
+    Stream small(&smallTx, &smallRx);
+    LengthPrefixFramer framer(&small, 2, true, 32);
+
+    // Move ring indices near end of storage.
+    small.pushBackRxBuffer("0123456789012345678901234", 25);
+    small.consumeRx(25);
+    framer.reset();
+
+    std::string frame;
+    ASSERT_TRUE(framer.encodeFrame("wrapped-payload", 15, frame));
+    small.pushBackRxBuffer(frame.data(), frame.size());
+
+    RingRegions<const char> regions;
+    ASSERT_TRUE(framer.nextFrame(regions));
+    EXPECT_FALSE(regions.second.empty());
+    EXPECT_EQ(joinRegions(regions), "wrapped-payload");
+    framer.consumeFrame();
+    EXPECT_EQ(small.getRxBufferLength(), 0u);
+
+    // Encoded frame that wraps is decoded too.
+    SlipFramer slip(&small, 32);
+    ASSERT_TRUE(slip.encodeFrame("\xC0slip\xDB", 6, frame));
+    small.pushBackRxBuffer(frame.data(), frame.size());
+    small.pushBackRxBuffer(frame.data(), frame.size());
+
+    std::string payload;
+    for(int i = 0; i < 2; i++)
+    {
+        ASSERT_TRUE(slip.popFrame(payload));
+        EXPECT_EQ(payload, "\xC0slip\xDB");
+    }
+}
+
+TEST_F(FramerTest, DelimiterDropsTooLongFrames)
+{
+    DelimiterFramer framer(&stream, '\n', 4);
+    std::string payload;
+
+    stream.pushBackRxBuffer("toolong\nok\n", 11);
+    ASSERT_TRUE(framer.popFrame(payload));
+    EXPECT_EQ(payload, "ok");
+    EXPECT_EQ(framer.getErrorCount(), 1u);
+
+    // No delimiter within max frame size. The rest of that frame is dropped when it arrives.
+    stream.pushBackRxBuffer("abcdefgh", 8);
+    EXPECT_FALSE(framer.popFrame(payload));
+    stream.pushBackRxBuffer("ij\nnext\n", 8);
+    ASSERT_TRUE(framer.popFrame(payload));
+    EXPECT_EQ(payload, "next");
+    EXPECT_EQ(framer.getErrorCount(), 2u);
+}
+
+TEST_F(FramerTest, LengthPrefixResyncsAfterBadHeader)
+{
+    LengthPrefixFramer framer(&stream, 2, true, 16);
+    std::string payload;
+
+    stream.pushBackRxBuffer("\xFF\xFF\x00\x03" "abc", 7);
+    ASSERT_TRUE(framer.popFrame(payload));
+    EXPECT_EQ(payload, "abc");
+    EXPECT_EQ(framer.getErrorCount(), 2u);
+}
+
+TEST_F(FramerTest, SlipAndCobsDropCorruptedFrames)
+{
+    std::string payload;
+
+    SlipFramer slip(&stream);
+    stream.pushBackRxBuffer("\xC0" "ab\xDBx" "\xC0" "\xC0" "ok\xC0", 10);
+    ASSERT_TRUE(slip.popFrame(payload));
+    EXPECT_EQ(payload, "ok");
+    EXPECT_EQ(slip.getErrorCount(), 1u);
+
+    // COBS code 5 needs 4 more bytes before the delimiter.
+    CobsFramer cobs(&stream);
+    stream.pushBackRxBuffer("\x05" "ab" "\0" "\x03" "ok" "\0", 8);
+    ASSERT_TRUE(cobs.popFrame(payload));
+    EXPECT_EQ(payload, "ok");
+    EXPECT_EQ(cobs.getErrorCount(), 1u);
+}
+
+TEST_F(FramerTest, ResetClearsDiscardState)
+{
+    DelimiterFramer framer(&stream, '\n', 4);
+    std::string payload;
+
+    stream.pushBackRxBuffer("toolongframe", 12);
+    EXPECT_FALSE(framer.popFrame(payload));
+
+    // After reset the next frame is not taken as the tail of the dropped frame.
+    framer.reset();
+    stream.pushBackRxBuffer("ab\n", 3);
+    ASSERT_TRUE(framer.popFrame(payload));
+    EXPECT_EQ(payload, "ab");
+}
+
+TEST_F(FramerTest, ConsumeAfterExternalRemoveKeepsNextFrames)
+{
+    DelimiterFramer framer(&stream);
+    RingRegions<const char> regions;
+    std::string payload;
+
+    stream.pushBackRxBuffer("cd\nef\n", 6);
+    ASSERT_TRUE(framer.nextFrame(regions));
+
+    // Found frame is not valid anymore. consumeFrame() must not remove the next frame.
+    stream.removeFrontRxBuffer(1);
+    framer.consumeFrame();
+    EXPECT_EQ(stream.getRxBufferLength(), 5u);
+
+    ASSERT_TRUE(framer.popFrame(payload));
+    EXPECT_EQ(payload, "d");
+    ASSERT_TRUE(framer.popFrame(payload));
+    EXPECT_EQ(payload, "ef");
+}
+
+TEST_F(FramerTest, ScanPositionSurvivesEviction)
+{
+    RingBuffer smallTx(16);
+    RingBuffer smallRx(16);
+    Stream small(&smallTx, &smallRx);
+    DelimiterFramer framer(&small, '\n', 16);
+    std::string payload;
+
+    small.pushBackRxBuffer("0123456789", 10);
+    EXPECT_FALSE(framer.popFrame(payload));
+
+    // Drop oldest overflow removes 4 scanned characters.
+    small.pushBackRxBuffer("abcdefghi\n", 10);
+    ASSERT_TRUE(framer.popFrame(payload));
+    EXPECT_EQ(payload, "456789abcdefghi");
+}
+
+TEST_F(FramerTest, PushFrameNeedsWholeFrameSpace)
+{
+    RingBuffer smallTx(8);
+    RingBuffer smallRx(8);
+    Stream small(&smallTx, &smallRx);
+    DelimiterFramer framer(&small, '\n', 16);
+
+    EXPECT_TRUE(framer.pushFrame("abcd", 4));
+    EXPECT_FALSE(framer.pushFrame("efgh", 4));
+    EXPECT_EQ(small.getTxBufferLength(), 5u);
+}
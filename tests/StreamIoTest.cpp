@@ -0,0 +1,249 @@
+// ####################################################################################################
+// Tests of Stream::flushTx and Stream::fillRx with pipes, socketpairs and ptys.
+// Build: cmake -S .. -B build && cmake --build build --target StreamIoTest && ctest --test-dir build
+
+// ####################################################################################################
+// Include libraries:
+
+#include <gtest/gtest.h>            // Google Test
+#include <fcntl.h>                  // fcntl, O_NONBLOCK, posix_openpt
+#include <sys/socket.h>             // socketpair, SO_SNDBUF
+#include <string>                   // String class and related functions
+#include "Stream.h"
+
+// ####################################################################################################
+// Test helpers:
+
+/// @brief Set descriptor to non-blocking mode.
+static void setNonBlocking(int fd)
+{
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+}
+
+/// @brief Read everything that is available from non-blocking descriptor.
+static std::string readAvailable(int fd)
+{
+    std::string data;
+    char chunk[4096];
+    ssize_t size;
+
+    while((size = read(fd, chunk, sizeof(chunk))) > 0)
+    {
+        data.append(chunk, size);
+    }
+
+    return data;
+}
+
+/// @brief Make test data of certain size.
+static std::string makeData(size_t size)
+{
+    std::string data(size, '\0');
+
+    for(size_t i = 0; i < size; i++)
+    {
+        data[i] = (char)('a' + (i * 7) % 26);
+    }
+
+    return data;
+}
+
+/**
+ * @struct PipeTest
+ * @brief Fixture with a non-blocking pipe.
+ */
+struct PipeTest : public ::testing::Test
+{
+    int fds[2] = {-1, -1};
+
+    void SetUp() override
+    {
+        ASSERT_EQ(pipe(fds), 0);
+        setNonBlocking(fds[0]);
+        setNonBlocking(fds[1]);
+    }
+
+    void TearDown() override
+    {
+        for(int fd : fds)
+        {
+            if(fd >= 0)
+            {
+                close(fd);
+            }
+        }
+    }
+};
+
+// ####################################################################################################
+// Tests:
+
+TEST_F(PipeTest, FlushGathersAcrossWrapPoint)
+{
+    RingBuffer tx(16);
+    RingBuffer rx(16);
+    Stream stream(&tx, &rx);
+
+    stream.pushBackTxBuffer("0123456789ab", 12);
+    stream.consumeTx(10);
+    stream.pushBackTxBuffer("cdefghijkl", 10);
+    ASSERT_FALSE(stream.peekTx().second.empty());
+
+    EXPECT_EQ(stream.flushTx(fds[1]), 12);
+    EXPECT_TRUE(tx.empty());
+    EXPECT_EQ(readAvailable(fds[0]), "abcdefghijkl");
+}
+
+TEST_F(PipeTest, FlushDequeInChunks)
+{
+    std::deque<char> tx;
+    std::deque<char> rx;
+    Stream stream(&tx, 1 << 16, &rx, 1 << 16);
+
+    std::string data = makeData(10000);
+    stream.pushBackTxBuffer(data);
+
+    EXPECT_EQ(stream.flushTx(fds[1]), 10000);
+    EXPECT_TRUE(tx.empty());
+    EXPECT_EQ(readAvailable(fds[0]), data);
+}
+
+TEST_F(PipeTest, FlushFailsOnBadDescriptor)
+{
+    RingBuffer tx(16);
+    RingBuffer rx(16);
+    Stream stream(&tx, &rx);
+
+    stream.pushBackTxBuffer("abc", 3);
+    errno = 0;
+    EXPECT_EQ(stream.flushTx(-1), -1);
+    EXPECT_EQ(errno, EBADF);
+    EXPECT_EQ(tx.size(), 3u);
+}
+
+TEST(StreamIo, PartialWriteStopsAtWouldBlockAndResumes)
+{
+    int pair[2];
+    ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, pair), 0);
+    setNonBlocking(pair[0]);
+    setNonBlocking(pair[1]);
+
+    int bufferSize = 4096;
+    setsockopt(pair[0], SOL_SOCKET, SO_SNDBUF, &bufferSize, sizeof(bufferSize));
+
+    RingBuffer tx(1 << 20);
+    RingBuffer rx(16);
+    Stream stream(&tx, &rx);
+
+    std::string data = makeData(1 << 20);
+    stream.pushBackTxBuffer(data);
+
+    // Socket takes only part of the data. The rest stays in TX buffer.
+    ssize_t written = stream.flushTx(pair[0]);
+    ASSERT_GT(written, 0);
+    ASSERT_LT((size_t)written, data.size());
+    EXPECT_EQ(tx.size(), data.size() - written);
+
+    // Nothing can be written while peer does not read.
+    EXPECT_EQ(stream.flushTx(pair[0]), 0);
+
+    std::string received;
+    for(int i = 0; (i < 100000) && (received.size() < data.size()); i++)
+    {
+        received += readAvailable(pair[1]);
+        stream.flushTx(pair[0]);
+    }
+
+    EXPECT_EQ(received, data);
+    EXPECT_TRUE(tx.empty());
+
+    close(pair[0]);
+    close(pair[1]);
+}
+
+TEST_F(PipeTest, FillScattersAcrossWrapPoint)
+{
+    RingBuffer tx(16);
+    RingBuffer rx(16);
+    Stream stream(&tx, &rx);
+
+    stream.pushBackRxBuffer("0123456789ab", 12);
+    stream.consumeRx(10);
+
+    ASSERT_EQ(write(fds[1], "cdefghijklmnopqrstu", 19), 19);
+
+    // Free space is [12, 16) and [0, 10). One readv fills both regions.
+    EXPECT_EQ(stream.fillRx(fds[0]), 14);
+    EXPECT_EQ(stream.popAllRxBuffer(), "abcdefghijklmnop");
+    EXPECT_EQ(readAvailable(fds[0]), "qrstu");
+}
+
+TEST_F(PipeTest, FillReportsFullBufferWithEnobufs)
+{
+    RingBuffer tx(8);
+    RingBuffer rx(8);
+    Stream stream(&tx, &rx);
+
+    ASSERT_EQ(write(fds[1], "0123456789", 10), 10);
+    EXPECT_EQ(stream.fillRx(fds[0]), 8);
+
+    errno = 0;
+    EXPECT_EQ(stream.fillRx(fds[0]), -1);
+    EXPECT_EQ(errno, ENOBUFS);
+
+    // Old data is never removed to make space.
+    EXPECT_EQ(stream.popAllRxBuffer(), "01234567");
+
+    std::deque<char> txDeque;
+    std::deque<char> rxDeque;
+    Stream dequeStream(&txDeque, 4, &rxDeque, 2);
+    EXPECT_EQ(dequeStream.fillRx(fds[0]), 2);
+    errno = 0;
+    EXPECT_EQ(dequeStream.fillRx(fds[0]), -1);
+    EXPECT_EQ(errno, ENOBUFS);
+    EXPECT_EQ(dequeStream.popAllRxBuffer(), "89");
+}
+
+TEST_F(PipeTest, FillReportsWouldBlockAndEndOfFile)
+{
+    RingBuffer tx(8);
+    RingBuffer rx(8);
+    Stream stream(&tx, &rx);
+
+    errno = 0;
+    EXPECT_EQ(stream.fillRx(fds[0]), -1);
+    EXPECT_EQ(errno, EAGAIN);
+
+    close(fds[1]);
+    fds[1] = -1;
+    EXPECT_EQ(stream.fillRx(fds[0]), 0);
+}
+
+TEST(StreamIo, FillFromPty)
+{
+    int master = posix_openpt(O_RDWR | O_NOCTTY);
+    ASSERT_GE(master, 0);
+    ASSERT_EQ(grantpt(master), 0);
+    ASSERT_EQ(unlockpt(master), 0);
+
+    int slave = open(ptsname(master), O_RDWR | O_NOCTTY);
+    ASSERT_GE(slave, 0);
+
+    RingBuffer tx(64);
+    RingBuffer rx(64);
+    Stream stream(&tx, &rx);
+
+    // Master side reads what is written to slave side like a serial port.
+    ASSERT_EQ(write(slave, "AT", 2), 2);
+    ssize_t received = 0;
+    for(int i = 0; (i < 100) && (received < 2); i++)
+    {
+        ssize_t size = stream.fillRx(master);
+        ASSERT_GT(size, 0);
+        received += size;
+    }
+    EXPECT_EQ(stream.popAllRxBuffer(), "AT");
+
+    close(slave);
+    close(master);
+}
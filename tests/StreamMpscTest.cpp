@@ -0,0 +1,348 @@
+// ####################################################################################################
+// Tests of multi producer/single consumer mode of RingBuffer and Stream TX, and batch push with a consumer thread.
+// Build: cmake -S .. -B build && cmake --build build --target StreamMpscTest && ctest --test-dir build
+
+// ####################################################################################################
+// Include libraries:
+
+#include <gtest/gtest.h>            // Google Test
+#include <atomic>                   // Producer counter
+#include <string>                   // String class and related functions
+#include <string_view>              // Batch records
+#include <thread>                   // Producer threads
+#include <vector>                   // Threads and records
+#include "RingBuffer.h"
+#include "Stream.h"
+
+// ####################################################################################################
+// Test data:
+
+/// @brief Number of producer threads of stress tests.
+static const size_t producerCount = 4;
+
+/// @brief Number of records of each producer.
+static const size_t recordCount = 20000;
+
+/**
+ * @brief Make a record: length byte, producer byte, 4 byte sequence number and a payload.
+ * Records differ in size and content, so an interleaved or cut record is detected.
+ */
+static std::string makeRecord(size_t producer, size_t sequence)
+{
+    size_t payloadSize = (producer * 7 + sequence) % 24;
+    std::string record(6 + payloadSize, '\0');
+
+    record[0] = (char)record.size();
+    record[1] = (char)producer;
+    for(size_t i = 0; i < 4; i++)
+    {
+        record[2 + i] = (char)(sequence >> (8 * i));
+    }
+    for(size_t i = 0; i < payloadSize; i++)
+    {
+        record[6 + i] = (char)(producer * 31 + sequence * 13 + i);
+    }
+
+    return record;
+}
+
+/**
+ * @struct RecordChecker
+ * @brief Consumer side check of records: each record is intact and records of each producer are in order.
+ */
+struct RecordChecker
+{
+    std::vector<size_t> next = std::vector<size_t>(producerCount, 0);
+    size_t errors = 0;
+    size_t records = 0;
+
+    /// @brief Check a whole record that starts with its length byte.
+    void check(const char* record)
+    {
+        size_t producer = (unsigned char)record[1];
+        if(producer >= producerCount)
+        {
+            errors++;
+            return;
+        }
+
+        std::string expected = makeRecord(producer, next[producer]++);
+        errors += (expected != std::string(record, (unsigned char)record[0]));
+        records++;
+    }
+};
+
+// ####################################################################################################
+// Tests:
+
+TEST(Mpsc, SharedPushRecordsAreIntactAndNotInterleaved)
+{
+    RingBuffer ring(256);
+    std::vector<std::thread> producers;
+
+    for(size_t p = 0; p < producerCount; p++)
+    {
+        producers.emplace_back([&ring, p]()
+        {
+            for(size_t n = 0; n < recordCount; n++)
+            {
+                std::string record = makeRecord(p, n);
+                std::string_view view(record);
+
+                // Odd producers use the record array overload.
+                while(!((p % 2) ? ring.tryPushShared(&view, 1) : ring.tryPushShared(record.data(), record.size())))
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    RecordChecker checker;
+    size_t sizeErrors = 0;
+    char record[64];
+
+    while(checker.records < producerCount * recordCount)
+    {
+        // Size is never more than capacity while producers reserve and publish.
+        sizeErrors += (ring.size() > ring.capacity());
+
+        if(!ring.tryPop(record, 1))
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        // A record is published whole, so its rest is already there.
+        size_t length = (unsigned char)record[0];
+        if((length < 6) || !ring.tryPop(record + 1, length - 1))
+        {
+            checker.errors++;
+            break;
+        }
+
+        checker.check(record);
+    }
+
+    for(std::thread &producer : producers)
+    {
+        producer.join();
+    }
+
+    EXPECT_EQ(checker.errors, 0u);
+    EXPECT_EQ(sizeErrors, 0u);
+    EXPECT_TRUE(ring.empty());
+}
+
+TEST(Mpsc, SharedPushRejectsRecordThatDoesNotFit)
+{
+    RingBuffer ring(8);
+
+    EXPECT_TRUE(ring.tryPushShared("abcde", 5));
+    EXPECT_FALSE(ring.tryPushShared("fghi", 4));
+
+    std::string_view records[] = {"fg", "hi"};
+    EXPECT_FALSE(ring.tryPushShared(records, 2));
+    EXPECT_TRUE(ring.tryPushShared(records, 1));
+    EXPECT_EQ(ring.size(), 7u);
+
+    char data[8];
+    EXPECT_TRUE(ring.tryPop(data, 7));
+    EXPECT_EQ(std::string(data, 7), "abcdefg");
+}
+
+TEST(Mpsc, StreamModeNeedsTxRing)
+{
+    std::deque<char> tx;
+    std::deque<char> rx;
+    Stream dequeStream(&tx, 16, &rx, 16);
+    EXPECT_FALSE(dequeStream.setMpscMode(true));
+
+    RingBuffer txRing(16);
+    RingBuffer rxRing(16);
+    Stream ringStream(&txRing, &rxRing);
+    EXPECT_TRUE(ringStream.setMpscMode(true));
+    EXPECT_TRUE(ringStream.getMpscMode());
+
+    // prepareTx() has no direct memory in MPSC mode. Records are stored whole or dropped whole.
+    EXPECT_TRUE(ringStream.prepareTx(4).empty());
+    EXPECT_EQ(ringStream.pushBackTxBuffer("0123456789", 10), 10u);
+    EXPECT_EQ(ringStream.pushBackTxBuffer("abcdefgh", 8), 0u);
+    EXPECT_EQ(ringStream.getTxBufferLength(), 10u);
+}
+
+TEST(Mpsc, StreamProducersWithBatches)
+{
+    RingBuffer tx(512);
+    RingBuffer rx(16);
+    Stream stream(&tx, &rx);
+    ASSERT_TRUE(stream.setMpscMode(true));
+
+    std::vector<std::thread> producers;
+    for(size_t p = 0; p < producerCount; p++)
+    {
+        producers.emplace_back([&stream, p]()
+        {
+            for(size_t n = 0; n < recordCount; n += 2)
+            {
+                std::string first = makeRecord(p, n);
+                std::string second = makeRecord(p, n + 1);
+                std::string_view batch[] = {first, second};
+
+                // Even producers push records one by one, odd producers push two records as one batch.
+                if(p % 2)
+                {
+                    while(!stream.tryPushBackTxBatch(batch))
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+                else
+                {
+                    for(const std::string &record : {first, second})
+                    {
+                        while(!stream.tryPushBackTxBuffer(record.data(), record.size()))
+                        {
+                            std::this_thread::yield();
+                        }
+                    }
+                }
+            }
+        });
+    }
+
+    RecordChecker checker;
+    char record[64];
+
+    while(checker.records < producerCount * recordCount)
+    {
+        if(!stream.tryPopFrontTxBuffer(record, 1))
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        size_t length = (unsigned char)record[0];
+        if((length < 6) || !stream.tryPopFrontTxBuffer(record + 1, length - 1))
+        {
+            checker.errors++;
+            break;
+        }
+
+        checker.check(record);
+    }
+
+    for(std::thread &producer : producers)
+    {
+        producer.join();
+    }
+
+    EXPECT_EQ(checker.errors, 0u);
+
+#if STREAM_STATS
+    StreamStatsSnapshot stats = stream.getStats();
+    EXPECT_EQ(stats.tx.bytesIn, stats.tx.bytesOut);
+    EXPECT_LE(stats.tx.peakFill, tx.capacity());
+#endif
+}
+
+TEST(Mpsc, SpscBatchIsPublishedAtOnce)
+{
+    RingBuffer tx(256);
+    RingBuffer rx(16);
+    Stream stream(&tx, &rx);
+    ASSERT_TRUE(stream.setSpscMode(true));
+
+    // Batch: records of one sequence number from all "producers". Small ring makes batches cross the wrap point.
+    std::thread producer([&stream]()
+    {
+        for(size_t n = 0; n < recordCount; n++)
+        {
+            std::string records[producerCount];
+            std::string_view batch[producerCount];
+            for(size_t p = 0; p < producerCount; p++)
+            {
+                records[p] = makeRecord(p, n);
+                batch[p] = records[p];
+            }
+
+            while(!stream.tryPushBackTxBatch(batch))
+            {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    RecordChecker checker;
+    size_t partialBatches = 0;
+    char record[64];
+
+    for(size_t n = 0; n < recordCount; n++)
+    {
+        while(!stream.tryPopFrontTxBuffer(record, 1))
+        {
+            std::this_thread::yield();
+        }
+
+        // Length of whole batch is known from sequence number. All of it must be visible with its first byte.
+        size_t batchSize = 0;
+        for(size_t p = 0; p < producerCount; p++)
+        {
+            batchSize += makeRecord(p, n).size();
+        }
+        partialBatches += (stream.getTxBufferLength() + 1 < batchSize);
+
+        for(size_t p = 0; p < producerCount; p++)
+        {
+            if((p > 0) && !stream.tryPopFrontTxBuffer(record, 1))
+            {
+                checker.errors++;
+                break;
+            }
+
+            size_t length = (unsigned char)record[0];
+            if((length < 6) || !stream.tryPopFrontTxBuffer(record + 1, length - 1))
+            {
+                checker.errors++;
+                break;
+            }
+
+            checker.check(record);
+        }
+    }
+
+    producer.join();
+
+    EXPECT_EQ(partialBatches, 0u);
+    EXPECT_EQ(checker.errors, 0u);
+    EXPECT_EQ(checker.records, producerCount * recordCount);
+}
+
+TEST(Mpsc, BatchIsAllOrNothing)
+{
+    RingBuffer tx(16);
+    RingBuffer rx(16);
+    Stream stream(&tx, &rx);
+
+    stream.pushBackTxBuffer("0123456789ab", 12);
+    stream.consumeTx(10);
+
+    std::string_view tooLarge[] = {"abcdefgh", "ijklmno"};
+    EXPECT_FALSE(stream.tryPushBackTxBatch(tooLarge));
+    EXPECT_EQ(stream.getTxBufferLength(), 2u);
+
+    // Batch crosses the wrap point.
+    std::string_view batch[] = {"cdef", "", "ghijkl"};
+    EXPECT_TRUE(stream.tryPushBackTxBatch(batch));
+
+    char data[16];
+    ASSERT_TRUE(stream.tryPopFrontTxBuffer(data, 12));
+    EXPECT_EQ(std::string(data, 12), "abcdefghijkl");
+
+    std::deque<char> txDeque;
+    std::deque<char> rxDeque;
+    Stream dequeStream(&txDeque, 12, &rxDeque, 12);
+    EXPECT_TRUE(dequeStream.tryPushBackTxBatch(batch));
+    EXPECT_FALSE(dequeStream.tryPushBackTxBatch(batch));
+    EXPECT_EQ(std::string(txDeque.begin(), txDeque.end()), "cdefghijkl");
+}
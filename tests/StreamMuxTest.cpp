@@ -0,0 +1,249 @@
+// ####################################################################################################
+// Tests of StreamMux: routing, frame size limits and deficit round robin share of a socketpair link.
+// Build: cmake -S .. -B build && cmake --build build --target StreamMuxTest && ctest --test-dir build
+
+// ####################################################################################################
+// Include libraries:
+
+#include <gtest/gtest.h>            // Google Test
+#include <memory>                   // std::unique_ptr
+#include <string>                   // String class and related functions
+#include <sys/socket.h>             // socketpair
+#include <unistd.h>                 // close
+#include <vector>                   // Channels of endpoint
+#include "StreamMux.h"
+
+// ####################################################################################################
+// Test helpers:
+
+/// @brief Data with a repeating pattern, so reordered or lost data is detected.
+static std::string pattern(char first, size_t size)
+{
+    std::string data(size, '\0');
+    for(size_t i = 0; i < size; i++)
+    {
+        data[i] = (char)(first + i % 23);
+    }
+    return data;
+}
+
+/**
+ * @struct Endpoint
+ * @brief Link stream, mux and ring buffer channels of one side of a link.
+ */
+struct Endpoint
+{
+    RingBuffer linkTx;
+    RingBuffer linkRx{4096};
+    Stream link{&linkTx, &linkRx};
+    StreamMux mux;
+    std::vector<std::unique_ptr<RingBuffer>> rings;
+    std::vector<std::unique_ptr<Stream>> channels;
+    std::vector<std::string> received;
+
+    Endpoint(size_t linkTxSize, size_t maxFrameSize) : linkTx(linkTxSize), mux(&link, maxFrameSize) {}
+
+    /// @brief Add channel with id equal to its index.
+    Stream& add(uint32_t weight)
+    {
+        rings.push_back(std::make_unique<RingBuffer>(1 << 16));
+        rings.push_back(std::make_unique<RingBuffer>(1 << 16));
+        channels.push_back(std::make_unique<Stream>(rings[rings.size() - 2].get(), rings.back().get()));
+        received.emplace_back();
+        EXPECT_TRUE(mux.addChannel((uint8_t)(channels.size() - 1), channels.back().get(), weight));
+        return *channels.back();
+    }
+
+    /// @brief Route link RX and pop channel RX buffers to received data.
+    void receive(void)
+    {
+        mux.pollRx();
+        for(size_t i = 0; i < channels.size(); i++)
+        {
+            received[i] += channels[i]->popAllRxBuffer();
+        }
+    }
+};
+
+/**
+ * @struct MuxLinkTest
+ * @brief Fixture with a non-blocking socketpair as link.
+ */
+struct MuxLinkTest : public ::testing::Test
+{
+    int pair[2] = {-1, -1};
+
+    void SetUp() override
+    {
+        ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, pair), 0);
+    }
+
+    void TearDown() override
+    {
+        for(int fd : pair)
+        {
+            if(fd >= 0)
+            {
+                close(fd);
+            }
+        }
+    }
+
+    /// @brief One tick of event loop: sender fills its small link TX buffer once and receiver reads it.
+    void tick(Endpoint &sender, Endpoint &receiver)
+    {
+        sender.mux.pollTx();
+        ASSERT_GE(sender.link.sendTx(pair[0]), 0);
+        while(receiver.link.fillRx(pair[1]) > 0)
+        {
+        }
+        receiver.receive();
+    }
+};
+
+// ####################################################################################################
+// Tests:
+
+TEST_F(MuxLinkTest, WeightsShareSaturatedLink)
+{
+    Endpoint sender(256, 64);
+    Endpoint receiver(256, 64);
+    Stream &heavy = sender.add(3);
+    Stream &light = sender.add(1);
+    receiver.add(1);
+    receiver.add(1);
+
+    std::string heavyData = pattern('a', 40000);
+    std::string lightData = pattern('A', 40000);
+    heavy.pushBackTxBuffer(heavyData.data(), heavyData.size());
+    light.pushBackTxBuffer(lightData.data(), lightData.size());
+
+    // Both channels stay backlogged. Link TX buffer limits bytes per tick.
+    for(int i = 0; i < 100; i++)
+    {
+        tick(sender, receiver);
+    }
+
+    size_t heavyBytes = receiver.received[0].size();
+    size_t lightBytes = receiver.received[1].size();
+    ASSERT_GT(lightBytes, 0u);
+    ASSERT_LT(heavyBytes, heavyData.size());
+    EXPECT_NEAR((double)heavyBytes / lightBytes, 3.0, 0.3);
+
+    // Rest of data arrives in order when light channel has link alone.
+    for(int i = 0; (i < 2000) && (receiver.received[0].size() + receiver.received[1].size() < 80000); i++)
+    {
+        tick(sender, receiver);
+    }
+    EXPECT_EQ(receiver.received[0], heavyData);
+    EXPECT_EQ(receiver.received[1], lightData);
+    EXPECT_EQ(receiver.mux.getErrorCount(), 0u);
+}
+
+TEST_F(MuxLinkTest, ControlChannelIsNotStarvedByBulk)
+{
+    Endpoint sender(256, 128);
+    Endpoint receiver(256, 128);
+    Stream &bulk = sender.add(1);
+    Stream &control = sender.add(1);
+    receiver.add(1);
+    receiver.add(1);
+
+    std::string bulkData = pattern('a', 50000);
+    bulk.pushBackTxBuffer(bulkData.data(), bulkData.size());
+
+    for(int i = 0; i < 10; i++)
+    {
+        tick(sender, receiver);
+    }
+
+    // Message that is queued behind bulk data arrives after a few ticks, not after the bulk backlog.
+    control.pushBackTxBuffer("ping\n", 5);
+    int ticks = 0;
+    while((receiver.received[1].empty()) && (ticks < 100))
+    {
+        tick(sender, receiver);
+        ticks++;
+    }
+
+    EXPECT_EQ(receiver.received[1], "ping\n");
+    EXPECT_LE(ticks, 4);
+    EXPECT_LT(receiver.received[0].size(), 10000u);
+}
+
+TEST_F(MuxLinkTest, SetWeightChangesShare)
+{
+    Endpoint sender(256, 64);
+    Endpoint receiver(256, 64);
+    Stream &first = sender.add(1);
+    Stream &second = sender.add(1);
+    receiver.add(1);
+    receiver.add(1);
+
+    EXPECT_FALSE(sender.mux.setWeight(0, 0));
+    EXPECT_FALSE(sender.mux.setWeight(7, 2));
+    ASSERT_TRUE(sender.mux.setWeight(1, 4));
+
+    std::string data = pattern('a', 30000);
+    first.pushBackTxBuffer(data.data(), data.size());
+    second.pushBackTxBuffer(data.data(), data.size());
+
+    for(int i = 0; i < 100; i++)
+    {
+        tick(sender, receiver);
+    }
+
+    ASSERT_GT(receiver.received[0].size(), 0u);
+    EXPECT_NEAR((double)receiver.received[1].size() / receiver.received[0].size(), 4.0, 0.4);
+}
+
+TEST(StreamMux, RoutesFramesAndDropsUnknownChannels)
+{
+    Endpoint endpoint(1024, 64);
+    Stream &known = endpoint.add(1);
+    EXPECT_FALSE(endpoint.mux.addChannel(0, &known));
+    EXPECT_FALSE(endpoint.mux.addChannel(1, nullptr));
+    EXPECT_FALSE(endpoint.mux.addChannel(1, &known, 0));
+
+    // Frame of channel 0 and frame of unknown channel 9.
+    RecordFramer framer(nullptr);
+    std::string frame;
+    std::string input;
+    ASSERT_TRUE(framer.encodeFrame(std::string("\x00" "hello", 6).data(), 6, frame));
+    input += frame;
+    ASSERT_TRUE(framer.encodeFrame("\x09" "lost", 5, frame));
+    input += frame;
+
+    endpoint.link.pushBackRxBuffer(input.data(), input.size());
+    endpoint.receive();
+    EXPECT_EQ(endpoint.received[0], "hello");
+    EXPECT_EQ(endpoint.mux.getErrorCount(), 1u);
+
+    // Frames of removed channel are dropped.
+    ASSERT_TRUE(endpoint.mux.removeChannel(0));
+    EXPECT_FALSE(endpoint.mux.removeChannel(0));
+    ASSERT_TRUE(framer.encodeFrame(std::string("\x00" "late", 5).data(), 5, frame));
+    endpoint.link.pushBackRxBuffer(frame.data(), frame.size());
+    endpoint.receive();
+    EXPECT_EQ(endpoint.received[0], "hello");
+    EXPECT_EQ(endpoint.mux.getErrorCount(), 2u);
+}
+
+TEST(StreamMux, TooSmallMaxFrameSizeIsClamped)
+{
+    // Max frame size 0 is taken as 2: channel id and one data byte per frame on both sides.
+    Endpoint sender(1024, 0);
+    Endpoint receiver(1024, 0);
+    Stream &channel = sender.add(1);
+    receiver.add(1);
+
+    channel.pushBackTxBuffer("abc", 3);
+    EXPECT_EQ(sender.mux.pollTx(), 3u);
+
+    std::string frames(sender.link.getTxBufferLength(), '\0');
+    ASSERT_TRUE(sender.link.tryPopFrontTxBuffer(frames.data(), frames.size()));
+    receiver.link.pushBackRxBuffer(frames.data(), frames.size());
+    receiver.receive();
+    EXPECT_EQ(receiver.received[0], "abc");
+    EXPECT_EQ(receiver.mux.getErrorCount(), 0u);
+}
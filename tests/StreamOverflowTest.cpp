@@ -0,0 +1,197 @@
+// ####################################################################################################
+// Tests of Stream overflow policies and watermark callbacks.
+// Build: cmake -S .. -B build && cmake --build build --target StreamOverflowTest && ctest --test-dir build
+
+// ####################################################################################################
+// Include libraries:
+
+#include <gtest/gtest.h>            // Google Test
+#include <chrono>                   // Blocking timeout
+#include <memory>                   // std::unique_ptr
+#include <string>                   // String class and related functions
+#include <thread>                   // Consumer thread
+#include <vector>                   // Watermark calls
+#include "Stream.h"
+
+// ####################################################################################################
+// Test helpers:
+
+/**
+ * @struct OverflowTest
+ * @brief Fixture that runs each test with deque and ring buffer backends. RX buffer size is 8 for both.
+ */
+struct OverflowTest : public ::testing::TestWithParam<bool>
+{
+    std::deque<char> txDeque;
+    std::deque<char> rxDeque;
+    RingBuffer txRing{8};
+    RingBuffer rxRing{8};
+    std::unique_ptr<Stream> stream;
+
+    void SetUp() override
+    {
+        if(GetParam())
+        {
+            stream = std::make_unique<Stream>(&txRing, &rxRing);
+        }
+        else
+        {
+            stream = std::make_unique<Stream>(&txDeque, 8, &rxDeque, 8);
+        }
+    }
+};
+
+// ####################################################################################################
+// Tests:
+
+TEST_P(OverflowTest, DropOldestIsDefault)
+{
+    EXPECT_EQ(stream->getRxOverflowPolicy(), OverflowPolicy::DROP_OLDEST);
+    EXPECT_EQ(stream->pushBackRxBuffer("abcde", 5), 5u);
+    EXPECT_EQ(stream->pushBackRxBuffer("fghij", 5), 5u);
+    EXPECT_EQ(stream->popAllRxBuffer(), "cdefghij");
+
+    // Only the last part of data that is larger than buffer is stored.
+    EXPECT_EQ(stream->pushBackRxBuffer("0123456789", 10), 8u);
+    EXPECT_EQ(stream->popAllRxBuffer(), "23456789");
+}
+
+TEST_P(OverflowTest, DropNewest)
+{
+    stream->setRxOverflowPolicy(OverflowPolicy::DROP_NEWEST);
+
+    EXPECT_EQ(stream->pushBackRxBuffer("abcde", 5), 5u);
+    EXPECT_EQ(stream->pushBackRxBuffer("fghij", 5), 0u);
+    EXPECT_EQ(stream->pushBackRxBuffer("fgh", 3), 3u);
+    EXPECT_EQ(stream->popAllRxBuffer(), "abcdefgh");
+}
+
+TEST_P(OverflowTest, RejectPartialStoresFirstPart)
+{
+    stream->setRxOverflowPolicy(OverflowPolicy::REJECT_PARTIAL);
+
+    EXPECT_EQ(stream->pushBackRxBuffer("abcde", 5), 5u);
+    EXPECT_EQ(stream->receiveData(std::string("fghij")), 3u);
+    EXPECT_EQ(stream->pushBackRxBuffer("x", 1), 0u);
+    EXPECT_EQ(stream->popAllRxBuffer(), "abcdefgh");
+}
+
+TEST_P(OverflowTest, DropOldestFrameKeepsWholeFrames)
+{
+    stream->setRxOverflowPolicy(OverflowPolicy::DROP_OLDEST_FRAME);
+    stream->setRxFrameDelimiter(';');
+
+    EXPECT_EQ(stream->pushBackRxBuffer("ab;cd;e", 7), 7u);
+
+    // Removing "ab;" makes enough space for 3 characters.
+    EXPECT_EQ(stream->pushBackRxBuffer("fg;", 3), 3u);
+    EXPECT_EQ(stream->popAllRxBuffer(), "cd;efg;");
+
+    // No frame end makes enough space, so new data is dropped.
+    EXPECT_EQ(stream->pushBackRxBuffer("abcdefg", 7), 7u);
+    EXPECT_EQ(stream->pushBackRxBuffer("hi", 2), 0u);
+    EXPECT_EQ(stream->popAllRxBuffer(), "abcdefg");
+}
+
+TEST_P(OverflowTest, TxPolicyIsSeparate)
+{
+    stream->setTxOverflowPolicy(OverflowPolicy::DROP_NEWEST);
+    EXPECT_EQ(stream->getTxOverflowPolicy(), OverflowPolicy::DROP_NEWEST);
+    EXPECT_EQ(stream->getRxOverflowPolicy(), OverflowPolicy::DROP_OLDEST);
+
+    EXPECT_EQ(stream->pushBackTxBuffer("abcdefgh", 8), 8u);
+    EXPECT_EQ(stream->pushBackTxBuffer("i", 1), 0u);
+    EXPECT_EQ(stream->getTxBufferLength(), 8u);
+}
+
+TEST_P(OverflowTest, WatermarksFireOncePerCrossing)
+{
+    std::vector<bool> calls;
+    stream->setRxWatermarks(6, 2, [&calls](bool high) { calls.push_back(high); });
+
+    stream->pushBackRxBuffer("abcd", 4);
+    EXPECT_TRUE(calls.empty());
+
+    stream->pushBackRxBuffer("ef", 2);
+    stream->pushBackRxBuffer("g", 1);
+    EXPECT_EQ(calls, std::vector<bool>{true});
+
+    // Length 4 is between watermarks.
+    stream->removeFrontRxBuffer(3);
+    EXPECT_EQ(calls, std::vector<bool>{true});
+
+    stream->popFrontRxBuffer(2);
+    stream->removeAllRxBuffer();
+    EXPECT_EQ(calls, (std::vector<bool>{true, false}));
+
+    stream->pushBackRxBuffer("abcdefgh", 8);
+    EXPECT_EQ(calls, (std::vector<bool>{true, false, true}));
+
+    // Empty callback disables watermarks.
+    stream->setRxWatermarks(6, 2, nullptr);
+    stream->removeAllRxBuffer();
+    EXPECT_EQ(calls.size(), 3u);
+}
+
+INSTANTIATE_TEST_SUITE_P(Backends, OverflowTest, ::testing::Values(false, true),
+    [](const ::testing::TestParamInfo<bool> &info) { return info.param ? "Ring" : "Deque"; });
+
+TEST(StreamOverflow, SpscDropOldestDoesNotRemoveData)
+{
+    RingBuffer tx(8);
+    RingBuffer rx(8);
+    Stream stream(&tx, &rx);
+    ASSERT_TRUE(stream.setSpscMode(true));
+
+    EXPECT_EQ(stream.pushBackRxBuffer("abcde", 5), 5u);
+    EXPECT_EQ(stream.pushBackRxBuffer("fghij", 5), 3u);
+    EXPECT_EQ(stream.popAllRxBuffer(), "abcdefgh");
+}
+
+TEST(StreamOverflow, BlockWaitsForConsumer)
+{
+    RingBuffer tx(8);
+    RingBuffer rx(8);
+    Stream stream(&tx, &rx);
+    ASSERT_TRUE(stream.setSpscMode(true));
+    stream.setRxOverflowPolicy(OverflowPolicy::BLOCK);
+    stream.setRxBlockingTimeout(5000);
+
+    stream.pushBackRxBuffer("abcdefgh", 8);
+
+    std::string received;
+    std::thread consumer([&stream, &received]()
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        received = stream.popFrontRxBuffer(4);
+    });
+
+    EXPECT_EQ(stream.pushBackRxBuffer("ijkl", 4), 4u);
+    consumer.join();
+
+    EXPECT_EQ(received, "abcd");
+    EXPECT_EQ(stream.popAllRxBuffer(), "efghijkl");
+}
+
+TEST(StreamOverflow, BlockStoresFirstPartAfterTimeout)
+{
+    RingBuffer tx(8);
+    RingBuffer rx(8);
+    Stream stream(&tx, &rx);
+    ASSERT_TRUE(stream.setSpscMode(true));
+    stream.setRxOverflowPolicy(OverflowPolicy::BLOCK);
+    stream.setRxBlockingTimeout(10);
+
+    stream.pushBackRxBuffer("abcdef", 6);
+
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(stream.pushBackRxBuffer("ghij", 4), 2u);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(10));
+    EXPECT_EQ(stream.popAllRxBuffer(), "abcdefgh");
+
+    // Without SPSC mode it does not wait.
+    ASSERT_TRUE(stream.setSpscMode(false));
+    stream.setRxBlockingTimeout(60000);
+    stream.pushBackRxBuffer("abcdef", 6);
+    EXPECT_EQ(stream.pushBackRxBuffer("ghij", 4), 2u);
+}
@@ -0,0 +1,179 @@
+// ####################################################################################################
+// Tests of StreamPump with socketpairs and ptys.
+// Build: cmake -S .. -B build && cmake --build build --target StreamPumpTest && ctest --test-dir build
+
+// ####################################################################################################
+// Include libraries:
+
+#include <gtest/gtest.h>            // Google Test
+#include <chrono>                   // Poll wait time
+#include <fcntl.h>                  // posix_openpt, O_RDWR
+#include <sys/socket.h>             // socketpair
+#include "StreamPump.h"
+
+// ####################################################################################################
+// Test helpers:
+
+/**
+ * @struct PumpTest
+ * @brief Fixture with a pump and a stream on one end of a socketpair.
+ */
+struct PumpTest : public ::testing::Test
+{
+    StreamPump pump;
+    std::deque<char> tx;
+    std::deque<char> rx;
+    Stream stream{&tx, 1024, &rx, 1024};
+    int pair[2] = {-1, -1};
+
+    int dataCount = 0;
+    int closeCount = 0;
+    int closeError = -1;
+
+    void SetUp() override
+    {
+        ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, pair), 0);
+    }
+
+    void TearDown() override
+    {
+        for(int fd : pair)
+        {
+            if(fd >= 0)
+            {
+                close(fd);
+            }
+        }
+    }
+
+    void add(int fd)
+    {
+        ASSERT_TRUE(pump.add(fd, &stream,
+            [this](Stream&, int) { dataCount++; },
+            [this](Stream&, int, int error) { closeCount++; closeError = error; }));
+    }
+};
+
+// ####################################################################################################
+// Tests:
+
+TEST_F(PumpTest, ReadsAndWritesSocket)
+{
+    add(pair[0]);
+
+    ASSERT_EQ(write(pair[1], "hello", 5), 5);
+    ASSERT_GT(pump.poll(1000), 0);
+    EXPECT_EQ(dataCount, 1);
+    EXPECT_EQ(stream.popAllRxBuffer(), "hello");
+
+    stream.pushBackTxBuffer("world");
+    pump.poll(0);
+
+    char buffer[16];
+    EXPECT_EQ(read(pair[1], buffer, sizeof(buffer)), 5);
+    EXPECT_EQ(std::string(buffer, 5), "world");
+}
+
+TEST_F(PumpTest, HangUpWithFullRxClosesAfterDrain)
+{
+    stream.setRxBufferSize(8);
+    add(pair[0]);
+
+    ASSERT_EQ(write(pair[1], "0123456789abcdefghij", 20), 20);
+    close(pair[1]);
+    pair[1] = -1;
+
+    // Hang up must not spin the pump while RX buffer is full and nobody consumes it.
+    auto start = std::chrono::steady_clock::now();
+    for(int i = 0; i < 5; i++)
+    {
+        pump.poll(100);
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    EXPECT_GE(elapsed, std::chrono::milliseconds(40));
+    EXPECT_EQ(dataCount, 1);
+    EXPECT_EQ(closeCount, 0);
+
+    std::string received;
+    for(int i = 0; (i < 10) && (closeCount == 0); i++)
+    {
+        received += stream.popAllRxBuffer();
+        pump.wakeup();
+        pump.poll(100);
+    }
+    received += stream.popAllRxBuffer();
+
+    EXPECT_EQ(received, "0123456789abcdefghij");
+    EXPECT_EQ(closeCount, 1);
+    EXPECT_EQ(closeError, 0);
+    EXPECT_EQ(pump.size(), 0u);
+}
+
+TEST_F(PumpTest, FullRxDoesNotBlockPollForever)
+{
+    stream.setRxBufferSize(4);
+    add(pair[0]);
+
+    ASSERT_EQ(write(pair[1], "abcdefgh", 8), 8);
+    pump.poll(100);
+    EXPECT_EQ(stream.getRxBufferLength(), 4u);
+
+    // Input is not watched while RX is full. Pump returns to check it again even if consumer does not call wakeup().
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(pump.poll(-1), 0);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(1000));
+
+    EXPECT_EQ(stream.popAllRxBuffer(), "abcd");
+    pump.poll(100);
+    EXPECT_EQ(stream.popAllRxBuffer(), "efgh");
+}
+
+TEST_F(PumpTest, ClosedPeerFailsWriteWithoutSignal)
+{
+    add(pair[0]);
+    close(pair[1]);
+    pair[1] = -1;
+
+    stream.pushBackTxBuffer("lost");
+    pump.poll(100);
+
+    EXPECT_EQ(closeCount, 1);
+    EXPECT_EQ(closeError, 0);
+}
+
+TEST(StreamPumpPty, ReadsUntilSlaveCloses)
+{
+    int master = posix_openpt(O_RDWR | O_NOCTTY);
+    ASSERT_GE(master, 0);
+    ASSERT_EQ(grantpt(master), 0);
+    ASSERT_EQ(unlockpt(master), 0);
+
+    int slave = open(ptsname(master), O_RDWR | O_NOCTTY);
+    ASSERT_GE(slave, 0);
+
+    StreamPump pump;
+    std::deque<char> tx;
+    std::deque<char> rx;
+    Stream stream(&tx, 1024, &rx, 1024);
+    int closeCount = 0;
+
+    ASSERT_TRUE(pump.add(master, &stream, nullptr, [&](Stream&, int, int) { closeCount++; }));
+
+    ASSERT_EQ(write(slave, "pty", 3), 3);
+    for(int i = 0; (i < 10) && (stream.getRxBufferLength() < 3); i++)
+    {
+        pump.poll(100);
+    }
+    EXPECT_EQ(stream.popAllRxBuffer(), "pty");
+
+    // Closed slave reports EIO that is handled as end of file.
+    close(slave);
+    for(int i = 0; (i < 10) && (closeCount == 0); i++)
+    {
+        pump.poll(100);
+    }
+    EXPECT_EQ(closeCount, 1);
+
+    close(master);
+}
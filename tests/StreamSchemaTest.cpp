@@ -0,0 +1,127 @@
+// ####################################################################################################
+// Tests of Schema: one pass decode compared with splitString + validateRow + checkValuetype.
+// Build: cmake -S .. -B build && cmake --build build --target StreamSchemaTest && ctest --test-dir build
+
+// ####################################################################################################
+// Include libraries:
+
+#include <gtest/gtest.h>            // Google Test
+#include <string>                   // String class and related functions
+#include <vector>                   // Dynamic array container
+#include "StreamSchema.h"
+
+// ####################################################################################################
+// Test data:
+
+/// @brief Schema used by tests.
+using TelemetrySchema = Schema<uint16_t, float, bool, std::string_view, int8_t>;
+
+/**
+ * @struct Telemetry
+ * @brief User struct with the same member types as TelemetrySchema columns.
+ */
+struct Telemetry
+{
+    uint16_t id;
+    float value;
+    bool valid;
+    std::string_view source;
+    int8_t offset;
+};
+
+/// @brief Validate row with the string based functions of Stream.h.
+static bool validateWithStrings(const std::string &line, char delimiter)
+{
+    std::vector<std::string> tokens = splitString(line, delimiter);
+
+    if(!validateRow(tokens, TelemetrySchema::columnCount))
+    {
+        return false;
+    }
+
+    for(size_t i = 0; i < tokens.size(); i++)
+    {
+        if(!checkValuetype(tokens[i], TelemetrySchema::typeNames[i]))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// ####################################################################################################
+// Tests:
+
+TEST(Schema, DecodesTypedRow)
+{
+    TelemetrySchema::Row row;
+
+    ASSERT_TRUE(TelemetrySchema::decode(" 12, 3.5 ,TRUE, GPS ,-4", ',', row));
+    EXPECT_EQ(std::get<0>(row), 12);
+    EXPECT_FLOAT_EQ(std::get<1>(row), 3.5f);
+    EXPECT_TRUE(std::get<2>(row));
+    EXPECT_EQ(std::get<3>(row), "GPS");
+    EXPECT_EQ(std::get<4>(row), -4);
+
+    Telemetry telemetry{};
+    ASSERT_TRUE(TelemetrySchema::decodeTo("7;0.25;false;IMU;127", ';', telemetry));
+    EXPECT_EQ(telemetry.id, 7);
+    EXPECT_EQ(telemetry.source, "IMU");
+    EXPECT_EQ(telemetry.offset, 127);
+}
+
+TEST(Schema, DecodeToKeepsOutputOnInvalidRow)
+{
+    Telemetry telemetry{1, 2.0f, true, "old", 3};
+
+    EXPECT_FALSE(TelemetrySchema::decodeTo("7,0.25,false,IMU,128", ',', telemetry));
+    EXPECT_EQ(telemetry.id, 1);
+    EXPECT_EQ(telemetry.source, "old");
+}
+
+TEST(Schema, SameValidityAsStringFunctions)
+{
+    const std::vector<std::string> lines = {
+        "1,2,true,x,3",
+        "1,2,true,x,3,",
+        "1,2,true,x,3,,",
+        "1,2,true,x",
+        "1,2,true,x,3,4",
+        "1,2,true,,3",
+        "1,2,true, ,3",
+        "-1,2,true,x,3",
+        "65535,2,true,x,3",
+        "65536,2,true,x,3",
+        "1,1e39,true,x,3",
+        "1,2,yes,x,3",
+        "1,2,true,x,-129",
+        " +1 , +2.5 , false , text with spaces , +5 ",
+        ",1,2,true,x,3",
+        "",
+        ",,,,",
+        "1,2,true,x,3 4",
+    };
+
+    for(const std::string &line : lines)
+    {
+        EXPECT_EQ(TelemetrySchema::validate(line, ','), validateWithStrings(line, ',')) << '"' << line << '"';
+    }
+}
+
+TEST(Schema, TypeNamesMatchCheckValuetype)
+{
+    EXPECT_EQ(TelemetrySchema::columnCount, 5u);
+    EXPECT_EQ(TelemetrySchema::typeNames[0], "uint16");
+    EXPECT_EQ(TelemetrySchema::typeNames[1], "float");
+    EXPECT_EQ(TelemetrySchema::typeNames[2], "bool");
+    EXPECT_EQ(TelemetrySchema::typeNames[3], "string");
+    EXPECT_EQ(TelemetrySchema::typeNames[4], "int8");
+
+    using OwningSchema = Schema<std::string, double>;
+    OwningSchema::Row row;
+    std::string line = "name, 1.5";
+    ASSERT_TRUE(OwningSchema::decode(line, ',', row));
+    line.clear();
+    EXPECT_EQ(std::get<0>(row), "name");
+}
@@ -0,0 +1,182 @@
+// ####################################################################################################
+// Tests of single producer/single consumer mode of RingBuffer and Stream with two threads.
+// Build: cmake -S .. -B build && cmake --build build --target StreamSpscTest && ctest --test-dir build
+
+// ####################################################################################################
+// Include libraries:
+
+#include <gtest/gtest.h>            // Google Test
+#include <string>                   // String class and related functions
+#include <thread>                   // Producer thread
+#include "RingBuffer.h"
+#include "Stream.h"
+
+// ####################################################################################################
+// Test data:
+
+/// @brief Number of records or bytes of stress tests. Small buffers make them cross the wrap point many times.
+static const size_t stressCount = 200000;
+
+/// @brief Character of record at certain position. Records differ in size and content.
+static char recordChar(size_t record, size_t index)
+{
+    return (char)((record * 31 + index * 7) & 0xFF);
+}
+
+// ####################################################################################################
+// Tests:
+
+TEST(Spsc, TryPushAndTryPopAreAllOrNothing)
+{
+    RingBuffer ring(8);
+    char data[8];
+
+    EXPECT_TRUE(ring.tryPush("abcde", 5));
+    EXPECT_FALSE(ring.tryPush("fghi", 4));
+    EXPECT_EQ(ring.size(), 5u);
+
+    EXPECT_FALSE(ring.tryPop(data, 6));
+    EXPECT_TRUE(ring.tryPop(data, 5));
+    EXPECT_EQ(std::string(data, 5), "abcde");
+}
+
+TEST(Spsc, ModeNeedsRingBuffers)
+{
+    std::deque<char> tx;
+    std::deque<char> rx;
+    Stream dequeStream(&tx, 16, &rx, 16);
+    EXPECT_FALSE(dequeStream.setSpscMode(true));
+    EXPECT_FALSE(dequeStream.getSpscMode());
+
+    RingBuffer txRing(16);
+    RingBuffer rxRing(16);
+    Stream ringStream(&txRing, &rxRing);
+    EXPECT_TRUE(ringStream.setSpscMode(true));
+    EXPECT_TRUE(ringStream.getSpscMode());
+}
+
+TEST(Spsc, ProducerDropsNewDataInsteadOfOld)
+{
+    RingBuffer tx(4);
+    RingBuffer rx(4);
+    Stream stream(&tx, &rx);
+    stream.setSpscMode(true);
+
+    stream.pushBackRxBuffer("abcdef", 6);
+    EXPECT_FALSE(stream.tryPushBackRxBuffer("g", 1));
+    EXPECT_EQ(stream.popAllRxBuffer(), "abcd");
+}
+
+TEST(Spsc, TwoThreadBytesKeepOrder)
+{
+    RingBuffer ring(64);
+
+    std::thread producer([&ring]()
+    {
+        char chunk[23];
+        size_t sent = 0;
+
+        while(sent < stressCount)
+        {
+            size_t size = std::min(sizeof(chunk), stressCount - sent);
+            for(size_t i = 0; i < size; i++)
+            {
+                chunk[i] = recordChar(0, sent + i);
+            }
+
+            size_t pushed = ring.push(chunk, size);
+            sent += pushed;
+
+            if(pushed == 0)
+            {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    char chunk[17];
+    size_t received = 0;
+    size_t errors = 0;
+
+    while(received < stressCount)
+    {
+        size_t popped = ring.pop(chunk, sizeof(chunk));
+
+        for(size_t i = 0; i < popped; i++)
+        {
+            errors += (chunk[i] != recordChar(0, received + i));
+        }
+
+        received += popped;
+
+        if(popped == 0)
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    producer.join();
+
+    EXPECT_EQ(errors, 0u);
+    EXPECT_TRUE(ring.empty());
+}
+
+TEST(Spsc, TwoThreadStreamRecordsKeepOrder)
+{
+    RingBuffer tx(64);
+    RingBuffer rx(64);
+    Stream stream(&tx, &rx);
+    ASSERT_TRUE(stream.setSpscMode(true));
+
+    // Record: one length byte and length bytes of content. tryPushBackRxBuffer stores a record as one unit.
+    std::thread producer([&stream]()
+    {
+        char record[32];
+
+        for(size_t n = 0; n < stressCount; n++)
+        {
+            size_t length = 1 + n % 30;
+            record[0] = (char)length;
+            for(size_t i = 0; i < length; i++)
+            {
+                record[1 + i] = recordChar(n, i);
+            }
+
+            while(!stream.tryPushBackRxBuffer(record, length + 1))
+            {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    char record[32];
+    size_t errors = 0;
+
+    for(size_t n = 0; n < stressCount; n++)
+    {
+        while(!stream.tryPopFrontRxBuffer(record, 1))
+        {
+            std::this_thread::yield();
+        }
+
+        size_t length = (size_t)record[0];
+        errors += (length != 1 + n % 30);
+
+        // Whole record is published at once, so its content is already there.
+        if(!stream.tryPopFrontRxBuffer(record + 1, length))
+        {
+            errors++;
+            break;
+        }
+
+        for(size_t i = 0; i < length; i++)
+        {
+            errors += (record[1 + i] != recordChar(n, i));
+        }
+    }
+
+    producer.join();
+
+    EXPECT_EQ(errors, 0u);
+    EXPECT_EQ(rx.size(), 0u);
+}
@@ -0,0 +1,177 @@
+// ####################################################################################################
+// Tests of Stream statistics counters and their text/JSON snapshot.
+// Build: cmake -S .. -B build && cmake --build build --target StreamStatsTest && ctest --test-dir build
+
+// ####################################################################################################
+// Include libraries:
+
+#include <gtest/gtest.h>            // Google Test
+#include <string>                   // String class and related functions
+#include <thread>                   // Consumer thread
+#include "Stream.h"
+#include "StreamWriter.h"
+
+// ####################################################################################################
+// Tests:
+
+#if STREAM_STATS
+
+TEST(StreamStats, CountsPushPopAndDrops)
+{
+    RingBuffer tx(8);
+    RingBuffer rx(8);
+    Stream stream(&tx, &rx);
+
+    stream.pushBackRxBuffer("abcde", 5);
+    stream.pushBackRxBuffer("fghij", 5);
+    stream.popFrontRxBuffer(3);
+    stream.removeFrontRxBuffer(1);
+
+    StreamStatsSnapshot stats = stream.getStats();
+    EXPECT_TRUE(stats.enabled);
+    EXPECT_EQ(stats.rx.bytesIn, 10u);
+    EXPECT_EQ(stats.rx.bytesDropped, 2u);
+    EXPECT_EQ(stats.rx.bytesOut, 4u);
+    EXPECT_EQ(stats.rx.pushCount, 2u);
+    EXPECT_EQ(stats.rx.popCount, 2u);
+    EXPECT_EQ(stats.rx.currentFill, 4u);
+    EXPECT_EQ(stats.rx.peakFill, 8u);
+    EXPECT_EQ(stats.tx.bytesIn, 0u);
+
+    // Rejected new data is dropped too.
+    stream.setTxOverflowPolicy(OverflowPolicy::REJECT_PARTIAL);
+    stream.pushBackTxBuffer("0123456789", 10);
+    stats = stream.getStats();
+    EXPECT_EQ(stats.tx.bytesIn, 8u);
+    EXPECT_EQ(stats.tx.bytesDropped, 2u);
+
+    stream.resetStats();
+    stats = stream.getStats();
+    EXPECT_EQ(stats.rx.bytesIn, 0u);
+    EXPECT_EQ(stats.tx.bytesDropped, 0u);
+    EXPECT_EQ(stats.rx.currentFill, 4u);
+}
+
+TEST(StreamStats, DroppedWriterRecordIsCounted)
+{
+    RingBuffer tx(4096);
+    RingBuffer rx(8);
+    Stream stream(&tx, &rx);
+
+    // Small contiguous space makes the record continue in the writer buffer, where it does not fit.
+    std::string filler(4090, '-');
+    stream.pushBackTxBuffer(filler);
+    stream.consumeTx(filler.size());
+    stream.pushBackTxBuffer("x", 1);
+    stream.resetStats();
+
+    std::string large(STREAM_WRITER_BUFFER_SIZE, 'x');
+    StreamWriter writer(stream);
+    writer << large << large << 12345;
+    EXPECT_FALSE(writer.commit());
+
+    StreamStatsSnapshot stats = stream.getStats();
+    EXPECT_EQ(stats.tx.bytesDropped, 2 * large.size() + 5);
+    EXPECT_EQ(stats.tx.bytesIn, 0u);
+}
+
+TEST(StreamStats, LatencyHistogramCountsPops)
+{
+    RingBuffer tx(64);
+    RingBuffer rx(64);
+    Stream stream(&tx, &rx);
+    stream.setLatencyStats(true);
+
+    for(int i = 0; i < 10; i++)
+    {
+        stream.pushBackRxBuffer("abcd", 4);
+        stream.popFrontRxBuffer(4);
+    }
+
+    StreamStatsSnapshot stats = stream.getStats();
+    EXPECT_EQ(stats.rx.latencyCount, 10u);
+
+    uint64_t samples = 0;
+    for(uint64_t bucket : stats.rx.latencyHistogram)
+    {
+        samples += bucket;
+    }
+    EXPECT_EQ(samples, 10u);
+    EXPECT_NE(stats.toText().find("rx latency: samples=10"), std::string::npos);
+}
+
+TEST(StreamStats, SpscCountersFromTwoThreads)
+{
+    RingBuffer tx(64);
+    RingBuffer rx(64);
+    Stream stream(&tx, &rx);
+    ASSERT_TRUE(stream.setSpscMode(true));
+
+    const size_t total = 7 * 20000;
+    std::thread producer([&stream, total]()
+    {
+        for(size_t sent = 0; sent < total; )
+        {
+            if(stream.tryPushBackRxBuffer("abcdefg", 7))
+            {
+                sent += 7;
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    size_t received = 0;
+    char data[16];
+    while(received < total)
+    {
+        if(stream.tryPopFrontRxBuffer(data, 7))
+        {
+            received += 7;
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+
+    StreamStatsSnapshot stats = stream.getStats();
+    EXPECT_EQ(stats.rx.bytesIn, received);
+    EXPECT_EQ(stats.rx.bytesOut, received);
+    EXPECT_LE(stats.rx.peakFill, 64u);
+}
+
+TEST(StreamStats, TextAndJson)
+{
+    std::deque<char> tx;
+    std::deque<char> rx;
+    Stream stream(&tx, 16, &rx, 16);
+    stream.pushBackTxBuffer("abc", 3);
+
+    StreamStatsSnapshot stats = stream.getStats();
+    EXPECT_EQ(stats.toText(), "tx: in=3 out=0 dropped=0 pushes=1 pops=0 fill=3 peak=3\n"
+                              "rx: in=0 out=0 dropped=0 pushes=0 pops=0 fill=0 peak=0\n");
+
+    std::string json = stats.toJson();
+    EXPECT_EQ(json.rfind("{\"enabled\":true,\"tx\":{\"bytesIn\":3,\"bytesOut\":0,\"bytesDropped\":0,", 0), 0u);
+    EXPECT_NE(json.find(",\"rx\":{\"bytesIn\":0,"), std::string::npos);
+    EXPECT_EQ(json.back(), '}');
+}
+
+#else
+
+TEST(StreamStats, DisabledSnapshotIsEmpty)
+{
+    std::deque<char> tx;
+    std::deque<char> rx;
+    Stream stream(&tx, 16, &rx, 16);
+    stream.pushBackTxBuffer("abc", 3);
+
+    EXPECT_FALSE(stream.getStats().enabled);
+    EXPECT_EQ(stream.getStats().toText(), "stats disabled\n");
+}
+
+#endif
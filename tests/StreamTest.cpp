@@ -0,0 +1,184 @@
+// ####################################################################################################
+// Tests of Stream buffer operations with deque and ring buffer backends.
+// Build: cmake -S .. -B build && cmake --build build --target StreamTest && ctest --test-dir build
+
+// ####################################################################################################
+// Include libraries:
+
+#include <gtest/gtest.h>            // Google Test
+#include <cstring>                  // std::memcpy
+#include <string>                   // String class and related functions
+#include "Stream.h"
+
+// ####################################################################################################
+// Tests:
+
+TEST(Stream, PopFrontRxRangeFromDeque)
+{
+    std::deque<char> tx;
+    std::deque<char> rx;
+    Stream stream(&tx, 64, &rx, 64);
+
+    stream.pushBackRxBuffer("abcdefgh", 8);
+    EXPECT_EQ(stream.popFrontRxBuffer(3), "abc");
+    EXPECT_EQ(rx.size(), 5u);
+
+    // Popping more than stored returns the rest.
+    EXPECT_EQ(stream.popFrontRxBuffer(100), "defgh");
+    EXPECT_TRUE(rx.empty());
+    EXPECT_EQ(stream.popFrontRxBuffer(1), "");
+}
+
+TEST(Stream, RemoveFrontRangeFromDeque)
+{
+    std::deque<char> tx;
+    std::deque<char> rx;
+    Stream stream(&tx, 64, &rx, 64);
+
+    stream.pushBackRxBuffer("abcdefgh", 8);
+    stream.removeFrontRxBuffer(5);
+    EXPECT_EQ(stream.popAllRxBuffer(), "fgh");
+
+    stream.pushBackTxBuffer("0123456789", 10);
+    stream.removeFrontTxBuffer(4);
+    EXPECT_EQ(std::string(tx.begin(), tx.end()), "456789");
+    stream.removeFrontTxBuffer(100);
+    EXPECT_TRUE(tx.empty());
+
+    stream.pushBackRxBuffer("xyz", 3);
+    stream.removeFrontRxBuffer(100);
+    EXPECT_TRUE(rx.empty());
+}
+
+TEST(Stream, RemoveFrontRangeFromRing)
+{
+    RingBuffer tx(16);
+    RingBuffer rx(16);
+    Stream stream(&tx, &rx);
+
+    stream.pushBackRxBuffer("abcdefgh", 8);
+    stream.removeFrontRxBuffer(5);
+    EXPECT_EQ(stream.popAllRxBuffer(), "fgh");
+
+    stream.pushBackTxBuffer("0123456789", 10);
+    stream.removeFrontTxBuffer(4);
+    EXPECT_EQ(tx.size(), 6u);
+    EXPECT_EQ(tx.at(0), '4');
+    stream.removeAllTxBuffer();
+    EXPECT_TRUE(tx.empty());
+}
+
+TEST(Stream, DequeOverflowDropsOldest)
+{
+    std::deque<char> tx;
+    std::deque<char> rx;
+    Stream stream(&tx, 4, &rx, 4);
+
+    stream.pushBackRxBuffer("abc", 3);
+    stream.pushBackRxBuffer("def", 3);
+    EXPECT_EQ(stream.popAllRxBuffer(), "cdef");
+
+    stream.pushBackTxBuffer("012", 3);
+    stream.pushBackTxBuffer("3456", 4);
+    EXPECT_EQ(std::string(tx.begin(), tx.end()), "3456");
+}
+
+TEST(Stream, ReceiveDataStoresCharArray)
+{
+    std::deque<char> tx;
+    std::deque<char> rx;
+    Stream stream(&tx, 64, &rx, 64);
+
+    const char data[] = "hello";
+    stream.receiveData(data[0], 5);
+    EXPECT_EQ(stream.popAllRxBuffer(), "hello");
+
+    stream.receiveData(std::string("world"));
+    EXPECT_EQ(stream.popAllRxBuffer(), "world");
+
+    std::deque<char> input = {'a', 'b', 'c'};
+    stream.receiveData(input);
+    EXPECT_EQ(stream.popAllRxBuffer(), "abc");
+}
+
+TEST(Stream, LargePopKeepsOrder)
+{
+    std::deque<char> tx;
+    std::deque<char> rx;
+    Stream stream(&tx, 1 << 20, &rx, 1 << 20);
+
+    std::string data;
+    for(int i = 0; i < 100000; i++)
+    {
+        data.push_back((char)('a' + i % 26));
+    }
+
+    stream.pushBackRxBuffer(data.data(), data.size());
+    std::string first = stream.popFrontRxBuffer(40000);
+    std::string rest = stream.popAllRxBuffer();
+
+    EXPECT_EQ(first + rest, data);
+}
+
+TEST(Stream, PeekAndConsumeRxWithoutCopy)
+{
+    RingBuffer tx(8);
+    RingBuffer rx(8);
+    Stream stream(&tx, &rx);
+
+    stream.pushBackRxBuffer("abcdef", 6);
+    stream.removeFrontRxBuffer(4);
+    stream.pushBackRxBuffer("ghijk", 5);
+
+    RingRegions<const char> regions = stream.peekRx();
+    ASSERT_EQ(regions.size(), 7u);
+    std::string joined(regions.first.data(), regions.first.size());
+    joined.append(regions.second.data(), regions.second.size());
+    EXPECT_EQ(joined, "efghijk");
+
+    stream.consumeRx(3);
+    EXPECT_EQ(stream.popAllRxBuffer(), "hijk");
+}
+
+TEST(Stream, PrepareAndCommitTx)
+{
+    RingBuffer tx(8);
+    RingBuffer rx(8);
+    Stream stream(&tx, &rx);
+
+    stream.pushBackTxBuffer("abcdef", 6);
+    stream.consumeTx(6);
+
+    // Contiguous free space ends at end of storage.
+    std::span<char> span = stream.prepareTx(100);
+    EXPECT_EQ(span.size(), 2u);
+    std::memcpy(span.data(), "xy", 2);
+    stream.commitTx(2);
+
+    span = stream.prepareTx(3);
+    EXPECT_EQ(span.size(), 3u);
+    std::memcpy(span.data(), "z", 1);
+    stream.commitTx(1);
+
+    RingRegions<const char> regions = stream.peekTx();
+    EXPECT_EQ(std::string(regions.first.data(), regions.first.size()), "xy");
+    EXPECT_EQ(std::string(regions.second.data(), regions.second.size()), "z");
+}
+
+TEST(Stream, PrepareDoesNotEvictAndDequeHasNoRegions)
+{
+    RingBuffer tx(4);
+    RingBuffer rx(4);
+    Stream stream(&tx, &rx);
+
+    stream.pushBackRxBuffer("abcd", 4);
+    EXPECT_TRUE(stream.prepareRx(1).empty());
+    EXPECT_EQ(stream.popAllRxBuffer(), "abcd");
+
+    std::deque<char> txDeque;
+    std::deque<char> rxDeque;
+    Stream dequeStream(&txDeque, 16, &rxDeque, 16);
+    dequeStream.pushBackRxBuffer("abc", 3);
+    EXPECT_TRUE(dequeStream.peekRx().empty());
+    EXPECT_TRUE(dequeStream.prepareTx(4).empty());
+}
@@ -0,0 +1,216 @@
+// ####################################################################################################
+// Tests of StreamUring fill and flush with pipes, with io_uring and with synchronous fallback.
+// Build: cmake -S .. -B build && cmake --build build --target StreamUringTest && ctest --test-dir build
+
+// ####################################################################################################
+// Include libraries:
+
+#include <gtest/gtest.h>            // Google Test
+#include <fcntl.h>                  // fcntl, O_NONBLOCK
+#include <memory>                   // std::unique_ptr
+#include <string>                   // String class and related functions
+#include <vector>                   // Completion results
+#include "StreamUring.h"
+
+// ####################################################################################################
+// Test helpers:
+
+/// @brief Read everything that is available from non-blocking descriptor.
+static std::string readAvailable(int fd)
+{
+    std::string data;
+    char chunk[4096];
+    ssize_t size;
+
+    while((size = read(fd, chunk, sizeof(chunk))) > 0)
+    {
+        data.append(chunk, size);
+    }
+
+    return data;
+}
+
+/**
+ * @struct UringPipeTest
+ * @brief Fixture with a non-blocking pipe and record of completions.
+ */
+struct UringPipeTest : public ::testing::Test
+{
+    int fds[2] = {-1, -1};
+    std::vector<int> results;
+
+    void SetUp() override
+    {
+        ASSERT_EQ(pipe(fds), 0);
+        fcntl(fds[0], F_SETFL, fcntl(fds[0], F_GETFL) | O_NONBLOCK);
+        fcntl(fds[1], F_SETFL, fcntl(fds[1], F_GETFL) | O_NONBLOCK);
+    }
+
+    void TearDown() override
+    {
+        for(int fd : fds)
+        {
+            if(fd >= 0)
+            {
+                close(fd);
+            }
+        }
+    }
+
+    /// @brief Completion callback that records results.
+    StreamUring::CompletionCallback recorder(void)
+    {
+        return [this](Stream&, int, bool, int result) { results.push_back(result); };
+    }
+
+    /// @brief Submit until all operations are completed.
+    void complete(StreamUring &uring)
+    {
+        for(int i = 0; (i < 100) && (uring.pending() > 0); i++)
+        {
+            ASSERT_GE(uring.submit(1), 0);
+        }
+        EXPECT_EQ(uring.pending(), 0u);
+    }
+};
+
+// ####################################################################################################
+// Tests:
+
+TEST_F(UringPipeTest, FillScattersAcrossWrapPoint)
+{
+    StreamUring uring;
+    if(!uring.isUring())
+    {
+        GTEST_SKIP() << "io_uring is not available (ENOSYS or blocked)";
+    }
+
+    RingBuffer tx(16);
+    RingBuffer rx(16);
+    Stream stream(&tx, &rx);
+
+    stream.pushBackRxBuffer("0123456789ab", 12);
+    stream.consumeRx(10);
+    ASSERT_EQ(write(fds[1], "cdefghijklmnopqrstu", 19), 19);
+
+    // Free space is [12, 16) and [0, 10). One read fills both regions.
+    ASSERT_TRUE(uring.add(fds[0], &stream, recorder()));
+    ASSERT_TRUE(uring.fill(fds[0]));
+    EXPECT_FALSE(uring.fill(fds[0]));
+    complete(uring);
+
+    EXPECT_EQ(results, std::vector<int>{14});
+    EXPECT_EQ(stream.popAllRxBuffer(), "abcdefghijklmnop");
+    EXPECT_EQ(readAvailable(fds[0]), "qrstu");
+}
+
+TEST_F(UringPipeTest, FlushGathersAcrossWrapPoint)
+{
+    StreamUring uring;
+    if(!uring.isUring())
+    {
+        GTEST_SKIP() << "io_uring is not available (ENOSYS or blocked)";
+    }
+
+    RingBuffer tx(16);
+    RingBuffer rx(16);
+    Stream stream(&tx, &rx);
+
+    stream.pushBackTxBuffer("0123456789ab", 12);
+    stream.consumeTx(10);
+    stream.pushBackTxBuffer("cdefghijkl", 10);
+
+    ASSERT_TRUE(uring.add(fds[1], &stream, recorder()));
+    ASSERT_TRUE(uring.flush(fds[1]));
+    complete(uring);
+
+    EXPECT_EQ(results, std::vector<int>{12});
+    EXPECT_TRUE(tx.empty());
+    EXPECT_EQ(readAvailable(fds[0]), "abcdefghijkl");
+}
+
+TEST_F(UringPipeTest, ManyOperationsInOneSubmit)
+{
+    StreamUring uring(4);
+    if(!uring.isUring())
+    {
+        GTEST_SKIP() << "io_uring is not available (ENOSYS or blocked)";
+    }
+
+    // More pipes than submission queue entries. Full queue is passed to kernel while queuing.
+    const size_t pipeCount = 12;
+    std::vector<int> pipes(pipeCount * 2);
+    std::vector<std::unique_ptr<RingBuffer>> rings;
+    std::vector<std::unique_ptr<Stream>> streams;
+
+    for(size_t i = 0; i < pipeCount; i++)
+    {
+        ASSERT_EQ(pipe(&pipes[i * 2]), 0);
+        rings.push_back(std::make_unique<RingBuffer>(64));
+        rings.push_back(std::make_unique<RingBuffer>(64));
+        streams.push_back(std::make_unique<Stream>(rings[i * 2].get(), rings[i * 2 + 1].get()));
+
+        std::string data = "pipe" + std::to_string(i);
+        ASSERT_EQ(write(pipes[i * 2 + 1], data.data(), data.size()), (ssize_t)data.size());
+        ASSERT_TRUE(uring.add(pipes[i * 2], streams[i].get(), recorder()));
+        ASSERT_TRUE(uring.fill(pipes[i * 2]));
+    }
+
+    complete(uring);
+    EXPECT_EQ(results.size(), pipeCount);
+
+    for(size_t i = 0; i < pipeCount; i++)
+    {
+        EXPECT_EQ(streams[i]->popAllRxBuffer(), "pipe" + std::to_string(i));
+        EXPECT_TRUE(uring.remove(pipes[i * 2]));
+        close(pipes[i * 2]);
+        close(pipes[i * 2 + 1]);
+    }
+}
+
+TEST_F(UringPipeTest, DequeStreamUsesSynchronousFallback)
+{
+    StreamUring uring;
+    std::deque<char> tx;
+    std::deque<char> rx;
+    Stream stream(&tx, 64, &rx, 64);
+
+    ASSERT_TRUE(uring.add(fds[0], &stream, recorder()));
+    ASSERT_TRUE(uring.add(fds[1], &stream, recorder()));
+    EXPECT_FALSE(uring.add(fds[1], &stream));
+
+    // Nothing to write.
+    EXPECT_FALSE(uring.flush(fds[1]));
+
+    stream.pushBackTxBuffer("hello", 5);
+    ASSERT_TRUE(uring.flush(fds[1]));
+    EXPECT_EQ(uring.pending(), 1u);
+    EXPECT_EQ(uring.submit(), 1);
+    EXPECT_TRUE(tx.empty());
+
+    ASSERT_TRUE(uring.fill(fds[0]));
+    EXPECT_FALSE(uring.remove(fds[0]));
+    EXPECT_EQ(uring.submit(), 1);
+    EXPECT_EQ(stream.popAllRxBuffer(), "hello");
+
+    // Pipe is empty. Error is passed to callback as negative errno value.
+    ASSERT_TRUE(uring.fill(fds[0]));
+    EXPECT_EQ(uring.submit(), 1);
+    EXPECT_EQ(results, (std::vector<int>{5, 5, -EAGAIN}));
+    EXPECT_EQ(uring.pending(), 0u);
+    EXPECT_TRUE(uring.remove(fds[0]));
+    EXPECT_FALSE(uring.fill(fds[0]));
+}
+
+TEST_F(UringPipeTest, FillNeedsFreeSpace)
+{
+    StreamUring uring;
+    RingBuffer tx(4);
+    RingBuffer rx(4);
+    Stream stream(&tx, &rx);
+
+    stream.pushBackRxBuffer("abcd", 4);
+    ASSERT_TRUE(uring.add(fds[0], &stream));
+    EXPECT_FALSE(uring.fill(fds[0]));
+    EXPECT_EQ(uring.pending(), 0u);
+}
@@ -0,0 +1,134 @@
+// ####################################################################################################
+// Tests of StreamWriter record serialization into TX buffer.
+// Build: cmake -S .. -B build && cmake --build build --target StreamWriterTest && ctest --test-dir build
+
+// ####################################################################################################
+// Include libraries:
+
+#include <gtest/gtest.h>            // Google Test
+#include <cstdint>                  // Integer limits
+#include <string>                   // String class and related functions
+#include "StreamWriter.h"
+
+// ####################################################################################################
+// Test helpers:
+
+/// @brief Pop all characters of TX buffer of a ring buffer stream.
+static std::string popAllTx(Stream &stream)
+{
+    RingRegions<const char> regions = stream.peekTx();
+    std::string data(regions.first.data(), regions.first.size());
+    data.append(regions.second.data(), regions.second.size());
+    stream.consumeTx(data.size());
+    return data;
+}
+
+// ####################################################################################################
+// Tests:
+
+TEST(StreamWriter, FormatsTypedValues)
+{
+    RingBuffer tx(256);
+    RingBuffer rx(16);
+    Stream stream(&tx, &rx);
+
+    StreamWriter writer(stream);
+    writer << INT64_MIN << ',' << UINT64_MAX << ',' << (uint8_t)7 << ',' << (int8_t)-8 << ',' << true << ',' << false;
+    writer << ',' << fixed(2.5, 0) << ',' << fixed(1.0f / 3.0f, 3) << ',' << 0.5 << ',' << std::string("s") << ',' << std::string_view("v");
+    EXPECT_TRUE(writer.commit());
+
+    EXPECT_EQ(popAllTx(stream), "-9223372036854775808,18446744073709551615,7,-8,true,false,2,0.333,0.500000,s,v");
+}
+
+TEST(StreamWriter, NullStringWritesNothing)
+{
+    RingBuffer tx(64);
+    RingBuffer rx(16);
+    Stream stream(&tx, &rx);
+
+    const char* name = nullptr;
+    StreamWriter writer(stream);
+    writer << "a" << name << "b";
+    EXPECT_TRUE(writer.commit());
+    EXPECT_EQ(popAllTx(stream), "ab");
+}
+
+TEST(StreamWriter, RecordAcrossWrapPointIsStoredWhole)
+{
+    RingBuffer tx(32);
+    RingBuffer rx(16);
+    Stream stream(&tx, &rx);
+
+    // Only 4 contiguous characters are free before end of storage.
+    stream.pushBackTxBuffer("0123456789012345678901234567", 28);
+    stream.consumeTx(28);
+
+    EXPECT_TRUE(writeRecord(stream, ';', 123456, "wrapped", fixed(1.25, 2)));
+    EXPECT_EQ(popAllTx(stream), "123456;wrapped;1.25\n");
+}
+
+TEST(StreamWriter, DequeBackendAndPushesBetweenRecords)
+{
+    std::deque<char> tx;
+    std::deque<char> rx;
+    Stream stream(&tx, 256, &rx, 256);
+
+    StreamWriter writer(stream);
+    writer << 1 << '\n';
+    EXPECT_TRUE(writer.commit());
+
+    // Memory of next record is taken by its first write, so this push is kept.
+    stream.pushBackTxBuffer("x\n", 2);
+    writer << 2 << '\n';
+    EXPECT_TRUE(writer.commit());
+
+    EXPECT_EQ(std::string(tx.begin(), tx.end()), "1\nx\n2\n");
+}
+
+TEST(StreamWriter, TooLargeRecordIsDroppedWhole)
+{
+    RingBuffer tx(4096);
+    RingBuffer rx(16);
+    Stream stream(&tx, &rx);
+
+    // Only 6 contiguous characters are free before end of storage, so record continues in internal buffer.
+    std::string large(STREAM_WRITER_BUFFER_SIZE, 'x');
+    std::string filler(4090, '-');
+    stream.pushBackTxBuffer(filler);
+    stream.consumeTx(filler.size() - 4);
+
+    StreamWriter writer(stream);
+    writer << large << large;
+    EXPECT_FALSE(writer.commit());
+    EXPECT_EQ(tx.size(), 4u);
+
+    // Next record is not affected.
+    writer << 42;
+    EXPECT_TRUE(writer.commit());
+    EXPECT_EQ(popAllTx(stream), "----42");
+}
+
+TEST(StreamWriter, CommitFailsIfTxBufferStoresOnlyPart)
+{
+    RingBuffer tx(8);
+    RingBuffer rx(16);
+    Stream stream(&tx, &rx);
+
+    // Full TX buffer has no direct memory. Record is pushed and only its last part fits.
+    stream.pushBackTxBuffer("abcdefgh", 8);
+    StreamWriter writer(stream);
+    writer << 1234567890;
+    EXPECT_EQ(writer.length(), 10u);
+    EXPECT_FALSE(writer.commit());
+    EXPECT_EQ(popAllTx(stream), "34567890");
+}
+
+TEST(StreamWriter, DestructorCommitsRecord)
+{
+    RingBuffer tx(64);
+    RingBuffer rx(16);
+    Stream stream(&tx, &rx);
+
+    StreamWriter(stream).setPrecision(1) << 7 << ',' << 2.25 << '\n';
+    EXPECT_EQ(popAllTx(stream), "7,2.2\n");
+}
@@ -0,0 +1,135 @@
+// ####################################################################################################
+// Tests of string helper functions: findCharacter and splitString overloads.
+// Build: cmake -S .. -B build && cmake --build build --target StringUtilsTest && ctest --test-dir build
+
+// ####################################################################################################
+// Include libraries:
+
+#include <gtest/gtest.h>            // Google Test
+#include <random>                   // Random test inputs
+#include <string>                   // String class and related functions
+#include <string_view>              // Non-owning string views
+#include <vector>                   // Dynamic array container
+#include "Stream.h"
+
+// ####################################################################################################
+// Test helpers:
+
+/// @brief Reference byte loop search.
+static size_t naiveFind(const char* data, size_t size, char value)
+{
+    for(size_t i = 0; i < size; i++)
+    {
+        if(data[i] == value)
+        {
+            return i;
+        }
+    }
+
+    return std::string::npos;
+}
+
+// ####################################################################################################
+// Tests:
+
+TEST(FindCharacter, MatchesByteLoopForAllPositionsAndAlignments)
+{
+    // Sizes and positions around 16 and 32 byte vector widths and unaligned starts.
+    std::vector<char> storage(200, 'a');
+
+    for(size_t start = 0; start < 33; start++)
+    {
+        for(size_t size = 0; size + start <= 140; size += (size < 70 ? 1 : 7))
+        {
+            const char* data = storage.data() + start;
+            EXPECT_EQ(findCharacter(data, size, 'x'), std::string::npos);
+
+            for(size_t pos = 0; pos < size; pos++)
+            {
+                storage[start + pos] = 'x';
+                ASSERT_EQ(findCharacter(data, size, 'x'), pos) << start << " " << size;
+                storage[start + pos] = 'a';
+            }
+        }
+    }
+}
+
+TEST(FindCharacter, RandomDataAndHighBitCharacters)
+{
+    std::mt19937 random(7);
+    std::string data(1000, '\0');
+
+    for(int round = 0; round < 500; round++)
+    {
+        for(char &c : data)
+        {
+            c = (char)(random() % 40 + 200);
+        }
+
+        char value = (char)(random() % 256);
+        size_t size = random() % data.size();
+        ASSERT_EQ(findCharacter(data.data(), size, value), naiveFind(data.data(), size, value));
+    }
+
+    EXPECT_EQ(findCharacter(nullptr, 0, 'a'), std::string::npos);
+}
+
+TEST(SplitString, ViewOverloadMatchesStringOverload)
+{
+    const std::vector<std::string> lines = {
+        "",
+        ",",
+        "a",
+        " a , b ,c ",
+        "1,2,,3,",
+        ",,leading",
+        "  spaces   only  ,  ",
+        "12.5, 13.25,-7, 1e3, temp ,42,  x,y,z,a,b,c,d,e,f,g,h,i,j,k,l,m,n,o,p",
+    };
+
+    std::vector<std::string_view> views;
+
+    for(const std::string &line : lines)
+    {
+        std::vector<std::string> tokens = splitString(line, ',');
+        size_t count = splitString(std::string_view(line), ',', views);
+
+        ASSERT_EQ(count, tokens.size()) << '"' << line << '"';
+        ASSERT_EQ(views.size(), tokens.size());
+
+        for(size_t i = 0; i < tokens.size(); i++)
+        {
+            EXPECT_EQ(std::string(views[i]), tokens[i]) << '"' << line << '"';
+        }
+    }
+}
+
+TEST(SplitString, ViewsPointIntoLineAndVectorIsReused)
+{
+    std::string line = "alpha; beta ;gamma";
+    std::vector<std::string_view> views = {"old", "old", "old", "old", "old"};
+
+    EXPECT_EQ(splitString(std::string_view(line), ';', views), 3u);
+    EXPECT_EQ(views[1], "beta");
+    EXPECT_GE(views[1].data(), line.data());
+    EXPECT_LT(views[1].data(), line.data() + line.size());
+
+    EXPECT_EQ(trimStringView("  x y  "), "x y");
+    EXPECT_EQ(trimStringView("   "), "");
+}
+
+TEST(SplitString, FindRxAcrossWrapPoint)
+{
+    RingBuffer tx(16);
+    RingBuffer rx(16);
+    Stream stream(&tx, &rx);
+
+    stream.pushBackRxBuffer("0123456789ab", 12);
+    stream.consumeRx(10);
+    stream.pushBackRxBuffer("cdef,hij", 8);
+
+    EXPECT_EQ(stream.findRx(','), 6u);
+    EXPECT_EQ(stream.findRx('j'), 9u);
+    EXPECT_EQ(stream.findRx('b', 2), std::string::npos);
+    EXPECT_EQ(stream.findRx('z'), std::string::npos);
+}